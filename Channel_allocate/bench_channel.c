@@ -0,0 +1,170 @@
+// bench_channel.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+#include "channel_alloc.h"
+
+#define MESSAGES     10000000  // Objects passed from the producer to the consumer.
+#define OBJECTS      8192      // Objects in the slab.
+#define QUEUE_SLOTS  1024      // In-flight messages (power of 2).
+#define OBJECT_SIZE  (HEADER_SIZE + 64)
+
+#define MODE_SHARED   0        // Shared lock-free free list (both threads write its head).
+#define MODE_CHANNEL  1        // SlabChannel.
+
+// Message stored in each slab object.
+typedef struct Message {
+    uint64_t sequence;
+    uint64_t payload[7];
+} Message;
+
+// SPSC pointer queue carrying the messages; identical for both modes.
+typedef struct MessageQueue {
+    volatile LONG64 head __attribute__((aligned(64)));  // Written by the consumer.
+    volatile LONG64 tail __attribute__((aligned(64)));  // Written by the producer.
+    Message* volatile slots[QUEUE_SLOTS] __attribute__((aligned(64)));
+} MessageQueue;
+
+typedef struct BenchShared {
+    SlabChannel channel;
+    MessageQueue queue;
+    Slab slab;                                          // Backing memory for MODE_SHARED.
+    void* volatile free_head __attribute__((aligned(64)));  // Shared free list (object pointers).
+    int mode;
+    uint64_t checksum;
+    size_t empty_waits;
+} BenchShared;
+
+// Shared free list: the consumer pushes, the producer pops. Only one thread pops,
+// so a popped node cannot come back between the read of its link and the CAS (no ABA).
+static void shared_push(BenchShared* shared, void* ptr) {
+    void* head;
+    do {
+        head = shared->free_head;
+        *((void**)ptr) = head;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&shared->free_head, ptr, head) != head);
+}
+
+static void* shared_pop(BenchShared* shared) {
+    void* head;
+    do {
+        head = shared->free_head;
+        if (head == NULL)
+            return NULL;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&shared->free_head, *((void**)head), head) != head);
+    return head;
+}
+
+// Consumer: pops messages, checks them and frees them. With the channel, a partial
+// batch is flushed whenever the queue runs empty so the producer never starves.
+static DWORD WINAPI consumer_main(LPVOID arg) {
+    BenchShared* shared = (BenchShared*)arg;
+    MessageQueue* queue = &shared->queue;
+    LONG64 head = 0;
+    uint64_t checksum = 0;
+    while (head < MESSAGES) {
+        if (head == queue->tail) {
+            if (shared->mode == MODE_CHANNEL)
+                slab_channel_flush(&shared->channel);
+            Sleep(0);
+            continue;
+        }
+        Message* message = queue->slots[head & (QUEUE_SLOTS - 1)];
+        checksum += message->sequence + message->payload[6];
+        __asm__ __volatile__("" ::: "memory");
+        queue->head = ++head;
+        if (shared->mode == MODE_CHANNEL)
+            slab_channel_free(&shared->channel, message);
+        else
+            shared_push(shared, message);
+    }
+    if (shared->mode == MODE_CHANNEL)
+        slab_channel_flush(&shared->channel);
+    shared->checksum = checksum;
+    return 0;
+}
+
+static void bench_pipeline(int mode, const char* label, LARGE_INTEGER frequency) {
+    BenchShared* shared = (BenchShared*)_aligned_malloc(sizeof(BenchShared), 64);
+    if (shared == NULL) {
+        printf("%s: initialization failed.\n", label);
+        return;
+    }
+    shared->mode = mode;
+    shared->queue.head = 0;
+    shared->queue.tail = 0;
+    shared->free_head = NULL;
+    shared->empty_waits = 0;
+    if (mode == MODE_CHANNEL) {
+        if (!slab_channel_init(&shared->channel, OBJECTS, OBJECT_SIZE, 0)) {
+            printf("%s: initialization failed.\n", label);
+            _aligned_free(shared);
+            return;
+        }
+    } else {
+        if (!slab_init(&shared->slab, OBJECTS, OBJECT_SIZE)) {
+            printf("%s: initialization failed.\n", label);
+            _aligned_free(shared);
+            return;
+        }
+        // Move every object to the shared list, lowest address on top.
+        void* objects[OBJECTS];
+        for (int i = 0; i < OBJECTS; i++)
+            objects[i] = slab_alloc(&shared->slab);
+        for (int i = OBJECTS - 1; i >= 0; i--)
+            shared_push(shared, objects[i]);
+    }
+
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    HANDLE consumer = CreateThread(NULL, 0, consumer_main, shared, 0, NULL);
+    MessageQueue* queue = &shared->queue;
+    uint64_t expected = 0;
+    for (LONG64 tail = 0; tail < MESSAGES; tail++) {
+        Message* message;
+        for (;;) {
+            message = mode == MODE_CHANNEL ? (Message*)slab_channel_alloc(&shared->channel)
+                                           : (Message*)shared_pop(shared);
+            if (message != NULL)
+                break;
+            shared->empty_waits++;
+            Sleep(0);
+        }
+        message->sequence = (uint64_t)tail;
+        message->payload[6] = (uint64_t)tail * 3;
+        expected += (uint64_t)tail * 4;
+        while (tail - queue->head >= QUEUE_SLOTS)
+            Sleep(0);
+        queue->slots[tail & (QUEUE_SLOTS - 1)] = message;
+        __asm__ __volatile__("" ::: "memory");
+        queue->tail = tail + 1;
+    }
+    WaitForSingleObject(consumer, INFINITE);
+    QueryPerformanceCounter(&end);
+    CloseHandle(consumer);
+
+    double seconds = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    printf("%s: %.6f seconds, %.2f messages/sec, checksum %s, %zu empty waits\n", label, seconds,
+           MESSAGES / seconds, shared->checksum == expected ? "ok" : "MISMATCH", shared->empty_waits);
+    if (mode == MODE_CHANNEL) {
+        SlabChannelStats stats;
+        slab_channel_get_stats(&shared->channel, &stats);
+        printf("%s: %zu batches returned, %zu reclaimed in %zu passes, %zu ring-full deferrals\n", label,
+               stats.batches_returned, stats.batches_reclaimed, stats.reclaims, stats.ring_full);
+        slab_channel_destroy(&shared->channel);
+    } else {
+        slab_destroy(&shared->slab);
+    }
+    _aligned_free(shared);
+}
+
+int main(void) {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    // Benchmark a producer/consumer pipeline: one thread allocates, the other frees.
+    bench_pipeline(MODE_SHARED, "Shared lock-free free list", frequency);
+    bench_pipeline(MODE_CHANNEL, "Slab channel", frequency);
+    return 0;
+}
@@ -0,0 +1,189 @@
+// channel_alloc.c
+
+#include "channel_alloc.h"
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Channel Initialization and Destroy
+// -----------------------------------------------------------------------------
+
+/**
+ * slab_channel_init
+ * Builds the slab (its free list starts in address order) and clears both sides.
+ *
+ * @param channel        Pointer to a SlabChannel structure (64-byte aligned).
+ * @param total_objects  Objects in the slab.
+ * @param object_size    Size of each object in bytes (including HEADER_SIZE).
+ * @param batch_size     Objects per returned batch (0 for the default).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_channel_init(SlabChannel* channel, size_t total_objects, size_t object_size, size_t batch_size) {
+    if (!channel || object_size < HEADER_SIZE)
+        return 0;
+    if (!slab_init(&channel->slab, total_objects, object_size))
+        return 0;
+    channel->producer_seen = 0;
+    channel->allocated = 0;
+    channel->reclaims = 0;
+    channel->batch_head = NULL;
+    channel->batch_tail = NULL;
+    channel->batch_count = 0;
+    channel->batch_size = batch_size ? batch_size : SLAB_CHANNEL_DEFAULT_BATCH;
+    channel->consumer_seen = 0;
+    channel->freed = 0;
+    channel->ring_full = 0;
+    channel->returned = 0;
+    channel->reclaimed = 0;
+    memset(channel->ring, 0, sizeof(channel->ring));
+    return 1;
+}
+
+/**
+ * slab_channel_destroy
+ * Unmaps the slab; objects still on the consumer side are dropped with it.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ */
+void slab_channel_destroy(SlabChannel* channel) {
+    if (!channel)
+        return;
+    slab_destroy(&channel->slab);
+    channel->batch_head = NULL;
+    channel->batch_tail = NULL;
+    channel->batch_count = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Producer Side
+// -----------------------------------------------------------------------------
+
+/**
+ * slab_channel_reclaim
+ * Reads `returned` once, splices each batch between `reclaimed` and it onto the
+ * free list (tail link, then head), and publishes the new `reclaimed`.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @return Number of batches reclaimed.
+ */
+size_t slab_channel_reclaim(SlabChannel* channel) {
+    LONG64 done = channel->reclaimed;
+    LONG64 returned = channel->returned;
+    // The ring entries are read after `returned` (x86 keeps loads in order).
+    __asm__ __volatile__("" ::: "memory");
+    channel->producer_seen = returned;
+    if (returned == done)
+        return 0;
+    for (LONG64 i = done; i < returned; i++) {
+        const SlabChannelBatch* batch = &channel->ring[i & (SLAB_CHANNEL_RING_SLOTS - 1)];
+        *((void**)batch->tail) = channel->slab.free_list;
+        channel->slab.free_list = batch->head;
+    }
+    __asm__ __volatile__("" ::: "memory");
+    channel->reclaimed = returned;  // The slots may be reused from here on.
+    channel->reclaims++;
+    return (size_t)(returned - done);
+}
+
+/**
+ * slab_channel_alloc
+ * slab_alloc on the producer's slab; reclaims and retries once when it is empty.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @return Object (offset by HEADER_SIZE), or NULL if none is available.
+ */
+void* slab_channel_alloc(SlabChannel* channel) {
+    void* ptr = slab_alloc(&channel->slab);
+    if (ptr == NULL && channel->returned != channel->producer_seen && slab_channel_reclaim(channel) != 0)
+        ptr = slab_alloc(&channel->slab);
+    if (ptr != NULL)
+        channel->allocated++;
+    return ptr;
+}
+
+// -----------------------------------------------------------------------------
+// Consumer Side
+// -----------------------------------------------------------------------------
+
+/**
+ * publish_batch
+ * Writes the private chain into the next ring slot and releases it with one store
+ * of `returned`. `reclaimed` is only reread when the cached value says the ring is
+ * full.
+ *
+ * @return 1 if published, 0 if the ring is full.
+ */
+static int publish_batch(SlabChannel* channel) {
+    LONG64 returned = channel->returned;
+    if (returned - channel->consumer_seen >= SLAB_CHANNEL_RING_SLOTS) {
+        channel->consumer_seen = channel->reclaimed;
+        if (returned - channel->consumer_seen >= SLAB_CHANNEL_RING_SLOTS) {
+            channel->ring_full++;
+            return 0;
+        }
+    }
+    SlabChannelBatch* batch = &channel->ring[returned & (SLAB_CHANNEL_RING_SLOTS - 1)];
+    batch->head = channel->batch_head;
+    batch->tail = channel->batch_tail;
+    __asm__ __volatile__("" ::: "memory");  // Slot (and object links) before the index.
+    channel->returned = returned + 1;
+    channel->batch_head = NULL;
+    channel->batch_tail = NULL;
+    channel->batch_count = 0;
+    return 1;
+}
+
+/**
+ * slab_channel_free
+ * Links the object in front of the private chain through its free-list word and
+ * publishes the chain once it is batch_size long.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @param ptr      Object from slab_channel_alloc.
+ */
+void slab_channel_free(SlabChannel* channel, void* ptr) {
+    if (ptr == NULL)
+        return;
+    unsigned char* obj = (unsigned char*)ptr - HEADER_SIZE;
+    *((unsigned char**)obj) = channel->batch_head;
+    if (channel->batch_head == NULL)
+        channel->batch_tail = obj;
+    channel->batch_head = obj;
+    channel->freed++;
+    if (++channel->batch_count >= channel->batch_size)
+        publish_batch(channel);
+}
+
+/**
+ * slab_channel_flush
+ * Publishes a partial private chain.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @return 1 if the batch was published or empty, 0 if the ring is full.
+ */
+int slab_channel_flush(SlabChannel* channel) {
+    if (channel->batch_count == 0)
+        return 1;
+    return publish_batch(channel);
+}
+
+// -----------------------------------------------------------------------------
+// Statistics
+// -----------------------------------------------------------------------------
+
+/**
+ * slab_channel_get_stats
+ * Copies the counters of both sides.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @param stats    Receives the statistics.
+ */
+void slab_channel_get_stats(SlabChannel* channel, SlabChannelStats* stats) {
+    if (!channel || !stats)
+        return;
+    stats->allocated = channel->allocated;
+    stats->freed = channel->freed;
+    stats->batches_returned = (size_t)channel->returned;
+    stats->batches_reclaimed = (size_t)channel->reclaimed;
+    stats->reclaims = channel->reclaims;
+    stats->ring_full = channel->ring_full;
+}
@@ -0,0 +1,142 @@
+// channel_alloc.h
+
+#ifndef CHANNEL_ALLOC_H
+#define CHANNEL_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <windows.h>
+#include "slab_alloc.h"
+
+// SlabChannel: a Slab paired between one producer thread, which allocates, and one
+// consumer thread, which frees. The slab and its free list belong to the producer
+// alone. The consumer chains freed objects through their free-list word into a
+// private batch; a full batch is published as one (head, tail) entry of a wait-free
+// SPSC return ring. When the slab runs dry the producer splices every published
+// batch onto its free list, two stores per batch.
+//
+// Per-object work touches only the owning thread's lines. The ring entries and the
+// `returned` index are written only by the consumer, the `reclaimed` index only by
+// the producer; each side rereads the other's index once per batch, not per object.
+
+#define SLAB_CHANNEL_RING_SLOTS     256  // Published batches in flight (power of 2).
+#define SLAB_CHANNEL_DEFAULT_BATCH  64   // Objects per published batch.
+
+// SlabChannelBatch: one ring entry, a chain of objects linked through their free-list word.
+typedef struct SlabChannelBatch {
+    unsigned char* head;         // First object base of the chain.
+    unsigned char* tail;         // Last object base (its link is overwritten on splice).
+} SlabChannelBatch;
+
+// SlabChannel structure. Each group of fields sits on its own cache line(s).
+typedef struct SlabChannel {
+    // Producer side (written by the producer only).
+    Slab slab __attribute__((aligned(64)));  // Backing slab; only the producer touches its free list.
+    LONG64 producer_seen;        // Last `returned` value the producer read.
+    size_t allocated;            // Objects handed out since init.
+    size_t reclaims;             // Reclaim passes that found at least one batch.
+
+    // Consumer side (written by the consumer only).
+    unsigned char* batch_head __attribute__((aligned(64)));  // Private chain being filled.
+    unsigned char* batch_tail;   // Last object of the private chain.
+    size_t batch_count;          // Objects on the private chain.
+    size_t batch_size;           // Objects per published batch.
+    LONG64 consumer_seen;        // Last `reclaimed` value the consumer read.
+    size_t freed;                // Objects freed since init.
+    size_t ring_full;            // Publications deferred because the ring was full.
+
+    // Published state.
+    volatile LONG64 returned __attribute__((aligned(64)));   // Batches published (consumer writes).
+    volatile LONG64 reclaimed __attribute__((aligned(64)));  // Batches spliced back (producer writes).
+    SlabChannelBatch ring[SLAB_CHANNEL_RING_SLOTS] __attribute__((aligned(64)));  // Written by the consumer.
+} SlabChannel;
+
+// SlabChannelStats: snapshot returned by slab_channel_get_stats.
+typedef struct SlabChannelStats {
+    size_t allocated;            // Objects allocated by the producer.
+    size_t freed;                // Objects freed by the consumer.
+    size_t batches_returned;     // Batches published by the consumer.
+    size_t batches_reclaimed;    // Batches spliced back by the producer.
+    size_t reclaims;             // Producer reclaim passes that found work.
+    size_t ring_full;            // Consumer publications deferred by a full ring.
+} SlabChannelStats;
+
+/**
+ * slab_channel_init
+ * Creates the channel's slab and an empty return ring.
+ *
+ * @param channel        Pointer to a SlabChannel structure (64-byte aligned).
+ * @param total_objects  Objects in the slab.
+ * @param object_size    Size of each object in bytes (including HEADER_SIZE).
+ * @param batch_size     Objects per returned batch (0 for the default).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_channel_init(SlabChannel* channel, size_t total_objects, size_t object_size, size_t batch_size);
+
+/**
+ * slab_channel_alloc
+ * Producer: pops an object from the private free list, reclaiming the returned
+ * batches when the list is empty.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @return Object (offset by HEADER_SIZE), or NULL if every object is allocated or
+ *         still on the consumer side.
+ */
+void* slab_channel_alloc(SlabChannel* channel);
+
+/**
+ * slab_channel_reclaim
+ * Producer: splices every published batch onto the free list.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @return Number of batches reclaimed.
+ */
+size_t slab_channel_reclaim(SlabChannel* channel);
+
+/**
+ * slab_channel_free
+ * Consumer: adds an object to the private batch and publishes the batch once it
+ * holds batch_size objects. Wait-free: if the ring is full the batch keeps growing
+ * and is published by a later call.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @param ptr      Object from slab_channel_alloc.
+ */
+void slab_channel_free(SlabChannel* channel, void* ptr);
+
+/**
+ * slab_channel_flush
+ * Consumer: publishes the private batch even if it is not full (e.g. when the
+ * consumer goes idle).
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @return 1 if the batch was published or empty, 0 if the ring is full.
+ */
+int slab_channel_flush(SlabChannel* channel);
+
+/**
+ * slab_channel_get_stats
+ * Reports the allocation, free and batch counters (racy while both threads run).
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ * @param stats    Receives the statistics.
+ */
+void slab_channel_get_stats(SlabChannel* channel, SlabChannelStats* stats);
+
+/**
+ * slab_channel_destroy
+ * Destroys the slab. Both threads must be done with the channel.
+ *
+ * @param channel  Pointer to the SlabChannel structure.
+ */
+void slab_channel_destroy(SlabChannel* channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHANNEL_ALLOC_H
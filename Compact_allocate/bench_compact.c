@@ -0,0 +1,137 @@
+// bench_compact.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include "compact_alloc.h"
+#include "pool_alloc.h"
+
+#define CACHE_ENTRIES 4096
+#define CHURN_OPS     20000
+
+// Size of the replacement written at churn step i: the size mix drifts from small to
+// large entries over the run, which is what strands holes in a non-moving heap.
+static size_t entry_size(unsigned* seed, int i) {
+    *seed = *seed * 1103515245u + 12345u;
+    size_t limit = 256 + (size_t)i * 4096 / CHURN_OPS;
+    return 64 + (*seed >> 8) % limit;
+}
+
+// Long-running cache on a Pool: random entries are replaced by entries of drifting size.
+static void bench_pool_cache(LARGE_INTEGER frequency) {
+    Pool pool;
+    if (!pool_init(&pool, 1024 * 1024)) {
+        printf("Pool initialization failed.\n");
+        return;
+    }
+    uintptr_t* entries = (uintptr_t*)malloc(CACHE_ENTRIES * sizeof(uintptr_t));
+    size_t* sizes = (size_t*)malloc(CACHE_ENTRIES * sizeof(size_t));
+    unsigned seed = 1;
+    size_t live = 0;
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        sizes[i] = entry_size(&seed, 0);
+        entries[i] = pool_alloc(&pool, sizes[i], 16);
+        live += sizes[i];
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CHURN_OPS; i++) {
+        int slot = (int)((seed >> 4) % CACHE_ENTRIES);
+        pool_free(&pool, entries[slot]);
+        live -= sizes[slot];
+        sizes[slot] = entry_size(&seed, i);
+        entries[slot] = pool_alloc(&pool, sizes[slot], 16);
+        live += sizes[slot];
+    }
+    QueryPerformanceCounter(&end);
+    PoolStats stats;
+    pool_get_stats(&pool, &stats);
+    printf("Pool cache, %d replacements: %.6f seconds, %zu KB live in %zu KB reserved (%.1f%% wasted)\n",
+           CHURN_OPS, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, live / 1024,
+           stats.reserved_bytes / 1024, 100.0 * (1.0 - (double)live / stats.reserved_bytes));
+    free(entries);
+    free(sizes);
+    pool_destroy(&pool);
+}
+
+// Same cache on a CompactPool. Every 64th entry is pinned while it is "in use" for
+// the next 16 replacements, and a full compaction runs at the end (idle time).
+static void bench_compact_cache(LARGE_INTEGER frequency) {
+    CompactPool pool;
+    if (!compact_pool_init(&pool, (size_t)1024 * 1024 * 1024)) {
+        printf("Compact pool initialization failed.\n");
+        return;
+    }
+    CompactHandle* entries = (CompactHandle*)malloc(CACHE_ENTRIES * sizeof(CompactHandle));
+    size_t* sizes = (size_t*)malloc(CACHE_ENTRIES * sizeof(size_t));
+    unsigned seed = 1;
+    size_t live = 0;
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        sizes[i] = entry_size(&seed, 0);
+        entries[i] = compact_alloc(&pool, sizes[i]);
+        memset(compact_deref(&pool, entries[i]), i & 0xFF, sizes[i]);
+        live += sizes[i];
+    }
+    CompactHandle pinned[16] = { 0 };
+    int corrupt = 0;
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CHURN_OPS; i++) {
+        int slot = (int)((seed >> 4) % CACHE_ENTRIES);
+        if (pinned[i % 16] != COMPACT_INVALID_HANDLE) {
+            compact_unpin(&pool, pinned[i % 16]);
+            pinned[i % 16] = COMPACT_INVALID_HANDLE;
+        }
+        if (i % 64 == 0 && compact_pin(&pool, entries[(slot + 1) % CACHE_ENTRIES]) != NULL)
+            pinned[i % 16] = entries[(slot + 1) % CACHE_ENTRIES];
+        for (int j = 0; j < 16; j++) {
+            if (pinned[j] == entries[slot])
+                pinned[j] = COMPACT_INVALID_HANDLE;  // compact_free drops the pin.
+        }
+        compact_free(&pool, entries[slot]);
+        live -= sizes[slot];
+        sizes[slot] = entry_size(&seed, i);
+        entries[slot] = compact_alloc(&pool, sizes[slot]);
+        memset(compact_deref(&pool, entries[slot]), slot & 0xFF, sizes[slot]);
+        live += sizes[slot];
+    }
+    for (int i = 0; i < 16; i++) {
+        if (pinned[i] != COMPACT_INVALID_HANDLE)
+            compact_unpin(&pool, pinned[i]);
+    }
+    QueryPerformanceCounter(&end);
+    double churnTime = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    CompactStats before;
+    compact_get_stats(&pool, &before);
+    QueryPerformanceCounter(&start);
+    size_t released = compact_full(&pool);
+    QueryPerformanceCounter(&end);
+    CompactStats after;
+    compact_get_stats(&pool, &after);
+    // Every entry must still hold its fill byte after being moved around.
+    for (int i = 0; i < CACHE_ENTRIES; i++) {
+        const unsigned char* data = (const unsigned char*)compact_deref(&pool, entries[i]);
+        if (data[0] != (i & 0xFF) || data[sizes[i] - 1] != (i & 0xFF))
+            corrupt++;
+    }
+    printf("Compact cache, %d replacements: %.6f seconds, %zu KB live in %zu KB committed (%.1f%% wasted), %zu MB moved in %zu cycles\n",
+           CHURN_OPS, churnTime, live / 1024, before.committed / 1024,
+           100.0 * (1.0 - (double)live / before.committed), before.moved_bytes_total >> 20, before.compactions);
+    printf("Idle compaction: %.6f seconds, %zu KB returned to the OS, %zu KB committed (%.1f%% wasted), %d corrupt entries\n",
+           (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, released / 1024, after.committed / 1024,
+           100.0 * (1.0 - (double)live / after.committed), corrupt);
+    free(entries);
+    free(sizes);
+    compact_pool_destroy(&pool);
+}
+
+int main(void) {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    // Benchmark a long-running cache with drifting entry sizes.
+    bench_pool_cache(frequency);
+    bench_compact_cache(frequency);
+    return 0;
+}
@@ -0,0 +1,427 @@
+// compact_alloc.c
+
+#include "compact_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define COMPACT_MAX_HOLE 0xFFFFFFF0u  // Largest size one CompactBlockHeader can describe.
+
+// -----------------------------------------------------------------------------
+// Handle Table
+// -----------------------------------------------------------------------------
+
+/**
+ * link_handles
+ * Pushes handle indices [first, last) onto the free handle list, lowest first.
+ */
+static void link_handles(CompactPool* pool, uint32_t first, uint32_t last) {
+    for (uint32_t i = last; i-- > first;) {
+        pool->handles[i].block = NULL;
+        pool->handles[i].pins = 0;
+        pool->handles[i].next_free = pool->handle_free;
+        pool->handle_free = i + 1;
+    }
+}
+
+/**
+ * take_handle
+ * Pops a free handle, doubling the table when it is exhausted.
+ *
+ * @return Handle, or COMPACT_INVALID_HANDLE if the table cannot grow.
+ */
+static CompactHandle take_handle(CompactPool* pool) {
+    if (pool->handle_free == 0) {
+        uint32_t capacity = pool->handle_capacity;
+        if (capacity > 0x7FFFFFFFu)
+            return COMPACT_INVALID_HANDLE;
+        CompactHandleEntry* handles =
+            (CompactHandleEntry*)realloc(pool->handles, (size_t)capacity * 2 * sizeof(CompactHandleEntry));
+        if (handles == NULL)
+            return COMPACT_INVALID_HANDLE;
+        pool->handles = handles;
+        pool->handle_capacity = capacity * 2;
+        link_handles(pool, capacity, capacity * 2);
+    }
+    CompactHandle handle = pool->handle_free;
+    pool->handle_free = pool->handles[handle - 1].next_free;
+    return handle;
+}
+
+/**
+ * find_entry
+ * Returns the table entry of a live handle, or NULL.
+ */
+static CompactHandleEntry* find_entry(CompactPool* pool, CompactHandle handle) {
+    if (handle == COMPACT_INVALID_HANDLE || handle > pool->handle_capacity)
+        return NULL;
+    CompactHandleEntry* entry = &pool->handles[handle - 1];
+    return entry->block != NULL ? entry : NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Heap Layout Helpers
+// -----------------------------------------------------------------------------
+
+/**
+ * ensure_committed
+ * Commits whole COMPACT_COMMIT_CHUNKs until `end` bytes of the range are usable.
+ *
+ * @return 1 on success, 0 if the range is exhausted or the commit failed.
+ */
+static int ensure_committed(CompactPool* pool, size_t end) {
+    if (end <= pool->committed)
+        return 1;
+    if (end > pool->reserved)
+        return 0;
+    size_t target = (end + COMPACT_COMMIT_CHUNK - 1) & ~((size_t)COMPACT_COMMIT_CHUNK - 1);
+    if (target > pool->reserved)
+        target = pool->reserved;
+    if (VirtualAlloc(pool->base + pool->committed, target - pool->committed, MEM_COMMIT, PAGE_READWRITE) == NULL)
+        return 0;
+    pool->committed = target;
+    return 1;
+}
+
+/**
+ * write_hole
+ * Describes [from, to) with free block headers so the heap stays walkable.
+ */
+static void write_hole(CompactPool* pool, size_t from, size_t to) {
+    while (from < to) {
+        size_t size = to - from;
+        if (size > COMPACT_MAX_HOLE)
+            size = COMPACT_MAX_HOLE;
+        CompactBlockHeader* hole = (CompactBlockHeader*)(pool->base + from);
+        hole->size = (uint32_t)size;
+        hole->payload = 0;
+        hole->handle = COMPACT_INVALID_HANDLE;
+        hole->reserved = 0;
+        from += size;
+    }
+}
+
+/**
+ * finish_cycle
+ * Ends a compaction cycle: the heap now ends at dest, and every committed chunk past
+ * it is decommitted.
+ *
+ * @return Bytes decommitted.
+ */
+static size_t finish_cycle(CompactPool* pool) {
+    pool->free_bytes -= pool->top - pool->dest;
+    pool->top = pool->dest;
+    pool->scan = 0;
+    pool->dest = 0;
+    pool->compacting = 0;
+    pool->compactions++;
+    size_t keep = (pool->top + COMPACT_COMMIT_CHUNK - 1) & ~((size_t)COMPACT_COMMIT_CHUNK - 1);
+    if (keep < COMPACT_COMMIT_CHUNK)
+        keep = COMPACT_COMMIT_CHUNK;
+    if (keep >= pool->committed)
+        return 0;
+    size_t released = pool->committed - keep;
+    if (!VirtualFree(pool->base + keep, released, MEM_DECOMMIT))
+        return 0;
+    pool->committed = keep;
+    pool->released_bytes_total += released;
+    return released;
+}
+
+/**
+ * step_locked
+ * Compactor body shared by compact_step, compact_full and compact_alloc; the caller
+ * holds the pool lock.
+ *
+ * @param released  Receives the bytes decommitted if the cycle finished (may be NULL).
+ * @return 1 if the cycle finished, 0 otherwise.
+ */
+static int step_locked(CompactPool* pool, size_t max_bytes, size_t* released) {
+    if (!pool->compacting) {
+        pool->compacting = 1;
+        pool->scan = 0;
+        pool->dest = 0;
+    }
+    size_t visited = 0;
+    while (pool->scan < pool->top && visited < max_bytes) {
+        CompactBlockHeader* block = (CompactBlockHeader*)(pool->base + pool->scan);
+        size_t size = block->size;
+        visited += size;
+        if (block->handle == COMPACT_INVALID_HANDLE) {
+            // A hole joins the gap in front of the scan cursor.
+            pool->scan += size;
+            continue;
+        }
+        CompactHandleEntry* entry = &pool->handles[block->handle - 1];
+        if (entry->pins != 0) {
+            // Pinned blocks stay put; the gap before them becomes a hole.
+            write_hole(pool, pool->dest, pool->scan);
+            pool->scan += size;
+            pool->dest = pool->scan;
+            continue;
+        }
+        if (pool->dest != pool->scan) {
+            memmove(pool->base + pool->dest, block, size);
+            entry->block = (CompactBlockHeader*)(pool->base + pool->dest);
+            pool->moved_bytes_total += size;
+        }
+        pool->scan += size;
+        pool->dest += size;
+    }
+    if (pool->scan < pool->top) {
+        write_hole(pool, pool->dest, pool->scan);
+        return 0;
+    }
+    size_t bytes = finish_cycle(pool);
+    if (released)
+        *released = bytes;
+    return 1;
+}
+
+// -----------------------------------------------------------------------------
+// Pool Initialization and Destroy Functions
+// -----------------------------------------------------------------------------
+
+/**
+ * compact_pool_init
+ * Reserves the range (rounded up to COMPACT_COMMIT_CHUNK), commits one chunk and
+ * builds the handle table.
+ *
+ * @param pool      Pointer to a CompactPool structure.
+ * @param max_size  Largest size the heap may reach in bytes.
+ * @return 1 on success, 0 on failure.
+ */
+int compact_pool_init(CompactPool* pool, size_t max_size) {
+    if (!pool || max_size == 0)
+        return 0;
+    memset(pool, 0, sizeof(*pool));
+    pool->reserved = (max_size + COMPACT_COMMIT_CHUNK - 1) & ~((size_t)COMPACT_COMMIT_CHUNK - 1);
+    pool->base = (unsigned char*)VirtualAlloc(NULL, pool->reserved, MEM_RESERVE, PAGE_READWRITE);
+    if (pool->base == NULL)
+        return 0;
+    pool->handles = (CompactHandleEntry*)malloc(COMPACT_MIN_HANDLES * sizeof(CompactHandleEntry));
+    if (pool->handles == NULL || !ensure_committed(pool, COMPACT_COMMIT_CHUNK)) {
+        free(pool->handles);
+        VirtualFree(pool->base, 0, MEM_RELEASE);
+        pool->base = NULL;
+        return 0;
+    }
+    pool->handle_capacity = COMPACT_MIN_HANDLES;
+    link_handles(pool, 0, COMPACT_MIN_HANDLES);
+    InitializeCriticalSection(&pool->lock);
+    return 1;
+}
+
+/**
+ * compact_pool_destroy
+ * Releases the reserved range and the handle table.
+ *
+ * @param pool  Pointer to the CompactPool structure.
+ */
+void compact_pool_destroy(CompactPool* pool) {
+    if (!pool || pool->base == NULL)
+        return;
+    VirtualFree(pool->base, 0, MEM_RELEASE);
+    free(pool->handles);
+    DeleteCriticalSection(&pool->lock);
+    pool->base = NULL;
+    pool->handles = NULL;
+    pool->handle_capacity = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Allocation, Free and Pinning
+// -----------------------------------------------------------------------------
+
+/**
+ * compact_alloc
+ * Paces the compactor against the hole ratio, then appends the block at top.
+ *
+ * @param pool  Pointer to the CompactPool structure.
+ * @param size  Payload size in bytes.
+ * @return Handle, or COMPACT_INVALID_HANDLE on failure.
+ */
+CompactHandle compact_alloc(CompactPool* pool, size_t size) {
+    if (!pool || pool->base == NULL || size == 0 || size > COMPACT_MAX_HOLE - sizeof(CompactBlockHeader))
+        return COMPACT_INVALID_HANDLE;
+    size_t block_size = (size + sizeof(CompactBlockHeader) + COMPACT_ALIGNMENT - 1) & ~((size_t)COMPACT_ALIGNMENT - 1);
+    EnterCriticalSection(&pool->lock);
+    if (pool->free_bytes * 4 > pool->top)
+        step_locked(pool, COMPACT_STEP_BYTES, NULL);
+    if (pool->top + block_size > pool->reserved) {
+        while (!step_locked(pool, (size_t)-1, NULL)) {
+        }
+    }
+    CompactHandle handle = COMPACT_INVALID_HANDLE;
+    if (ensure_committed(pool, pool->top + block_size))
+        handle = take_handle(pool);
+    if (handle == COMPACT_INVALID_HANDLE) {
+        LeaveCriticalSection(&pool->lock);
+        return COMPACT_INVALID_HANDLE;
+    }
+    CompactBlockHeader* block = (CompactBlockHeader*)(pool->base + pool->top);
+    block->size = (uint32_t)block_size;
+    block->payload = (uint32_t)size;
+    block->handle = handle;
+    block->reserved = 0;
+    pool->handles[handle - 1].block = block;
+    pool->handles[handle - 1].pins = 0;
+    pool->top += block_size;
+    pool->live_bytes += block_size;
+    pool->live_blocks++;
+    LeaveCriticalSection(&pool->lock);
+    return handle;
+}
+
+/**
+ * compact_free
+ * Turns the block into a hole (or trims it off the heap end) and recycles the handle.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Handle returned by compact_alloc.
+ */
+void compact_free(CompactPool* pool, CompactHandle handle) {
+    if (!pool || pool->base == NULL)
+        return;
+    EnterCriticalSection(&pool->lock);
+    CompactHandleEntry* entry = find_entry(pool, handle);
+    if (entry == NULL) {
+        LeaveCriticalSection(&pool->lock);
+        return;
+    }
+    CompactBlockHeader* block = entry->block;
+    size_t offset = (size_t)((unsigned char*)block - pool->base);
+    size_t size = block->size;
+    block->payload = 0;
+    block->handle = COMPACT_INVALID_HANDLE;
+    pool->live_bytes -= size;
+    pool->live_blocks--;
+    if (offset + size == pool->top && (!pool->compacting || offset >= pool->scan))
+        pool->top = offset;  // The last block needs no hole.
+    else
+        pool->free_bytes += size;
+    if (entry->pins != 0)
+        pool->pinned_blocks--;
+    entry->block = NULL;
+    entry->pins = 0;
+    entry->next_free = pool->handle_free;
+    pool->handle_free = handle;
+    LeaveCriticalSection(&pool->lock);
+}
+
+/**
+ * compact_deref
+ * Reads the handle table without locking.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Live handle.
+ * @return Payload address, or NULL for an invalid handle.
+ */
+void* compact_deref(CompactPool* pool, CompactHandle handle) {
+    if (!pool)
+        return NULL;
+    CompactHandleEntry* entry = find_entry(pool, handle);
+    return entry ? (void*)(entry->block + 1) : NULL;
+}
+
+/**
+ * compact_pin
+ * Increments the pin count under the lock, so no compactor step is moving the block.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Live handle.
+ * @return Payload address, or NULL for an invalid handle.
+ */
+void* compact_pin(CompactPool* pool, CompactHandle handle) {
+    if (!pool)
+        return NULL;
+    EnterCriticalSection(&pool->lock);
+    CompactHandleEntry* entry = find_entry(pool, handle);
+    void* payload = NULL;
+    if (entry != NULL) {
+        if (entry->pins++ == 0)
+            pool->pinned_blocks++;
+        payload = entry->block + 1;
+    }
+    LeaveCriticalSection(&pool->lock);
+    return payload;
+}
+
+/**
+ * compact_unpin
+ * Decrements the pin count.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Pinned handle.
+ */
+void compact_unpin(CompactPool* pool, CompactHandle handle) {
+    if (!pool)
+        return;
+    EnterCriticalSection(&pool->lock);
+    CompactHandleEntry* entry = find_entry(pool, handle);
+    if (entry != NULL && entry->pins != 0 && --entry->pins == 0)
+        pool->pinned_blocks--;
+    LeaveCriticalSection(&pool->lock);
+}
+
+// -----------------------------------------------------------------------------
+// Compaction and Statistics
+// -----------------------------------------------------------------------------
+
+/**
+ * compact_step
+ * Runs one bounded compactor step under the lock.
+ *
+ * @param pool       Pointer to the CompactPool structure.
+ * @param max_bytes  Bytes of heap to visit in this step.
+ * @return 1 if a compaction cycle finished in this step, 0 otherwise.
+ */
+int compact_step(CompactPool* pool, size_t max_bytes) {
+    if (!pool || pool->base == NULL)
+        return 0;
+    EnterCriticalSection(&pool->lock);
+    int finished = step_locked(pool, max_bytes, NULL);
+    LeaveCriticalSection(&pool->lock);
+    return finished;
+}
+
+/**
+ * compact_full
+ * Steps until the current cycle finishes.
+ *
+ * @param pool  Pointer to the CompactPool structure.
+ * @return Bytes decommitted by this cycle.
+ */
+size_t compact_full(CompactPool* pool) {
+    if (!pool || pool->base == NULL)
+        return 0;
+    size_t released = 0;
+    EnterCriticalSection(&pool->lock);
+    while (!step_locked(pool, (size_t)-1, &released)) {
+    }
+    LeaveCriticalSection(&pool->lock);
+    return released;
+}
+
+/**
+ * compact_get_stats
+ * Copies the counters under the lock.
+ *
+ * @param pool   Pointer to the CompactPool structure.
+ * @param stats  Receives the statistics.
+ */
+void compact_get_stats(CompactPool* pool, CompactStats* stats) {
+    if (!pool || !stats)
+        return;
+    EnterCriticalSection(&pool->lock);
+    stats->reserved = pool->reserved;
+    stats->committed = pool->committed;
+    stats->top = pool->top;
+    stats->live_bytes = pool->live_bytes;
+    stats->free_bytes = pool->free_bytes;
+    stats->live_blocks = pool->live_blocks;
+    stats->pinned_blocks = pool->pinned_blocks;
+    stats->moved_bytes_total = pool->moved_bytes_total;
+    stats->compactions = pool->compactions;
+    stats->released_bytes_total = pool->released_bytes_total;
+    LeaveCriticalSection(&pool->lock);
+}
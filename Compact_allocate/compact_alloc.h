@@ -0,0 +1,191 @@
+// compact_alloc.h
+
+#ifndef COMPACT_ALLOC_H
+#define COMPACT_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <windows.h>
+
+// Tuning.
+#define COMPACT_ALIGNMENT     16            // Block (and payload) alignment.
+#define COMPACT_COMMIT_CHUNK  (64 * 1024)   // Commit/decommit granularity of the heap.
+#define COMPACT_STEP_BYTES    (64 * 1024)   // Bytes examined per automatic compactor step.
+#define COMPACT_MIN_HANDLES   1024          // Initial handle table capacity.
+
+#define COMPACT_INVALID_HANDLE 0
+
+// CompactHandle: stable name of a relocatable block (index + 1 into the handle table).
+typedef uint32_t CompactHandle;
+
+// CompactBlockHeader: precedes every block of the heap, live or free (16 bytes).
+typedef struct CompactBlockHeader {
+    uint32_t size;               // Whole block size in bytes, header included (multiple of 16).
+    uint32_t payload;            // Requested payload size (0 for a free block).
+    uint32_t handle;             // Owning handle (COMPACT_INVALID_HANDLE for a free block).
+    uint32_t reserved;           // Keeps the payload 16-byte aligned.
+} CompactBlockHeader;
+
+// CompactHandleEntry: where a handle's block currently lives.
+typedef struct CompactHandleEntry {
+    CompactBlockHeader* block;   // Current block (NULL while the handle is free).
+    uint32_t pins;               // Pin count; pinned blocks are never moved.
+    uint32_t next_free;          // Next free handle index + 1 (0 ends the list).
+} CompactHandleEntry;
+
+// CompactPool structure: one reserved address range used as a bump heap. Blocks are
+// only ever appended at `top`; freed blocks become holes that the compactor removes
+// by sliding live blocks toward the start of the range and rewriting their handles.
+//
+// Compaction is incremental: [0, dest) is already compacted, [dest, scan) is a hole
+// (kept walkable with a free header), and [scan, top) has not been visited yet. When
+// scan reaches top, top drops to dest and the committed pages above it are
+// decommitted, returning the freed tail to the OS.
+typedef struct CompactPool {
+    unsigned char* base;         // Start of the reserved range.
+    size_t reserved;             // Bytes reserved (maximum heap size).
+    size_t committed;            // Bytes committed from base.
+    size_t top;                  // End of the last block.
+    size_t scan;                 // Compactor read cursor.
+    size_t dest;                 // Compactor write cursor.
+    int compacting;              // Nonzero while a compaction cycle is in progress.
+    size_t live_bytes;           // Bytes in live blocks (headers included).
+    size_t free_bytes;           // Bytes in holes below top (headers included).
+    size_t live_blocks;          // Live blocks.
+    size_t pinned_blocks;        // Live blocks with a nonzero pin count.
+    CompactHandleEntry* handles; // Handle table.
+    uint32_t handle_capacity;    // Entries in the handle table.
+    uint32_t handle_free;        // First free handle index + 1 (0 if none).
+    size_t moved_bytes_total;    // Bytes moved by the compactor since init.
+    size_t compactions;          // Completed compaction cycles.
+    size_t released_bytes_total; // Bytes decommitted after compaction since init.
+    CRITICAL_SECTION lock;       // Serializes every operation that may move blocks.
+} CompactPool;
+
+// CompactStats structure filled by compact_get_stats.
+typedef struct CompactStats {
+    size_t reserved;             // Bytes reserved.
+    size_t committed;            // Bytes committed right now.
+    size_t top;                  // Heap end.
+    size_t live_bytes;           // Bytes in live blocks.
+    size_t free_bytes;           // Bytes in holes below top.
+    size_t live_blocks;          // Live blocks.
+    size_t pinned_blocks;        // Pinned live blocks.
+    size_t moved_bytes_total;    // Bytes moved by the compactor.
+    size_t compactions;          // Completed compaction cycles.
+    size_t released_bytes_total; // Bytes returned to the OS.
+} CompactStats;
+
+/**
+ * compact_pool_init
+ * Reserves max_size bytes of address space and commits the first chunk.
+ *
+ * @param pool      Pointer to a CompactPool structure.
+ * @param max_size  Largest size the heap may reach in bytes.
+ * @return 1 on success, 0 on failure.
+ */
+int compact_pool_init(CompactPool* pool, size_t max_size);
+
+/**
+ * compact_alloc
+ * Appends a block of `size` bytes and returns its handle. While holes make up more
+ * than a quarter of the heap, each call also runs one compactor step of
+ * COMPACT_STEP_BYTES; when the reserved range is full, a whole compaction runs
+ * before giving up. Any call may move unpinned blocks.
+ *
+ * @param pool  Pointer to the CompactPool structure.
+ * @param size  Payload size in bytes.
+ * @return Handle, or COMPACT_INVALID_HANDLE on failure.
+ */
+CompactHandle compact_alloc(CompactPool* pool, size_t size);
+
+/**
+ * compact_free
+ * Frees the block of a handle and recycles the handle. Freeing a pinned block is
+ * allowed; the pin is dropped with it.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Handle returned by compact_alloc.
+ */
+void compact_free(CompactPool* pool, CompactHandle handle);
+
+/**
+ * compact_deref
+ * Returns the current address of a block. The pointer stays valid until the next
+ * compact_alloc or compact_step unless the block is pinned. Takes no lock; use it
+ * from the thread that drives the pool.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Live handle.
+ * @return Payload address, or NULL for an invalid handle.
+ */
+void* compact_deref(CompactPool* pool, CompactHandle handle);
+
+/**
+ * compact_pin
+ * Pins a block so the compactor leaves it in place and returns its address, which
+ * stays valid until the matching compact_unpin. Pins nest.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Live handle.
+ * @return Payload address, or NULL for an invalid handle.
+ */
+void* compact_pin(CompactPool* pool, CompactHandle handle);
+
+/**
+ * compact_unpin
+ * Drops one pin taken by compact_pin.
+ *
+ * @param pool    Pointer to the CompactPool structure.
+ * @param handle  Pinned handle.
+ */
+void compact_unpin(CompactPool* pool, CompactHandle handle);
+
+/**
+ * compact_step
+ * Runs the compactor over at most max_bytes of the heap, starting a new cycle if
+ * none is in progress. Live unpinned blocks slide down over the holes before them;
+ * pinned blocks stay and leave a hole in front of them. The cycle that reaches the
+ * heap end decommits the committed pages past the new end.
+ *
+ * @param pool       Pointer to the CompactPool structure.
+ * @param max_bytes  Bytes of heap to visit in this step.
+ * @return 1 if a compaction cycle finished in this step, 0 otherwise.
+ */
+int compact_step(CompactPool* pool, size_t max_bytes);
+
+/**
+ * compact_full
+ * Runs (or finishes) a whole compaction cycle.
+ *
+ * @param pool  Pointer to the CompactPool structure.
+ * @return Bytes decommitted by this cycle.
+ */
+size_t compact_full(CompactPool* pool);
+
+/**
+ * compact_get_stats
+ * Reports heap, handle and compactor counters.
+ *
+ * @param pool   Pointer to the CompactPool structure.
+ * @param stats  Receives the statistics.
+ */
+void compact_get_stats(CompactPool* pool, CompactStats* stats);
+
+/**
+ * compact_pool_destroy
+ * Releases the reserved range, the handle table and the lock.
+ *
+ * @param pool  Pointer to the CompactPool structure.
+ */
+void compact_pool_destroy(CompactPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPACT_ALLOC_H
@@ -0,0 +1,179 @@
+// bench_container.cpp
+
+#include <stdio.h>
+#include <stddef.h>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <windows.h>
+#include "container_alloc.h"
+
+#define ELEMENTS 1000000  // Elements per container.
+#define LOOKUPS  2000000  // Lookups per map benchmark.
+
+static double seconds_since(LARGE_INTEGER start, LARGE_INTEGER frequency) {
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&end);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+static uint64_t mix_key(uint64_t i) {
+    return (i * 0x9E3779B97F4A7C15ULL) ^ (i >> 7);
+}
+
+// Lookup i: half hits, half misses, in an order unrelated to insertion order.
+static uint64_t lookup_key(uint64_t i) {
+    return mix_key((i * 7919) % (2 * ELEMENTS));
+}
+
+// Caller node for the intrusive list.
+struct Item {
+    uint64_t id;
+    double weight;
+    IListLink link;
+};
+
+// Builds a list, removes every third element, then walks it 10 times.
+static void bench_lists(LARGE_INTEGER frequency) {
+    LARGE_INTEGER start;
+    uint64_t sum = 0;
+    QueryPerformanceCounter(&start);
+    {
+        std::list<Item> list;
+        for (uint64_t i = 0; i < ELEMENTS; i++)
+            list.push_back(Item{ i, i * 0.5, {} });
+        uint64_t n = 0;
+        for (auto it = list.begin(); it != list.end(); n++) {
+            if (n % 3 == 0)
+                it = list.erase(it);
+            else
+                ++it;
+        }
+        for (int walk = 0; walk < 10; walk++) {
+            for (const Item& item : list)
+                sum += item.id;
+        }
+    }
+    printf("std::list, %d elements: %.6f seconds (sum %llu)\n", ELEMENTS, seconds_since(start, frequency),
+           (unsigned long long)sum);
+
+    IList list;
+    if (!ilist_init(&list, ELEMENTS, sizeof(Item), offsetof(Item, link))) {
+        printf("IList initialization failed.\n");
+        return;
+    }
+    sum = 0;
+    QueryPerformanceCounter(&start);
+    void* batch[256];
+    for (uint64_t i = 0; i < ELEMENTS;) {
+        size_t got = ilist_alloc_bulk(&list, batch, 256);
+        for (size_t j = 0; j < got; j++, i++) {
+            Item* item = (Item*)batch[j];
+            item->id = i;
+            item->weight = i * 0.5;
+            ilist_push_back(&list, item);
+        }
+        if (got == 0)
+            break;
+    }
+    uint64_t n = 0;
+    for (Item* item = (Item*)ilist_first(&list); item != NULL; n++) {
+        Item* next = (Item*)ilist_next(&list, item);
+        if (n % 3 == 0) {
+            ilist_remove(&list, item);
+            ilist_free(&list, item);
+        }
+        item = next;
+    }
+    for (int walk = 0; walk < 10; walk++) {
+        for (Item* item = (Item*)ilist_first(&list); item != NULL; item = (Item*)ilist_next(&list, item))
+            sum += item->id;
+    }
+    ilist_clear(&list);
+    printf("IList, %d elements: %.6f seconds (sum %llu)\n", ELEMENTS, seconds_since(start, frequency),
+           (unsigned long long)sum);
+    ilist_destroy(&list);
+}
+
+// Inserts ELEMENTS keys, runs LOOKUPS hits and misses, erases half.
+static void bench_hash_maps(LARGE_INTEGER frequency) {
+    LARGE_INTEGER start;
+    uint64_t hits = 0;
+    QueryPerformanceCounter(&start);
+    {
+        std::unordered_map<uint64_t, uint64_t> map;
+        for (uint64_t i = 0; i < ELEMENTS; i++)
+            map[mix_key(i)] = i;
+        for (uint64_t i = 0; i < LOOKUPS; i++)
+            hits += map.count(lookup_key(i));
+        for (uint64_t i = 0; i < ELEMENTS; i += 2)
+            map.erase(mix_key(i));
+        hits += map.size();
+    }
+    printf("std::unordered_map, %d keys: %.6f seconds (%llu)\n", ELEMENTS, seconds_since(start, frequency),
+           (unsigned long long)hits);
+
+    HMap map;
+    if (!hmap_init(&map, ELEMENTS)) {
+        printf("HMap initialization failed.\n");
+        return;
+    }
+    hits = 0;
+    QueryPerformanceCounter(&start);
+    for (uint64_t i = 0; i < ELEMENTS; i++)
+        hmap_put(&map, mix_key(i), i);
+    for (uint64_t i = 0; i < LOOKUPS; i++)
+        hits += (uint64_t)hmap_get(&map, lookup_key(i), NULL);
+    for (uint64_t i = 0; i < ELEMENTS; i += 2)
+        hmap_erase(&map, mix_key(i));
+    hits += map.count;
+    printf("HMap, %d keys: %.6f seconds (%llu)\n", ELEMENTS, seconds_since(start, frequency),
+           (unsigned long long)hits);
+    hmap_destroy(&map);
+}
+
+// Inserts ELEMENTS keys in random order, runs LOOKUPS lookups and an ordered scan.
+static void bench_ordered_maps(LARGE_INTEGER frequency) {
+    LARGE_INTEGER start;
+    uint64_t sum = 0;
+    QueryPerformanceCounter(&start);
+    {
+        std::map<uint64_t, uint64_t> map;
+        for (uint64_t i = 0; i < ELEMENTS; i++)
+            map[mix_key(i)] = i;
+        for (uint64_t i = 0; i < LOOKUPS; i++)
+            sum += map.count(lookup_key(i));
+        for (const auto& entry : map)
+            sum += entry.second;
+    }
+    printf("std::map, %d keys: %.6f seconds (%llu)\n", ELEMENTS, seconds_since(start, frequency),
+           (unsigned long long)sum);
+
+    SkipList list;
+    if (!skiplist_init(&list, ELEMENTS)) {
+        printf("SkipList initialization failed.\n");
+        return;
+    }
+    sum = 0;
+    QueryPerformanceCounter(&start);
+    for (uint64_t i = 0; i < ELEMENTS; i++)
+        skiplist_put(&list, mix_key(i), i);
+    for (uint64_t i = 0; i < LOOKUPS; i++)
+        sum += (uint64_t)skiplist_get(&list, lookup_key(i), NULL);
+    for (SkipNode* node = skiplist_seek(&list, 0); node != NULL; node = skiplist_next(&list, node))
+        sum += node->value;
+    printf("SkipList, %d keys: %.6f seconds (%llu)\n", ELEMENTS, seconds_since(start, frequency),
+           (unsigned long long)sum);
+    skiplist_destroy(&list);
+}
+
+int main() {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    // Benchmark slab-backed containers against their std equivalents.
+    bench_lists(frequency);
+    bench_hash_maps(frequency);
+    bench_ordered_maps(frequency);
+    return 0;
+}
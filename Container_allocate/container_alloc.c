@@ -0,0 +1,552 @@
+// container_alloc.c
+
+#include "container_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// Slab Indices
+// ---------------------------------------------------------------------------
+
+/**
+ * slab_index_of
+ * Object number of a pointer returned by slab_alloc.
+ */
+static inline uint32_t slab_index_of(const Slab* slab, const void* ptr) {
+    return (uint32_t)((size_t)((const unsigned char*)ptr - HEADER_SIZE - slab->memory) / slab->object_size);
+}
+
+/**
+ * slab_object_at
+ * Pointer (as returned by slab_alloc) of object number `index`.
+ */
+static inline void* slab_object_at(const Slab* slab, uint32_t index) {
+    return slab->memory + (size_t)index * slab->object_size + HEADER_SIZE;
+}
+
+// ---------------------------------------------------------------------------
+// Intrusive List
+// ---------------------------------------------------------------------------
+
+static inline IListLink* ilist_link(IList* list, void* node) {
+    return (IListLink*)((unsigned char*)node + list->link_offset);
+}
+
+static inline IListLink* ilist_link_at(IList* list, uint32_t index) {
+    return ilist_link(list, slab_object_at(&list->slab, index));
+}
+
+/**
+ * ilist_init
+ * Creates the node slab (node_size + HEADER_SIZE per object) and an empty list.
+ */
+int ilist_init(IList* list, size_t capacity, size_t node_size, size_t link_offset) {
+    if (!list || capacity == 0 || capacity >= CONTAINER_NIL || link_offset + sizeof(IListLink) > node_size)
+        return 0;
+    if (!slab_init(&list->slab, capacity, node_size + HEADER_SIZE))
+        return 0;
+    list->link_offset = link_offset;
+    list->head = CONTAINER_NIL;
+    list->tail = CONTAINER_NIL;
+    list->count = 0;
+    return 1;
+}
+
+/**
+ * ilist_alloc
+ * Pops a node from the list's slab.
+ */
+void* ilist_alloc(IList* list) {
+    return list ? slab_alloc(&list->slab) : NULL;
+}
+
+/**
+ * ilist_alloc_bulk
+ * Cuts a run of nodes off the slab's free list.
+ */
+size_t ilist_alloc_bulk(IList* list, void** nodes, size_t count) {
+    return list ? slab_alloc_bulk(&list->slab, nodes, count) : 0;
+}
+
+/**
+ * ilist_free
+ * Returns an unlinked node to the slab.
+ */
+void ilist_free(IList* list, void* node) {
+    if (list && node)
+        slab_free(&list->slab, node);
+}
+
+/**
+ * ilist_push_front
+ * Links a node before the head.
+ */
+void ilist_push_front(IList* list, void* node) {
+    uint32_t index = slab_index_of(&list->slab, node);
+    IListLink* link = ilist_link(list, node);
+    link->prev = CONTAINER_NIL;
+    link->next = list->head;
+    if (list->head != CONTAINER_NIL)
+        ilist_link_at(list, list->head)->prev = index;
+    else
+        list->tail = index;
+    list->head = index;
+    list->count++;
+}
+
+/**
+ * ilist_push_back
+ * Links a node after the tail.
+ */
+void ilist_push_back(IList* list, void* node) {
+    uint32_t index = slab_index_of(&list->slab, node);
+    IListLink* link = ilist_link(list, node);
+    link->next = CONTAINER_NIL;
+    link->prev = list->tail;
+    if (list->tail != CONTAINER_NIL)
+        ilist_link_at(list, list->tail)->next = index;
+    else
+        list->head = index;
+    list->tail = index;
+    list->count++;
+}
+
+/**
+ * ilist_insert_after
+ * Links `node` between `pos` and its successor.
+ */
+void ilist_insert_after(IList* list, void* pos, void* node) {
+    uint32_t pos_index = slab_index_of(&list->slab, pos);
+    uint32_t index = slab_index_of(&list->slab, node);
+    IListLink* pos_link = ilist_link(list, pos);
+    IListLink* link = ilist_link(list, node);
+    link->prev = pos_index;
+    link->next = pos_link->next;
+    if (pos_link->next != CONTAINER_NIL)
+        ilist_link_at(list, pos_link->next)->prev = index;
+    else
+        list->tail = index;
+    pos_link->next = index;
+    list->count++;
+}
+
+/**
+ * ilist_remove
+ * Unlinks a node and clears its link.
+ */
+void ilist_remove(IList* list, void* node) {
+    IListLink* link = ilist_link(list, node);
+    if (link->prev != CONTAINER_NIL)
+        ilist_link_at(list, link->prev)->next = link->next;
+    else
+        list->head = link->next;
+    if (link->next != CONTAINER_NIL)
+        ilist_link_at(list, link->next)->prev = link->prev;
+    else
+        list->tail = link->prev;
+    link->prev = CONTAINER_NIL;
+    link->next = CONTAINER_NIL;
+    list->count--;
+}
+
+/**
+ * ilist_first
+ * Head node, or NULL.
+ */
+void* ilist_first(IList* list) {
+    return list->head != CONTAINER_NIL ? slab_object_at(&list->slab, list->head) : NULL;
+}
+
+/**
+ * ilist_last
+ * Tail node, or NULL.
+ */
+void* ilist_last(IList* list) {
+    return list->tail != CONTAINER_NIL ? slab_object_at(&list->slab, list->tail) : NULL;
+}
+
+/**
+ * ilist_next
+ * Successor of a node, or NULL.
+ */
+void* ilist_next(IList* list, void* node) {
+    uint32_t next = ilist_link(list, node)->next;
+    return next != CONTAINER_NIL ? slab_object_at(&list->slab, next) : NULL;
+}
+
+/**
+ * ilist_prev
+ * Predecessor of a node, or NULL.
+ */
+void* ilist_prev(IList* list, void* node) {
+    uint32_t prev = ilist_link(list, node)->prev;
+    return prev != CONTAINER_NIL ? slab_object_at(&list->slab, prev) : NULL;
+}
+
+/**
+ * ilist_clear
+ * Resets the slab, which frees every node in one pass.
+ */
+void ilist_clear(IList* list) {
+    if (!list)
+        return;
+    slab_reset(&list->slab);
+    list->head = CONTAINER_NIL;
+    list->tail = CONTAINER_NIL;
+    list->count = 0;
+}
+
+/**
+ * ilist_destroy
+ * Destroys the node slab.
+ */
+void ilist_destroy(IList* list) {
+    if (list)
+        slab_destroy(&list->slab);
+}
+
+// ---------------------------------------------------------------------------
+// Hash Map
+// ---------------------------------------------------------------------------
+
+static inline HMapEntry* hmap_bucket(HMap* map, uint64_t key) {
+    return &map->buckets[(key * 0x9E3779B97F4A7C15ULL) >> map->bucket_shift];
+}
+
+static inline HMapEntry* hmap_overflow_at(HMap* map, uint32_t index) {
+    return (HMapEntry*)slab_object_at(&map->overflow, index);
+}
+
+/**
+ * hmap_init
+ * Allocates a power-of-two bucket array of at least `capacity` entries and an
+ * overflow slab for capacity / 2 + 64 entries.
+ */
+int hmap_init(HMap* map, size_t capacity) {
+    if (!map || capacity == 0 || capacity >= CONTAINER_NIL)
+        return 0;
+    size_t buckets = 2;
+    unsigned int bits = 1;
+    while (buckets < capacity) {
+        buckets <<= 1;
+        bits++;
+    }
+    map->buckets = (HMapEntry*)_aligned_malloc(buckets * sizeof(HMapEntry), 64);
+    if (map->buckets == NULL)
+        return 0;
+    if (!slab_init(&map->overflow, capacity / 2 + 64, sizeof(HMapEntry) + HEADER_SIZE)) {
+        _aligned_free(map->buckets);
+        return 0;
+    }
+    memset(map->buckets, 0, buckets * sizeof(HMapEntry));
+    map->bucket_shift = 64 - bits;
+    map->count = 0;
+    map->capacity = capacity;
+    return 1;
+}
+
+/**
+ * hmap_put
+ * Fills an empty bucket inline; otherwise updates the key in the chain, or links a
+ * new overflow entry right behind the inline entry.
+ */
+int hmap_put(HMap* map, uint64_t key, uint64_t value) {
+    HMapEntry* bucket = hmap_bucket(map, key);
+    if (!bucket->used) {
+        if (map->count == map->capacity)
+            return 0;
+        bucket->key = key;
+        bucket->value = value;
+        bucket->next = CONTAINER_NIL;
+        bucket->used = 1;
+        map->count++;
+        return 1;
+    }
+    for (HMapEntry* entry = bucket;;) {
+        if (entry->key == key) {
+            entry->value = value;
+            return 1;
+        }
+        if (entry->next == CONTAINER_NIL)
+            break;
+        entry = hmap_overflow_at(map, entry->next);
+    }
+    if (map->count == map->capacity)
+        return 0;
+    HMapEntry* entry = (HMapEntry*)slab_alloc(&map->overflow);
+    if (entry == NULL)
+        return 0;
+    // New overflow entries go right behind the inline entry.
+    entry->key = key;
+    entry->value = value;
+    entry->next = bucket->next;
+    entry->used = 1;
+    bucket->next = slab_index_of(&map->overflow, entry);
+    map->count++;
+    return 1;
+}
+
+/**
+ * hmap_get
+ * Checks the inline entry, then walks the overflow chain.
+ */
+int hmap_get(HMap* map, uint64_t key, uint64_t* value) {
+    HMapEntry* entry = hmap_bucket(map, key);
+    if (!entry->used)
+        return 0;
+    for (;;) {
+        if (entry->key == key) {
+            if (value)
+                *value = entry->value;
+            return 1;
+        }
+        if (entry->next == CONTAINER_NIL)
+            return 0;
+        entry = hmap_overflow_at(map, entry->next);
+    }
+}
+
+/**
+ * hmap_erase
+ * Unlinks the entry; an erased inline entry is replaced by its first overflow entry.
+ */
+int hmap_erase(HMap* map, uint64_t key) {
+    HMapEntry* bucket = hmap_bucket(map, key);
+    if (!bucket->used)
+        return 0;
+    if (bucket->key == key) {
+        if (bucket->next == CONTAINER_NIL) {
+            bucket->used = 0;
+        } else {
+            HMapEntry* first = hmap_overflow_at(map, bucket->next);
+            bucket->key = first->key;
+            bucket->value = first->value;
+            bucket->next = first->next;
+            slab_free(&map->overflow, first);
+        }
+        map->count--;
+        return 1;
+    }
+    HMapEntry* prev = bucket;
+    while (prev->next != CONTAINER_NIL) {
+        HMapEntry* entry = hmap_overflow_at(map, prev->next);
+        if (entry->key == key) {
+            prev->next = entry->next;
+            slab_free(&map->overflow, entry);
+            map->count--;
+            return 1;
+        }
+        prev = entry;
+    }
+    return 0;
+}
+
+/**
+ * hmap_clear
+ * Clears the bucket array and resets the overflow slab.
+ */
+void hmap_clear(HMap* map) {
+    if (!map)
+        return;
+    memset(map->buckets, 0, ((size_t)1 << (64 - map->bucket_shift)) * sizeof(HMapEntry));
+    slab_reset(&map->overflow);
+    map->count = 0;
+}
+
+/**
+ * hmap_destroy
+ * Frees the bucket array and destroys the overflow slab.
+ */
+void hmap_destroy(HMap* map) {
+    if (!map)
+        return;
+    _aligned_free(map->buckets);
+    map->buckets = NULL;
+    slab_destroy(&map->overflow);
+}
+
+// ---------------------------------------------------------------------------
+// Skiplist
+// ---------------------------------------------------------------------------
+
+#define SKIP_CLASS_SHIFT 30
+#define SKIP_INDEX_MASK  ((1u << SKIP_CLASS_SHIFT) - 1)
+
+static const uint32_t skip_class_height[SKIP_CLASSES] = { 2, 4, 8, 32 };
+
+static inline SkipNode* skip_node(SkipList* list, uint32_t ref) {
+    return (SkipNode*)slab_object_at(&list->classes[ref >> SKIP_CLASS_SHIFT], ref & SKIP_INDEX_MASK);
+}
+
+static inline uint32_t skip_class_of(uint32_t height) {
+    uint32_t cls = 0;
+    while (skip_class_height[cls] < height)
+        cls++;
+    return cls;
+}
+
+/**
+ * skip_random_height
+ * Height with P(h >= k) = 2^-(k-1), capped at SKIP_MAX_LEVEL.
+ */
+static uint32_t skip_random_height(SkipList* list) {
+    uint32_t bits = list->seed;  // xorshift32: every bit is usable, unlike the low LCG bits.
+    bits ^= bits << 13;
+    bits ^= bits >> 17;
+    bits ^= bits << 5;
+    list->seed = bits;
+    uint32_t height = 1;
+    while ((bits & 1) && height < SKIP_MAX_LEVEL) {
+        height++;
+        bits >>= 1;
+    }
+    return height;
+}
+
+/**
+ * skiplist_init
+ * Creates one slab per height class and an empty list.
+ */
+int skiplist_init(SkipList* list, size_t capacity) {
+    if (!list || capacity == 0 || capacity >= SKIP_INDEX_MASK)
+        return 0;
+    size_t counts[SKIP_CLASSES] = { capacity, capacity / 4 + 64, capacity / 16 + 64, capacity / 256 + 64 };
+    for (int cls = 0; cls < SKIP_CLASSES; cls++) {
+        size_t node_size = offsetof(SkipNode, next) + skip_class_height[cls] * sizeof(SkipLink);
+        if (!slab_init(&list->classes[cls], counts[cls], node_size + HEADER_SIZE)) {
+            while (cls-- > 0)
+                slab_destroy(&list->classes[cls]);
+            return 0;
+        }
+    }
+    for (int level = 0; level < SKIP_MAX_LEVEL; level++) {
+        list->head[level].key = 0;
+        list->head[level].ref = CONTAINER_NIL;
+        list->head[level].reserved = 0;
+    }
+    list->level = 1;
+    list->count = 0;
+    list->seed = 0x2545F491u;
+    return 1;
+}
+
+/**
+ * skip_find
+ * Fills `update` with the last link before `key` on every level (a head link or a
+ * node's link) and returns the level-0 link to the first node with a key >= key.
+ * Keys are compared through the links, so only nodes moved to are loaded.
+ */
+static SkipLink* skip_find(SkipList* list, uint64_t key, SkipLink** update) {
+    SkipLink* links = list->head;
+    for (int level = list->level - 1; level >= 0; level--) {
+        while (links[level].ref != CONTAINER_NIL && links[level].key < key)
+            links = skip_node(list, links[level].ref)->next;
+        if (update)
+            update[level] = &links[level];
+    }
+    return &links[0];
+}
+
+/**
+ * skiplist_put
+ * Updates an existing key, or links a new node of random height on every level
+ * below its height.
+ */
+int skiplist_put(SkipList* list, uint64_t key, uint64_t value) {
+    SkipLink* update[SKIP_MAX_LEVEL];
+    SkipLink* found = skip_find(list, key, update);
+    if (found->ref != CONTAINER_NIL && found->key == key) {
+        skip_node(list, found->ref)->value = value;
+        return 1;
+    }
+    uint32_t height = skip_random_height(list);
+    uint32_t cls = skip_class_of(height);
+    SkipNode* node = NULL;
+    // A full class hands the node down to a lower height.
+    for (;;) {
+        node = (SkipNode*)slab_alloc(&list->classes[cls]);
+        if (node != NULL || cls == 0)
+            break;
+        cls--;
+        height = skip_class_height[cls];
+    }
+    if (node == NULL)
+        return 0;
+    for (int level = list->level; level < (int)height; level++)
+        update[level] = &list->head[level];
+    if ((int)height > list->level)
+        list->level = (int)height;
+    uint32_t ref = (cls << SKIP_CLASS_SHIFT) | slab_index_of(&list->classes[cls], node);
+    node->key = key;
+    node->value = value;
+    node->height = height;
+    for (uint32_t level = 0; level < height; level++) {
+        node->next[level] = *update[level];
+        update[level]->key = key;
+        update[level]->ref = ref;
+    }
+    list->count++;
+    return 1;
+}
+
+/**
+ * skiplist_get
+ * Searches from the top level down.
+ */
+int skiplist_get(SkipList* list, uint64_t key, uint64_t* value) {
+    SkipLink* found = skip_find(list, key, NULL);
+    if (found->ref == CONTAINER_NIL || found->key != key)
+        return 0;
+    if (value)
+        *value = skip_node(list, found->ref)->value;
+    return 1;
+}
+
+/**
+ * skiplist_erase
+ * Unlinks the node on every level, drops empty top levels and frees the node to
+ * its class slab.
+ */
+int skiplist_erase(SkipList* list, uint64_t key) {
+    SkipLink* update[SKIP_MAX_LEVEL];
+    SkipLink* found = skip_find(list, key, update);
+    if (found->ref == CONTAINER_NIL || found->key != key)
+        return 0;
+    uint32_t ref = found->ref;
+    SkipNode* node = skip_node(list, ref);
+    for (uint32_t level = 0; level < node->height; level++)
+        *update[level] = node->next[level];
+    while (list->level > 1 && list->head[list->level - 1].ref == CONTAINER_NIL)
+        list->level--;
+    slab_free(&list->classes[ref >> SKIP_CLASS_SHIFT], node);
+    list->count--;
+    return 1;
+}
+
+/**
+ * skiplist_seek
+ * First node with a key >= key, or NULL.
+ */
+SkipNode* skiplist_seek(SkipList* list, uint64_t key) {
+    SkipLink* found = skip_find(list, key, NULL);
+    return found->ref != CONTAINER_NIL ? skip_node(list, found->ref) : NULL;
+}
+
+/**
+ * skiplist_next
+ * Level-0 successor, or NULL.
+ */
+SkipNode* skiplist_next(SkipList* list, SkipNode* node) {
+    return node->next[0].ref != CONTAINER_NIL ? skip_node(list, node->next[0].ref) : NULL;
+}
+
+/**
+ * skiplist_destroy
+ * Destroys the height class slabs.
+ */
+void skiplist_destroy(SkipList* list) {
+    if (!list)
+        return;
+    for (int cls = 0; cls < SKIP_CLASSES; cls++)
+        slab_destroy(&list->classes[cls]);
+}
@@ -0,0 +1,316 @@
+// container_alloc.h
+
+#ifndef CONTAINER_ALLOC_H
+#define CONTAINER_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "slab_alloc.h"
+
+// Containers built around Slab: every container owns its slabs, so its nodes sit
+// together in one mapping, and nodes refer to each other with 32-bit slab indices
+// (object number within the slab) instead of 64-bit pointers. A container never
+// grows beyond the capacity given at init.
+
+#define CONTAINER_NIL 0xFFFFFFFFu  // "No node" index.
+
+// ---------------------------------------------------------------------------
+// Intrusive doubly linked list
+// ---------------------------------------------------------------------------
+
+// IListLink: embedded in the caller's node type.
+typedef struct IListLink {
+    uint32_t prev;               // Index of the previous node (CONTAINER_NIL at the head).
+    uint32_t next;               // Index of the next node (CONTAINER_NIL at the tail).
+} IListLink;
+
+// IList structure: nodes of node_size bytes carved from the list's own Slab.
+typedef struct IList {
+    Slab slab;                   // Node storage.
+    size_t link_offset;          // Offset of the IListLink inside a node.
+    uint32_t head;               // First node.
+    uint32_t tail;               // Last node.
+    size_t count;                // Linked nodes.
+} IList;
+
+/**
+ * ilist_init
+ * Creates a list whose slab holds `capacity` nodes of node_size bytes, each with an
+ * IListLink at link_offset.
+ *
+ * @param list         Pointer to an IList structure.
+ * @param capacity     Maximum number of nodes.
+ * @param node_size    Size of the caller's node type.
+ * @param link_offset  offsetof(node type, link member).
+ * @return 1 on success, 0 on failure.
+ */
+int ilist_init(IList* list, size_t capacity, size_t node_size, size_t link_offset);
+
+/**
+ * ilist_alloc
+ * Allocates an unlinked node from the list's slab.
+ *
+ * @param list  Pointer to the IList structure.
+ * @return Node, or NULL if the list is at capacity.
+ */
+void* ilist_alloc(IList* list);
+
+/**
+ * ilist_alloc_bulk
+ * Allocates up to `count` unlinked nodes with one slab_alloc_bulk call.
+ *
+ * @param list   Pointer to the IList structure.
+ * @param nodes  Receives the nodes.
+ * @param count  Number of nodes wanted.
+ * @return Number of nodes allocated.
+ */
+size_t ilist_alloc_bulk(IList* list, void** nodes, size_t count);
+
+/**
+ * ilist_free
+ * Returns an unlinked node to the list's slab.
+ *
+ * @param list  Pointer to the IList structure.
+ * @param node  Node from ilist_alloc (not linked).
+ */
+void ilist_free(IList* list, void* node);
+
+/**
+ * ilist_push_front / ilist_push_back
+ * Links a node at the head or the tail.
+ *
+ * @param list  Pointer to the IList structure.
+ * @param node  Unlinked node of this list.
+ */
+void ilist_push_front(IList* list, void* node);
+void ilist_push_back(IList* list, void* node);
+
+/**
+ * ilist_insert_after
+ * Links `node` right after `pos`.
+ *
+ * @param list  Pointer to the IList structure.
+ * @param pos   Linked node of this list.
+ * @param node  Unlinked node of this list.
+ */
+void ilist_insert_after(IList* list, void* pos, void* node);
+
+/**
+ * ilist_remove
+ * Unlinks a node; it stays allocated.
+ *
+ * @param list  Pointer to the IList structure.
+ * @param node  Linked node of this list.
+ */
+void ilist_remove(IList* list, void* node);
+
+/**
+ * ilist_first / ilist_last / ilist_next / ilist_prev
+ * Navigation; each returns NULL past either end.
+ */
+void* ilist_first(IList* list);
+void* ilist_last(IList* list);
+void* ilist_next(IList* list, void* node);
+void* ilist_prev(IList* list, void* node);
+
+/**
+ * ilist_clear
+ * Drops every node at once (slab_reset).
+ *
+ * @param list  Pointer to the IList structure.
+ */
+void ilist_clear(IList* list);
+
+/**
+ * ilist_destroy
+ * Releases the list's slab.
+ *
+ * @param list  Pointer to the IList structure.
+ */
+void ilist_destroy(IList* list);
+
+// ---------------------------------------------------------------------------
+// Hash map (open bucket array with chained overflow)
+// ---------------------------------------------------------------------------
+
+// HMapEntry: a key/value pair; the first entry of a bucket lives in the bucket
+// array, further entries are chained through `next` in the overflow slab.
+typedef struct HMapEntry {
+    uint64_t key;
+    uint64_t value;
+    uint32_t next;               // Overflow index of the next entry (CONTAINER_NIL ends the chain).
+    uint32_t used;               // Nonzero if this bucket slot holds an entry.
+} HMapEntry;
+
+// HMap structure: uint64 -> uint64 map of fixed capacity.
+typedef struct HMap {
+    HMapEntry* buckets;          // Power-of-two bucket array (one inline entry each).
+    unsigned int bucket_shift;   // 64 - log2(bucket count), for Fibonacci hashing.
+    Slab overflow;               // Chained entries of buckets that already hold one.
+    size_t count;                // Entries in the map.
+    size_t capacity;             // Entries the map was sized for.
+} HMap;
+
+/**
+ * hmap_init
+ * Creates a map for `capacity` entries: at least that many buckets, and an
+ * overflow slab for half of them (with a load factor of at most one, about 37% of
+ * the entries overflow on average).
+ *
+ * @param map       Pointer to an HMap structure.
+ * @param capacity  Maximum number of entries.
+ * @return 1 on success, 0 on failure.
+ */
+int hmap_init(HMap* map, size_t capacity);
+
+/**
+ * hmap_put
+ * Inserts a key or replaces its value.
+ *
+ * @param map    Pointer to the HMap structure.
+ * @param key    Key.
+ * @param value  Value.
+ * @return 1 on success, 0 if the map or its overflow slab is full.
+ */
+int hmap_put(HMap* map, uint64_t key, uint64_t value);
+
+/**
+ * hmap_get
+ * Looks a key up.
+ *
+ * @param map    Pointer to the HMap structure.
+ * @param key    Key.
+ * @param value  Receives the value (may be NULL).
+ * @return 1 if found, 0 otherwise.
+ */
+int hmap_get(HMap* map, uint64_t key, uint64_t* value);
+
+/**
+ * hmap_erase
+ * Removes a key. Erasing the inline entry of a bucket pulls its first overflow
+ * entry into the bucket array.
+ *
+ * @param map  Pointer to the HMap structure.
+ * @param key  Key.
+ * @return 1 if the key was present, 0 otherwise.
+ */
+int hmap_erase(HMap* map, uint64_t key);
+
+/**
+ * hmap_clear
+ * Removes every entry.
+ *
+ * @param map  Pointer to the HMap structure.
+ */
+void hmap_clear(HMap* map);
+
+/**
+ * hmap_destroy
+ * Releases the bucket array and the overflow slab.
+ *
+ * @param map  Pointer to the HMap structure.
+ */
+void hmap_destroy(HMap* map);
+
+// ---------------------------------------------------------------------------
+// Skiplist
+// ---------------------------------------------------------------------------
+
+#define SKIP_MAX_LEVEL 32
+#define SKIP_CLASSES   4         // Node heights 1-2, 3-4, 5-8 and 9-32, one slab each.
+
+// SkipLink: forward reference plus a copy of the target's key, so a search only
+// loads the nodes it moves to. A reference is (class << 30) | index into that
+// class's slab.
+typedef struct SkipLink {
+    uint64_t key;                // Key of the target node.
+    uint32_t ref;                // Target node (CONTAINER_NIL ends the level).
+    uint32_t reserved;
+} SkipLink;
+
+// SkipNode: key/value and `height` forward links.
+typedef struct SkipNode {
+    uint64_t key;
+    uint64_t value;
+    uint32_t height;
+    uint32_t reserved;
+    SkipLink next[1];            // `height` entries (the slab object is sized for its class).
+} SkipNode;
+
+// SkipList structure: ordered uint64 -> uint64 map of fixed capacity.
+typedef struct SkipList {
+    Slab classes[SKIP_CLASSES];  // Node storage per height class.
+    SkipLink head[SKIP_MAX_LEVEL];  // First link per level.
+    int level;                   // Levels in use.
+    size_t count;                // Entries in the list.
+    uint32_t seed;               // Height generator state.
+} SkipList;
+
+/**
+ * skiplist_init
+ * Creates a list for `capacity` entries. The height classes get capacity,
+ * capacity/4, capacity/16 and capacity/256 nodes (plus slack); a node whose class
+ * is full is given a lower height instead.
+ *
+ * @param list      Pointer to a SkipList structure.
+ * @param capacity  Maximum number of entries (below 2^30).
+ * @return 1 on success, 0 on failure.
+ */
+int skiplist_init(SkipList* list, size_t capacity);
+
+/**
+ * skiplist_put
+ * Inserts a key or replaces its value.
+ *
+ * @return 1 on success, 0 if the list is full.
+ */
+int skiplist_put(SkipList* list, uint64_t key, uint64_t value);
+
+/**
+ * skiplist_get
+ * Looks a key up.
+ *
+ * @param value  Receives the value (may be NULL).
+ * @return 1 if found, 0 otherwise.
+ */
+int skiplist_get(SkipList* list, uint64_t key, uint64_t* value);
+
+/**
+ * skiplist_erase
+ * Removes a key.
+ *
+ * @return 1 if the key was present, 0 otherwise.
+ */
+int skiplist_erase(SkipList* list, uint64_t key);
+
+/**
+ * skiplist_seek
+ * Finds the first node whose key is >= key.
+ *
+ * @return Node, or NULL if every key is smaller.
+ */
+SkipNode* skiplist_seek(SkipList* list, uint64_t key);
+
+/**
+ * skiplist_next
+ * Returns the node after `node` in key order, or NULL.
+ */
+SkipNode* skiplist_next(SkipList* list, SkipNode* node);
+
+/**
+ * skiplist_destroy
+ * Releases the node slabs.
+ *
+ * @param list  Pointer to the SkipList structure.
+ */
+void skiplist_destroy(SkipList* list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONTAINER_ALLOC_H
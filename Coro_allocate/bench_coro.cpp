@@ -0,0 +1,110 @@
+// bench_coro.cpp
+
+#include <stdio.h>
+#include <coroutine>
+#include <exception>
+#include <windows.h>
+#include "coro_alloc.hpp"
+
+#define IN_FLIGHT   1024   // Coroutines suspended at once (pending requests).
+#define ROUNDS      1000   // Spawn/complete rounds per thread.
+#define MAX_THREADS 4
+
+// BasicTask: the promise inherits its frame operator new/delete (if any) from Base.
+template <class Base>
+struct BasicTask {
+    struct promise_type : Base {
+        long long value = 0;
+
+        BasicTask get_return_object() { return BasicTask{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(long long v) { value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+struct NoBase {};
+using DefaultTask = BasicTask<NoBase>;
+using SlabTask = BasicTask<allocates::SlabFramePromise>;
+
+// A request handler: some locals that live across a suspension point.
+template <class Task>
+static Task handle_request(int id) {
+    unsigned char scratch[128];
+    for (int i = 0; i < 128; i++)
+        scratch[i] = (unsigned char)(id + i);
+    co_await std::suspend_always{};  // Waits for "I/O".
+    long long sum = 0;
+    for (int i = 0; i < 128; i += 16)
+        sum += scratch[i];
+    co_return sum;
+}
+
+// Spawns IN_FLIGHT handlers, drives each to its suspension point, then completes
+// and destroys them, ROUNDS times.
+template <class Task>
+static long long run_handlers() {
+    static thread_local Task tasks[IN_FLIGHT];
+    long long checksum = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < IN_FLIGHT; i++) {
+            tasks[i] = handle_request<Task>(i);
+            tasks[i].handle.resume();
+        }
+        for (int i = 0; i < IN_FLIGHT; i++) {
+            tasks[i].handle.resume();
+            checksum += tasks[i].handle.promise().value;
+            tasks[i].handle.destroy();
+        }
+    }
+    return checksum;
+}
+
+template <class Task>
+static DWORD WINAPI handler_worker(LPVOID arg) {
+    *(long long*)arg = run_handlers<Task>();
+    return 0;
+}
+
+// Runs the handlers on `threads` threads and prints the elapsed time.
+template <class Task>
+static void bench_coroutines(const char* label, int threads, LARGE_INTEGER frequency) {
+    HANDLE handles[MAX_THREADS];
+    long long checksums[MAX_THREADS] = { 0 };
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int t = 0; t < threads; t++)
+        handles[t] = CreateThread(NULL, 0, handler_worker<Task>, &checksums[t], 0, NULL);
+    WaitForMultipleObjects(threads, handles, TRUE, INFINITE);
+    QueryPerformanceCounter(&end);
+    long long checksum = 0;
+    for (int t = 0; t < threads; t++) {
+        CloseHandle(handles[t]);
+        checksum += checksums[t];
+    }
+    printf("%s, %d thread(s), %d coroutines: %.6f seconds (checksum %lld)\n", label, threads,
+           threads * IN_FLIGHT * ROUNDS, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, checksum);
+}
+
+int main() {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    // Benchmark spawning and completing coroutines, global new vs slab frames.
+    bench_coroutines<DefaultTask>("Default frames", 1, frequency);
+    bench_coroutines<SlabTask>("Slab frames", 1, frequency);
+    bench_coroutines<DefaultTask>("Default frames", MAX_THREADS, frequency);
+    bench_coroutines<SlabTask>("Slab frames", MAX_THREADS, frequency);
+
+    allocates::CoroFrameStats stats;
+    allocates::coro_frame_get_stats(&stats);
+    printf("Slab frames: %zu refills, %zu flushes, %zu large frames, chunks per class:",
+           stats.refills, stats.flushes, stats.large_frames);
+    for (std::size_t i = 0; i < allocates::CORO_CLASS_COUNT; i++)
+        printf(" %zu", stats.class_chunks[i]);
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,215 @@
+// coro_alloc.cpp
+
+#include "coro_alloc.hpp"
+#include <stdlib.h>
+#include <windows.h>
+
+namespace allocates {
+namespace {
+
+// ---------------------------------------------------------------------------
+// Size Classes
+// ---------------------------------------------------------------------------
+
+// FrameClass: the Slab chunks of one size class, shared by all threads.
+struct FrameClass {
+    Slab* chunks[CORO_MAX_CHUNKS];  // Chunks in creation order.
+    std::size_t chunk_count;        // Chunks in use.
+    std::size_t current;            // Chunk tried first by refills and flushes.
+};
+
+FrameClass classes[CORO_CLASS_COUNT];
+volatile LONG classes_lock = 0;     // Guards classes and the counters below.
+std::size_t refills = 0;
+std::size_t flushes = 0;
+std::size_t large_frames = 0;
+
+void lock_classes() {
+    while (InterlockedExchange(&classes_lock, 1) != 0)
+        Sleep(0);
+}
+
+void unlock_classes() {
+    InterlockedExchange(&classes_lock, 0);
+}
+
+/**
+ * class_index
+ * Maps a frame size to its class (64 << index bytes).
+ */
+std::size_t class_index(std::size_t size) {
+    std::size_t index = 0;
+    while ((CORO_MIN_FRAME << index) < size)
+        index++;
+    return index;
+}
+
+/**
+ * add_chunk
+ * Appends a new Slab chunk to a class. Called with classes_lock held.
+ *
+ * @return The new chunk, or NULL if the class is full or the slab cannot be mapped.
+ */
+Slab* add_chunk(FrameClass* frame_class, std::size_t index) {
+    if (frame_class->chunk_count == CORO_MAX_CHUNKS)
+        return NULL;
+    Slab* chunk = static_cast<Slab*>(malloc(sizeof(Slab)));
+    std::size_t object_size = (CORO_MIN_FRAME << index) + HEADER_SIZE;
+    if (chunk == NULL || !slab_init(chunk, CORO_CHUNK_BYTES / object_size, object_size)) {
+        free(chunk);
+        return NULL;
+    }
+    frame_class->current = frame_class->chunk_count;
+    frame_class->chunks[frame_class->chunk_count++] = chunk;
+    return chunk;
+}
+
+/**
+ * refill_frames
+ * Takes up to `count` frames from the chunks of a class, starting with the current
+ * chunk and adding a chunk when all of them are exhausted.
+ *
+ * @return Number of frames stored in `frames`.
+ */
+std::size_t refill_frames(std::size_t index, void** frames, std::size_t count) {
+    FrameClass* frame_class = &classes[index];
+    std::size_t taken = 0;
+    lock_classes();
+    refills++;
+    std::size_t tried = 0;
+    while (taken < count) {
+        void* frame = NULL;
+        if (frame_class->chunk_count != 0)
+            frame = slab_alloc(frame_class->chunks[frame_class->current]);
+        if (frame != NULL) {
+            frames[taken++] = frame;
+            continue;
+        }
+        if (tried < frame_class->chunk_count) {
+            frame_class->current = (frame_class->current + 1) % frame_class->chunk_count;
+            tried++;
+        } else if (add_chunk(frame_class, index) == NULL) {
+            break;
+        }
+    }
+    unlock_classes();
+    return taken;
+}
+
+/**
+ * flush_frames
+ * Returns frames to the chunks that own them (the current chunk is checked first).
+ */
+void flush_frames(std::size_t index, void* const* frames, std::size_t count) {
+    FrameClass* frame_class = &classes[index];
+    lock_classes();
+    flushes++;
+    for (std::size_t i = 0; i < count; i++) {
+        const unsigned char* frame = static_cast<const unsigned char*>(frames[i]);
+        std::size_t chunk = frame_class->current;
+        for (std::size_t probe = 0; probe < frame_class->chunk_count; probe++) {
+            const Slab* slab = frame_class->chunks[chunk];
+            if (frame >= slab->memory && frame < slab->memory + slab->mapped_size)
+                break;
+            chunk = (chunk + 1) % frame_class->chunk_count;
+        }
+        slab_free(frame_class->chunks[chunk], frames[i]);
+    }
+    unlock_classes();
+}
+
+// ---------------------------------------------------------------------------
+// Thread Caches
+// ---------------------------------------------------------------------------
+
+// ThreadCache: free frames per class owned by one thread; flushed at thread exit.
+struct ThreadCache {
+    void* frames[CORO_CLASS_COUNT][CORO_CACHE_FRAMES];
+    std::size_t count[CORO_CLASS_COUNT] = {};
+
+    ~ThreadCache() {
+        for (std::size_t index = 0; index < CORO_CLASS_COUNT; index++) {
+            if (count[index] != 0)
+                flush_frames(index, frames[index], count[index]);
+        }
+    }
+};
+
+thread_local ThreadCache cache;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public Frame Allocation
+// ---------------------------------------------------------------------------
+
+/**
+ * coro_frame_alloc
+ * Pops a frame from the thread cache, refilling CORO_CACHE_BATCH frames when the
+ * cache is empty.
+ *
+ * @param size  Frame size.
+ * @return Frame address.
+ */
+void* coro_frame_alloc(std::size_t size) {
+    if (size > CORO_MAX_FRAME) {
+        lock_classes();
+        large_frames++;
+        unlock_classes();
+        return ::operator new(size);
+    }
+    std::size_t index = class_index(size);
+    ThreadCache& local = cache;
+    if (local.count[index] == 0) {
+        local.count[index] = refill_frames(index, local.frames[index], CORO_CACHE_BATCH);
+        if (local.count[index] == 0)
+            throw std::bad_alloc();
+    }
+    return local.frames[index][--local.count[index]];
+}
+
+/**
+ * coro_frame_free
+ * Pushes a frame on the thread cache, flushing the oldest CORO_CACHE_BATCH frames
+ * when the cache is full.
+ *
+ * @param ptr   Frame address.
+ * @param size  Frame size.
+ */
+void coro_frame_free(void* ptr, std::size_t size) noexcept {
+    if (ptr == NULL)
+        return;
+    if (size > CORO_MAX_FRAME) {
+        ::operator delete(ptr, size);
+        return;
+    }
+    std::size_t index = class_index(size);
+    ThreadCache& local = cache;
+    if (local.count[index] == CORO_CACHE_FRAMES) {
+        flush_frames(index, local.frames[index], CORO_CACHE_BATCH);
+        local.count[index] -= CORO_CACHE_BATCH;
+        for (std::size_t i = 0; i < local.count[index]; i++)
+            local.frames[index][i] = local.frames[index][i + CORO_CACHE_BATCH];
+    }
+    local.frames[index][local.count[index]++] = ptr;
+}
+
+/**
+ * coro_frame_get_stats
+ * Copies the chunk counts and cache counters under the class lock.
+ *
+ * @param stats  Receives the statistics.
+ */
+void coro_frame_get_stats(CoroFrameStats* stats) {
+    if (stats == NULL)
+        return;
+    lock_classes();
+    for (std::size_t index = 0; index < CORO_CLASS_COUNT; index++)
+        stats->class_chunks[index] = classes[index].chunk_count;
+    stats->refills = refills;
+    stats->flushes = flushes;
+    stats->large_frames = large_frames;
+    unlock_classes();
+}
+
+} // namespace allocates
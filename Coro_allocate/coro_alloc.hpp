@@ -0,0 +1,76 @@
+// coro_alloc.hpp
+
+#ifndef CORO_ALLOC_HPP
+#define CORO_ALLOC_HPP
+
+#include <cstddef>
+#include <new>
+#include "slab_alloc.h"
+
+// Coroutine frames are allocated through the promise type's operator new, which the
+// compiler calls with the frame size, and released through the sized operator delete
+// with the same size. SlabFramePromise routes both to size-classed Slabs:
+//
+//   struct promise_type : allocates::SlabFramePromise { ... };
+//
+// Each size class owns a list of Slab chunks shared by all threads (locked), and
+// every thread keeps a small cache of free frames per class, refilled and flushed in
+// batches. The size passed to delete picks the class directly; the owning chunk is
+// only looked up when a batch goes back to the shared chunks. Frames larger than
+// the biggest class go to the global operator new.
+
+namespace allocates {
+
+// Tuning.
+constexpr std::size_t CORO_CLASS_COUNT  = 7;       // Frame classes: 64, 128, ..., 4096 bytes.
+constexpr std::size_t CORO_MIN_FRAME    = 64;      // Smallest class.
+constexpr std::size_t CORO_MAX_FRAME    = 4096;    // Largest class; bigger frames use operator new.
+constexpr std::size_t CORO_CHUNK_BYTES  = 4 << 20; // Bytes per Slab chunk of a class.
+constexpr std::size_t CORO_MAX_CHUNKS   = 256;     // Chunks per class.
+constexpr std::size_t CORO_CACHE_FRAMES = 64;      // Thread cache capacity per class.
+constexpr std::size_t CORO_CACHE_BATCH  = 32;      // Frames moved per refill/flush.
+
+// CoroFrameStats structure filled by coro_frame_get_stats.
+struct CoroFrameStats {
+    std::size_t class_chunks[CORO_CLASS_COUNT];  // Slab chunks per class.
+    std::size_t refills;                         // Thread cache refills from the chunks.
+    std::size_t flushes;                         // Thread cache flushes to the chunks.
+    std::size_t large_frames;                    // Frames served by operator new.
+};
+
+/**
+ * coro_frame_alloc
+ * Allocates a coroutine frame from the calling thread's cache of its size class.
+ * Throws std::bad_alloc when no chunk can be added.
+ *
+ * @param size  Frame size passed to the promise's operator new.
+ * @return Frame address (16-byte aligned).
+ */
+void* coro_frame_alloc(std::size_t size);
+
+/**
+ * coro_frame_free
+ * Returns a frame to the calling thread's cache of its size class.
+ *
+ * @param ptr   Frame returned by coro_frame_alloc.
+ * @param size  Size given to coro_frame_alloc for this frame.
+ */
+void coro_frame_free(void* ptr, std::size_t size) noexcept;
+
+/**
+ * coro_frame_get_stats
+ * Reports chunk and thread cache counters.
+ *
+ * @param stats  Receives the statistics.
+ */
+void coro_frame_get_stats(CoroFrameStats* stats);
+
+// SlabFramePromise: base class for promise types whose frames live in Slabs.
+struct SlabFramePromise {
+    static void* operator new(std::size_t size) { return coro_frame_alloc(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept { coro_frame_free(ptr, size); }
+};
+
+} // namespace allocates
+
+#endif // CORO_ALLOC_HPP
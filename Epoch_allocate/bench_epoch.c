@@ -0,0 +1,157 @@
+// bench_epoch.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+#include "epoch_alloc.h"
+
+#define SLOTS        4096      // Shared pointer table read by the readers.
+#define READERS      2         // Reader threads.
+#define REPLACEMENTS 1000000   // Objects replaced (and retired) by the writer.
+#define OBJECTS      (SLOTS * 64)
+
+#define MODE_IMMEDIATE  -1     // slab_free right after the unlink (unsafe baseline).
+
+// Record stored in each slab object: while live, check == ~value.
+typedef struct Record {
+    volatile uint64_t value;
+    volatile uint64_t check;
+} Record;
+
+typedef struct BenchShared {
+    SlabDomain domain;
+    Record* volatile slots[SLOTS];
+    volatile LONG stop;
+    int mode;
+} BenchShared;
+
+typedef struct ReaderArgs {
+    BenchShared* shared;
+    unsigned seed;
+    size_t lookups;
+    size_t torn;                 // Records seen with check != ~value (reused under the reader).
+} ReaderArgs;
+
+// Reader: looks up random slots until the writer stops. EBR brackets every lookup,
+// QSBR reports a quiescent point every 64 lookups.
+static DWORD WINAPI reader_main(LPVOID arg) {
+    ReaderArgs* args = (ReaderArgs*)arg;
+    BenchShared* shared = args->shared;
+    SlabDomainThread* thread = shared->mode == MODE_IMMEDIATE ? NULL : slab_domain_thread(&shared->domain);
+    unsigned seed = args->seed;
+    size_t lookups = 0, torn = 0;
+    while (!shared->stop) {
+        for (int i = 0; i < 64; i++) {
+            seed = seed * 1103515245u + 12345u;
+            if (shared->mode == SLAB_DOMAIN_EBR)
+                slab_domain_enter(thread);
+            Record* record = shared->slots[(seed >> 8) % SLOTS];
+            uint64_t value = record->value;
+            uint64_t check = record->check;
+            if (check != ~value)
+                torn++;
+            if (shared->mode == SLAB_DOMAIN_EBR)
+                slab_domain_leave(thread);
+        }
+        lookups += 64;
+        if (shared->mode == SLAB_DOMAIN_QSBR)
+            slab_domain_quiescent(thread);
+    }
+    if (shared->mode == SLAB_DOMAIN_QSBR)
+        slab_domain_offline(thread);
+    args->lookups = lookups;
+    args->torn = torn;
+    return 0;
+}
+
+// Fills a freshly allocated record; a reused record goes through a torn state.
+static Record* make_record(BenchShared* shared, uint64_t value) {
+    Record* record = (Record*)slab_domain_alloc(&shared->domain);
+    if (record == NULL)
+        return NULL;
+    record->check = 0;
+    record->value = value;
+    record->check = ~value;
+    return record;
+}
+
+// Replaces REPLACEMENTS random slots while READERS threads read the table.
+static void bench_reclaim(int mode, const char* label, LARGE_INTEGER frequency) {
+    Slab slab;
+    BenchShared* shared = (BenchShared*)_aligned_malloc(sizeof(BenchShared), 64);
+    if (shared == NULL || !slab_init(&slab, OBJECTS, HEADER_SIZE + sizeof(Record))) {
+        printf("%s: initialization failed.\n", label);
+        _aligned_free(shared);
+        return;
+    }
+    if (!slab_domain_init(&shared->domain, &slab, mode == MODE_IMMEDIATE ? SLAB_DOMAIN_EBR : mode, 0)) {
+        printf("%s: domain initialization failed.\n", label);
+        slab_destroy(&slab);
+        _aligned_free(shared);
+        return;
+    }
+    shared->mode = mode;
+    shared->stop = 0;
+    for (int i = 0; i < SLOTS; i++)
+        shared->slots[i] = make_record(shared, (uint64_t)i);
+
+    HANDLE handles[READERS];
+    ReaderArgs args[READERS];
+    for (int t = 0; t < READERS; t++) {
+        args[t].shared = shared;
+        args[t].seed = 777u * (t + 1);
+        handles[t] = CreateThread(NULL, 0, reader_main, &args[t], 0, NULL);
+    }
+
+    LARGE_INTEGER start, end;
+    size_t failed = 0;
+    unsigned seed = 4242;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < REPLACEMENTS; i++) {
+        seed = seed * 1103515245u + 12345u;
+        Record* record = make_record(shared, (uint64_t)i + SLOTS);
+        if (record == NULL) {
+            failed++;
+            slab_domain_barrier(&shared->domain);
+            continue;
+        }
+        Record* old = (Record*)InterlockedExchangePointer((PVOID volatile*)&shared->slots[(seed >> 8) % SLOTS], record);
+        if (mode == MODE_IMMEDIATE) {
+            slab_free(&slab, old);  // Single writer: nothing else frees; the readers may still hold `old`.
+        } else {
+            slab_retire(&shared->domain, old);
+        }
+    }
+    QueryPerformanceCounter(&end);
+    shared->stop = 1;
+    WaitForMultipleObjects(READERS, handles, TRUE, INFINITE);
+
+    size_t lookups = 0, torn = 0;
+    for (int t = 0; t < READERS; t++) {
+        CloseHandle(handles[t]);
+        lookups += args[t].lookups;
+        torn += args[t].torn;
+    }
+    double seconds = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    SlabDomainStats stats;
+    slab_domain_get_stats(&shared->domain, &stats);
+    printf("%s: %.6f seconds, %.2f replacements/sec, %.2f lookups/sec, %zu torn reads, %zu slab-full waits\n",
+           label, seconds, REPLACEMENTS / seconds, lookups / seconds, torn, failed);
+    if (mode != MODE_IMMEDIATE)
+        printf("%s: %zu epoch advances, %zu retired, %zu reclaimed, %zu pending\n", label, stats.advances,
+               stats.retired, stats.reclaimed, stats.pending);
+    slab_domain_destroy(&shared->domain);
+    slab_destroy(&slab);
+    _aligned_free(shared);
+}
+
+int main(void) {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    // Benchmark a read-mostly pointer table with concurrent replacement.
+    bench_reclaim(MODE_IMMEDIATE, "Immediate slab_free (unsafe)", frequency);
+    bench_reclaim(SLAB_DOMAIN_EBR, "EBR", frequency);
+    bench_reclaim(SLAB_DOMAIN_QSBR, "QSBR", frequency);
+    return 0;
+}
@@ -0,0 +1,418 @@
+// epoch_alloc.c
+
+#include "epoch_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Slab Lock and Retire List Helpers
+// -----------------------------------------------------------------------------
+
+/**
+ * acquire_slab_lock
+ * Spins on the domain's slab lock, yielding the time slice between attempts.
+ */
+static void acquire_slab_lock(volatile LONG* lock) {
+    while (InterlockedExchange(lock, 1) != 0)
+        Sleep(0);
+}
+
+/**
+ * release_slab_lock
+ * Releases the domain's slab lock.
+ */
+static void release_slab_lock(volatile LONG* lock) {
+    InterlockedExchange(lock, 0);
+}
+
+// retire_link: the retire list link in header bytes 16..23 of an object base.
+static inline unsigned char** retire_link(unsigned char* obj) {
+    return (unsigned char**)(obj + SLAB_DOMAIN_RETIRE_OFFSET);
+}
+
+/**
+ * return_batch
+ * Hands a retire list back to the slab. For a plain slab the list is relinked
+ * through the free-list word outside the lock and spliced onto the free list with
+ * two stores; page-indexed, periodically sorted and type-stable slabs (whose
+ * version words must advance) take slab_free per object.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @param head    First object base of the list (may be NULL).
+ * @return Number of objects returned.
+ */
+static size_t return_batch(SlabDomain* domain, unsigned char* head) {
+    if (head == NULL)
+        return 0;
+    Slab* slab = domain->slab;
+    size_t count = 0;
+    if (!(slab->flags & (SLAB_FLAG_PAGE_INDEX | SLAB_FLAG_TYPESAFE)) && slab->sort_period == 0) {
+        unsigned char* tail = head;
+        for (unsigned char* obj = head; obj != NULL; obj = *retire_link(obj)) {
+            *((unsigned char**)obj) = *retire_link(obj);
+            tail = obj;
+            count++;
+        }
+        acquire_slab_lock(&domain->slab_lock);
+        *((void**)tail) = slab->free_list;
+        slab->free_list = head;
+        release_slab_lock(&domain->slab_lock);
+    } else {
+        acquire_slab_lock(&domain->slab_lock);
+        for (unsigned char* obj = head; obj != NULL;) {
+            unsigned char* next = *retire_link(obj);
+            slab_free(slab, obj + HEADER_SIZE);
+            obj = next;
+            count++;
+        }
+        release_slab_lock(&domain->slab_lock);
+    }
+    InterlockedExchangeAdd64(&domain->reclaimed, (LONG64)count);
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+// Epoch Advance and Reclamation
+// -----------------------------------------------------------------------------
+
+/**
+ * try_advance
+ * Moves the global epoch from e to e + 1 if every registered thread is inactive
+ * or has announced e.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return 1 if the epoch moved (here or concurrently), 0 if a thread holds it back.
+ */
+static int try_advance(SlabDomain* domain) {
+    LONG64 epoch = domain->global_epoch;
+    LONG limit = domain->thread_limit;
+    for (LONG i = 0; i < limit; i++) {
+        LONG64 seen = domain->threads[i].epoch;
+        if (seen != 0 && seen != epoch)
+            return 0;
+    }
+    if (InterlockedCompareExchange64(&domain->global_epoch, epoch + 1, epoch) == epoch)
+        InterlockedIncrement64(&domain->advances);
+    return 1;
+}
+
+/**
+ * reclaim_orphans
+ * Returns the lists of exited threads once their newest epoch is two epochs old.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return Number of objects returned.
+ */
+static size_t reclaim_orphans(SlabDomain* domain) {
+    if (domain->orphans == NULL)
+        return 0;
+    unsigned char* orphans = NULL;
+    acquire_slab_lock(&domain->slab_lock);
+    if (domain->orphans != NULL && domain->orphan_epoch + 2 <= domain->global_epoch) {
+        orphans = domain->orphans;
+        domain->orphans = NULL;
+    }
+    release_slab_lock(&domain->slab_lock);
+    return return_batch(domain, orphans);
+}
+
+/**
+ * reclaim_thread
+ * Returns every list of the thread that was filled at least two epochs ago, then
+ * the orphans.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @param thread  Calling thread's record.
+ * @return Number of objects returned.
+ */
+static size_t reclaim_thread(SlabDomain* domain, SlabDomainThread* thread) {
+    LONG64 epoch = domain->global_epoch;
+    size_t count = 0;
+    for (int b = 0; b < 3; b++) {
+        if (thread->retired[b] != NULL && thread->retired_epoch[b] + 2 <= epoch) {
+            size_t returned = return_batch(domain, thread->retired[b]);
+            thread->retired[b] = NULL;
+            thread->pending -= returned;
+            count += returned;
+        }
+    }
+    return count + reclaim_orphans(domain);
+}
+
+/**
+ * domain_thread_exit
+ * FLS callback: takes the exiting thread out of the epoch, moves its pending lists
+ * to the domain's orphans and frees the record for the next thread.
+ */
+static void WINAPI domain_thread_exit(PVOID data) {
+    SlabDomainThread* thread = (SlabDomainThread*)data;
+    if (thread == NULL)
+        return;
+    SlabDomain* domain = thread->domain;
+    thread->epoch = 0;
+    acquire_slab_lock(&domain->slab_lock);
+    for (int b = 0; b < 3; b++) {
+        unsigned char* head = thread->retired[b];
+        if (head == NULL)
+            continue;
+        unsigned char* tail = head;
+        while (*retire_link(tail) != NULL)
+            tail = *retire_link(tail);
+        *retire_link(tail) = domain->orphans;
+        domain->orphans = head;
+        if (thread->retired_epoch[b] > domain->orphan_epoch)
+            domain->orphan_epoch = thread->retired_epoch[b];
+        thread->retired[b] = NULL;
+    }
+    release_slab_lock(&domain->slab_lock);
+    thread->pending = 0;
+    InterlockedExchange(&thread->in_use, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Domain Initialization and Thread Registration
+// -----------------------------------------------------------------------------
+
+/**
+ * slab_domain_init
+ * Allocates the cache-line aligned thread records and the FLS slot whose callback
+ * releases a record when its thread exits.
+ *
+ * @param domain  Pointer to a SlabDomain structure.
+ * @param slab    Initialized slab whose objects will be retired.
+ * @param mode    SLAB_DOMAIN_EBR or SLAB_DOMAIN_QSBR.
+ * @param batch   Pending objects per thread before an advance is attempted (0 for the default).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_domain_init(SlabDomain* domain, Slab* slab, int mode, size_t batch) {
+    if (!domain || !slab || slab->memory == NULL || (mode != SLAB_DOMAIN_EBR && mode != SLAB_DOMAIN_QSBR))
+        return 0;
+    if (slab->object_size < HEADER_SIZE)
+        return 0;
+    size_t bytes = SLAB_DOMAIN_MAX_THREADS * sizeof(SlabDomainThread);
+    domain->threads = (SlabDomainThread*)_aligned_malloc(bytes, 64);
+    if (domain->threads == NULL)
+        return 0;
+    memset(domain->threads, 0, bytes);
+    domain->fls_index = FlsAlloc(domain_thread_exit);
+    if (domain->fls_index == FLS_OUT_OF_INDEXES) {
+        _aligned_free(domain->threads);
+        domain->threads = NULL;
+        return 0;
+    }
+    for (size_t i = 0; i < SLAB_DOMAIN_MAX_THREADS; i++)
+        domain->threads[i].domain = domain;
+    domain->global_epoch = 1;
+    domain->slab = slab;
+    domain->mode = mode;
+    domain->batch = batch ? batch : SLAB_DOMAIN_DEFAULT_BATCH;
+    domain->thread_limit = 0;
+    domain->slab_lock = 0;
+    domain->orphans = NULL;
+    domain->orphan_epoch = 0;
+    domain->advances = 0;
+    domain->reclaimed = 0;
+    domain->retired_unregistered = 0;
+    return 1;
+}
+
+/**
+ * slab_domain_thread
+ * Looks the record up in FLS; on first use claims a free record, widens the scan
+ * bound before the record can announce an epoch, and stores it in FLS.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return The thread's record, or NULL if every record is taken.
+ */
+SlabDomainThread* slab_domain_thread(SlabDomain* domain) {
+    SlabDomainThread* thread = (SlabDomainThread*)FlsGetValue(domain->fls_index);
+    if (thread != NULL)
+        return thread;
+    for (LONG i = 0; i < SLAB_DOMAIN_MAX_THREADS; i++) {
+        if (domain->threads[i].in_use || InterlockedCompareExchange(&domain->threads[i].in_use, 1, 0) != 0)
+            continue;
+        thread = &domain->threads[i];
+        LONG limit = domain->thread_limit;
+        while (limit < i + 1) {
+            LONG seen = InterlockedCompareExchange(&domain->thread_limit, i + 1, limit);
+            if (seen == limit)
+                break;
+            limit = seen;
+        }
+        InterlockedExchange64(&thread->epoch, domain->mode == SLAB_DOMAIN_QSBR ? domain->global_epoch : 0);
+        if (!FlsSetValue(domain->fls_index, thread)) {
+            thread->epoch = 0;
+            InterlockedExchange(&thread->in_use, 0);
+            return NULL;
+        }
+        return thread;
+    }
+    return NULL;
+}
+
+/**
+ * slab_domain_offline
+ * QSBR: announces epoch 0, so advances no longer wait for this thread.
+ *
+ * @param thread  Calling thread's record.
+ */
+void slab_domain_offline(SlabDomainThread* thread) {
+    __asm__ __volatile__("" ::: "memory");
+    thread->epoch = 0;
+}
+
+/**
+ * slab_domain_online
+ * QSBR: announces the current epoch with a full barrier before any shared pointer
+ * is loaded.
+ *
+ * @param thread  Calling thread's record.
+ */
+void slab_domain_online(SlabDomainThread* thread) {
+    InterlockedExchange64(&thread->epoch, thread->domain->global_epoch);
+}
+
+// -----------------------------------------------------------------------------
+// Allocation, Retirement and Barrier
+// -----------------------------------------------------------------------------
+
+/**
+ * slab_domain_alloc
+ * slab_alloc under the slab lock shared with the batch frees.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return Object (offset by HEADER_SIZE), or NULL if the slab is exhausted.
+ */
+void* slab_domain_alloc(SlabDomain* domain) {
+    if (!domain)
+        return NULL;
+    acquire_slab_lock(&domain->slab_lock);
+    void* ptr = slab_alloc(domain->slab);
+    release_slab_lock(&domain->slab_lock);
+    return ptr;
+}
+
+/**
+ * slab_retire
+ * Pushes the object onto the list of the current epoch (mod 3). A list still
+ * tagged with an older epoch is at least three epochs old and is returned first.
+ * Once `batch` objects are pending, an advance is attempted and safe lists return.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @param ptr     Object from slab_domain_alloc.
+ */
+void slab_retire(SlabDomain* domain, void* ptr) {
+    if (!domain || ptr == NULL)
+        return;
+    unsigned char* obj = (unsigned char*)ptr - HEADER_SIZE;
+    SlabDomainThread* thread = slab_domain_thread(domain);
+    // The caller's unlink must be visible before the epoch is read, or a reader that
+    // starts in the next epoch could still find the object.
+    MemoryBarrier();
+    LONG64 epoch = domain->global_epoch;
+    if (thread == NULL) {
+        while (domain->global_epoch < epoch + 2) {
+            if (!try_advance(domain))
+                Sleep(0);
+        }
+        *retire_link(obj) = NULL;
+        InterlockedIncrement64(&domain->retired_unregistered);
+        return_batch(domain, obj);
+        return;
+    }
+
+    int b = (int)(epoch % 3);
+    if (thread->retired[b] != NULL && thread->retired_epoch[b] != epoch) {
+        thread->pending -= return_batch(domain, thread->retired[b]);
+        thread->retired[b] = NULL;
+    }
+    *retire_link(obj) = thread->retired[b];
+    thread->retired[b] = obj;
+    thread->retired_epoch[b] = epoch;
+    thread->pending++;
+    thread->retired_total++;
+    if (thread->pending >= domain->batch) {
+        try_advance(domain);
+        reclaim_thread(domain, thread);
+    }
+}
+
+/**
+ * slab_domain_barrier
+ * Drives the epoch two steps past its current value (marking a QSBR caller
+ * quiescent on every attempt), then reclaims the caller's lists and the orphans.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return Objects returned to the slab by this call.
+ */
+size_t slab_domain_barrier(SlabDomain* domain) {
+    if (!domain)
+        return 0;
+    SlabDomainThread* thread = slab_domain_thread(domain);
+    MemoryBarrier();
+    LONG64 target = domain->global_epoch + 2;
+    while (domain->global_epoch < target) {
+        if (thread != NULL && domain->mode == SLAB_DOMAIN_QSBR)
+            slab_domain_quiescent(thread);
+        if (!try_advance(domain))
+            Sleep(0);
+    }
+    return thread != NULL ? reclaim_thread(domain, thread) : reclaim_orphans(domain);
+}
+
+// -----------------------------------------------------------------------------
+// Statistics and Destroy
+// -----------------------------------------------------------------------------
+
+/**
+ * slab_domain_get_stats
+ * Sums the per-record counters; the snapshot is not atomic while threads run.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @param stats   Receives the statistics.
+ */
+void slab_domain_get_stats(SlabDomain* domain, SlabDomainStats* stats) {
+    if (!domain || !stats)
+        return;
+    memset(stats, 0, sizeof(*stats));
+    stats->epoch = (size_t)domain->global_epoch;
+    stats->advances = (size_t)domain->advances;
+    stats->retired = (size_t)domain->retired_unregistered;
+    LONG limit = domain->thread_limit;
+    for (LONG i = 0; i < limit; i++) {
+        stats->retired += domain->threads[i].retired_total;
+        if (domain->threads[i].in_use)
+            stats->threads++;
+    }
+    stats->reclaimed = (size_t)domain->reclaimed;
+    stats->pending = stats->retired > stats->reclaimed ? stats->retired - stats->reclaimed : 0;
+}
+
+/**
+ * slab_domain_destroy
+ * Frees the FLS slot, returns every list still held by a record or orphaned, and
+ * releases the records.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ */
+void slab_domain_destroy(SlabDomain* domain) {
+    if (!domain || domain->threads == NULL)
+        return;
+    FlsFree(domain->fls_index);
+    domain->fls_index = FLS_OUT_OF_INDEXES;
+    LONG limit = domain->thread_limit;
+    for (LONG i = 0; i < limit; i++) {
+        SlabDomainThread* thread = &domain->threads[i];
+        for (int b = 0; b < 3; b++) {
+            return_batch(domain, thread->retired[b]);
+            thread->retired[b] = NULL;
+        }
+        thread->pending = 0;
+    }
+    return_batch(domain, domain->orphans);
+    domain->orphans = NULL;
+    _aligned_free(domain->threads);
+    domain->threads = NULL;
+    domain->thread_limit = 0;
+    domain->slab = NULL;
+}
@@ -0,0 +1,208 @@
+// epoch_alloc.h
+
+#ifndef EPOCH_ALLOC_H
+#define EPOCH_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <windows.h>
+#include "slab_alloc.h"
+
+// Deferred reclamation for lock-free structures built on a Slab. An object unlinked
+// from a shared structure may still be read by concurrent readers, so instead of
+// slab_free it is passed to slab_retire, which queues it on the calling thread's
+// retire list (linked through header bytes 16..23 of the object, so no memory is
+// allocated). A global epoch advances once every registered thread has been seen in
+// the current epoch; objects retired in epoch e go back to the slab free list, one
+// batch per list, once the epoch reaches e + 2.
+//
+// Two reader protocols are supported per domain:
+//   SLAB_DOMAIN_EBR   Readers bracket each access with slab_domain_enter/leave and
+//                     are invisible to the epoch outside those sections.
+//   SLAB_DOMAIN_QSBR  Registered threads are always considered readers and report
+//                     quiescent points with slab_domain_quiescent (one plain store),
+//                     or leave with slab_domain_offline while they block.
+//
+// The slab itself is not thread-safe: every allocation must go through
+// slab_domain_alloc, which shares a spin lock with the batch frees.
+
+#define SLAB_DOMAIN_EBR   0
+#define SLAB_DOMAIN_QSBR  1
+
+#define SLAB_DOMAIN_MAX_THREADS    64   // Threads registered with one domain at the same time.
+#define SLAB_DOMAIN_DEFAULT_BATCH  64   // Retired objects per thread before an advance is attempted.
+#define SLAB_DOMAIN_RETIRE_OFFSET  16   // Header offset of the retire link.
+
+struct SlabDomain;
+
+// SlabDomainThread: one registered thread, alone on its cache line(s). `epoch` is
+// the only field other threads read; 0 means the thread does not hold references.
+typedef struct SlabDomainThread {
+    volatile LONG64 epoch;       // Epoch announced by the thread (0: inactive/offline).
+    struct SlabDomain* domain;   // Owning domain.
+    volatile LONG in_use;        // Nonzero while a thread owns this record.
+    LONG reserved;
+    unsigned char* retired[3];   // Retire lists (object bases), one per epoch modulo 3.
+    LONG64 retired_epoch[3];     // Epoch in which each list was filled.
+    size_t pending;              // Objects on the three lists.
+    size_t retired_total;        // Objects retired by this record since init.
+} __attribute__((aligned(64))) SlabDomainThread;
+
+// SlabDomain structure: epoch state and thread records bound to one Slab.
+typedef struct SlabDomain {
+    volatile LONG64 global_epoch __attribute__((aligned(64)));  // Starts at 1; 0 is never announced.
+    Slab* slab;                  // Slab the retired objects return to.
+    int mode;                    // SLAB_DOMAIN_EBR or SLAB_DOMAIN_QSBR.
+    size_t batch;                // Pending objects per thread that trigger an advance attempt.
+    DWORD fls_index;             // FLS slot holding the calling thread's record.
+    SlabDomainThread* threads;   // SLAB_DOMAIN_MAX_THREADS records.
+    volatile LONG thread_limit;  // Records ever used (scan bound for advances).
+    volatile LONG slab_lock;     // Spin lock around slab_alloc and batch frees.
+    unsigned char* orphans;      // Retire lists left by exited threads (under slab_lock).
+    LONG64 orphan_epoch;         // Newest epoch among the orphans.
+    volatile LONG64 advances;    // Successful epoch advances.
+    volatile LONG64 reclaimed;   // Objects handed back to the slab.
+    volatile LONG64 retired_unregistered;  // Objects retired by threads that found no free record.
+} SlabDomain;
+
+// SlabDomainStats: snapshot returned by slab_domain_get_stats.
+typedef struct SlabDomainStats {
+    size_t epoch;                // Current global epoch.
+    size_t advances;             // Epoch advances since init.
+    size_t retired;              // Objects passed to slab_retire.
+    size_t reclaimed;            // Objects returned to the slab.
+    size_t pending;              // Retired objects still waiting (retired - reclaimed).
+    size_t threads;              // Records currently registered.
+} SlabDomainStats;
+
+/**
+ * slab_domain_init
+ * Binds a reclamation domain to a slab.
+ *
+ * @param domain  Pointer to a SlabDomain structure.
+ * @param slab    Initialized slab whose objects will be retired.
+ * @param mode    SLAB_DOMAIN_EBR or SLAB_DOMAIN_QSBR.
+ * @param batch   Pending objects per thread before an advance is attempted (0 for the default).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_domain_init(SlabDomain* domain, Slab* slab, int mode, size_t batch);
+
+/**
+ * slab_domain_thread
+ * Returns the calling thread's record, registering the thread on first use. In
+ * QSBR mode a newly registered thread is online. The record is released when the
+ * thread exits; its pending objects are then reclaimed by the other threads.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return The thread's record, or NULL if SLAB_DOMAIN_MAX_THREADS threads are registered.
+ */
+SlabDomainThread* slab_domain_thread(SlabDomain* domain);
+
+/**
+ * slab_domain_enter
+ * EBR: starts a read-side section. Pointers loaded from the shared structure stay
+ * valid until slab_domain_leave. Sections do not nest.
+ *
+ * @param thread  Calling thread's record.
+ */
+static inline void slab_domain_enter(SlabDomainThread* thread) {
+    // The exchange is a full barrier: the announcement is visible before any load
+    // of a shared pointer.
+    InterlockedExchange64(&thread->epoch, thread->domain->global_epoch);
+}
+
+/**
+ * slab_domain_leave
+ * EBR: ends a read-side section.
+ *
+ * @param thread  Calling thread's record.
+ */
+static inline void slab_domain_leave(SlabDomainThread* thread) {
+    // x86 does not reorder a store with earlier loads; only the compiler must be held back.
+    __asm__ __volatile__("" ::: "memory");
+    thread->epoch = 0;
+}
+
+/**
+ * slab_domain_quiescent
+ * QSBR: reports that the calling thread holds no pointer into the structure.
+ *
+ * @param thread  Calling thread's record.
+ */
+static inline void slab_domain_quiescent(SlabDomainThread* thread) {
+    __asm__ __volatile__("" ::: "memory");
+    thread->epoch = thread->domain->global_epoch;
+}
+
+/**
+ * slab_domain_offline / slab_domain_online
+ * QSBR: stops the thread from holding epochs back while it blocks or idles, and
+ * makes it a reader again afterwards.
+ *
+ * @param thread  Calling thread's record.
+ */
+void slab_domain_offline(SlabDomainThread* thread);
+void slab_domain_online(SlabDomainThread* thread);
+
+/**
+ * slab_domain_alloc
+ * Allocates an object from the domain's slab under the domain's slab lock.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return Object (offset by HEADER_SIZE), or NULL if the slab is exhausted.
+ */
+void* slab_domain_alloc(SlabDomain* domain);
+
+/**
+ * slab_retire
+ * Queues an object that has been unlinked from every shared structure. It returns
+ * to the slab once no reader can still hold it. While `batch` or more objects are
+ * pending, each call tries to advance the epoch and frees the lists that became safe.
+ * The object's data is left untouched until then. A thread that cannot register
+ * (all SLAB_DOMAIN_MAX_THREADS records taken) waits for two epoch advances and
+ * frees the object itself.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @param ptr     Object from slab_domain_alloc.
+ */
+void slab_retire(SlabDomain* domain, void* ptr);
+
+/**
+ * slab_domain_barrier
+ * Waits until every object retired before the call (by any thread, including
+ * exited ones) can be reclaimed, and reclaims the calling thread's lists and the
+ * orphans. In EBR mode the caller must not be inside a read-side section; in QSBR
+ * mode the caller is treated as quiescent.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @return Objects returned to the slab by this call.
+ */
+size_t slab_domain_barrier(SlabDomain* domain);
+
+/**
+ * slab_domain_get_stats
+ * Reports the epoch and the retire/reclaim counters.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ * @param stats   Receives the statistics.
+ */
+void slab_domain_get_stats(SlabDomain* domain, SlabDomainStats* stats);
+
+/**
+ * slab_domain_destroy
+ * Returns every pending object to the slab and releases the thread records. No
+ * thread may use the domain any more; the slab itself is left alive.
+ *
+ * @param domain  Pointer to the SlabDomain structure.
+ */
+void slab_domain_destroy(SlabDomain* domain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EPOCH_ALLOC_H
@@ -0,0 +1,153 @@
+// iobuf_alloc.c
+
+#include "iobuf_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Pool Initialization and Destroy Functions
+// -----------------------------------------------------------------------------
+
+/**
+ * iobuf_pool_init
+ * Rounds the buffer size to the alignment and builds the backing slab with the
+ * matching SLAB_FLAG_* options. The slab mapping is at least 64K-aligned, and
+ * 2MB-aligned in IOBUF_ALIGN_2MB mode, so every object base is aligned as well.
+ *
+ * @param pool          Pointer to an IoBufPool structure.
+ * @param buffer_count  Number of buffers.
+ * @param buffer_size   Requested size of each buffer in bytes.
+ * @param flags         IOBUF_* flags.
+ * @return 1 on success, 0 on failure.
+ */
+int iobuf_pool_init(IoBufPool* pool, size_t buffer_count, size_t buffer_size, int flags) {
+    if (!pool || buffer_count == 0 || buffer_size == 0)
+        return 0;
+    pool->alignment = (flags & IOBUF_ALIGN_2MB) ? SLAB_ALIGN_2MB : IOBUF_PAGE_SIZE;
+    pool->buffer_size = (buffer_size + pool->alignment - 1) & ~(pool->alignment - 1);
+    if (pool->buffer_size > 0xFFFFFFFFu)
+        return 0;  // IoBufInfo carries 32-bit lengths.
+    pool->buffer_count = buffer_count;
+    pool->in_use = 0;
+    pool->flags = flags;
+
+    int slab_flags = 0;
+    if (flags & IOBUF_ALIGN_2MB)
+        slab_flags |= SLAB_FLAG_ALIGN_2MB;
+    if (flags & IOBUF_LOCKED)
+        slab_flags |= SLAB_FLAG_LOCKED;
+    if (!slab_init_ex(&pool->slab, buffer_count, pool->buffer_size, slab_flags))
+        return 0;
+    InitializeCriticalSection(&pool->lock);
+    return 1;
+}
+
+/**
+ * iobuf_pool_destroy
+ * Destroys the backing slab (which unlocks it) and the lock.
+ *
+ * @param pool  Pointer to the IoBufPool structure.
+ */
+void iobuf_pool_destroy(IoBufPool* pool) {
+    if (!pool || pool->slab.memory == NULL)
+        return;
+    slab_destroy(&pool->slab);
+    DeleteCriticalSection(&pool->lock);
+    pool->buffer_count = 0;
+    pool->in_use = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Buffer Allocation, Free, and Index Functions
+// -----------------------------------------------------------------------------
+
+/**
+ * iobuf_alloc
+ * Pops a slab object under the pool lock and returns its base.
+ *
+ * @param pool   Pointer to the IoBufPool structure.
+ * @param index  Receives the stable buffer index (may be NULL).
+ * @return Aligned buffer, or NULL if every buffer is in use.
+ */
+void* iobuf_alloc(IoBufPool* pool, size_t* index) {
+    if (!pool)
+        return NULL;
+    EnterCriticalSection(&pool->lock);
+    unsigned char* obj = (unsigned char*)slab_alloc(&pool->slab);
+    if (obj != NULL)
+        pool->in_use++;
+    LeaveCriticalSection(&pool->lock);
+    if (obj == NULL)
+        return NULL;
+    obj -= HEADER_SIZE;
+    if (index)
+        *index = (size_t)(obj - pool->slab.memory) / pool->buffer_size;
+    return obj;
+}
+
+/**
+ * iobuf_free
+ * Pushes the buffer's object back onto the slab free list.
+ *
+ * @param pool    Pointer to the IoBufPool structure.
+ * @param buffer  Buffer returned by iobuf_alloc or iobuf_from_index.
+ */
+void iobuf_free(IoBufPool* pool, void* buffer) {
+    if (!pool || buffer == NULL)
+        return;
+    EnterCriticalSection(&pool->lock);
+    slab_free(&pool->slab, (unsigned char*)buffer + HEADER_SIZE);
+    pool->in_use--;
+    LeaveCriticalSection(&pool->lock);
+}
+
+/**
+ * iobuf_index
+ * Converts a buffer address to its index.
+ *
+ * @param pool    Pointer to the IoBufPool structure.
+ * @param buffer  Buffer belonging to the pool.
+ * @return Index in [0, buffer_count), or IOBUF_INVALID_INDEX.
+ */
+size_t iobuf_index(IoBufPool* pool, const void* buffer) {
+    if (!pool || (const unsigned char*)buffer < pool->slab.memory)
+        return IOBUF_INVALID_INDEX;
+    size_t offset = (size_t)((const unsigned char*)buffer - pool->slab.memory);
+    if (offset % pool->buffer_size != 0 || offset / pool->buffer_size >= pool->buffer_count)
+        return IOBUF_INVALID_INDEX;
+    return offset / pool->buffer_size;
+}
+
+/**
+ * iobuf_from_index
+ * Converts an index to the buffer address.
+ *
+ * @param pool   Pointer to the IoBufPool structure.
+ * @param index  Buffer index.
+ * @return Buffer address, or NULL if the index is out of range.
+ */
+void* iobuf_from_index(IoBufPool* pool, size_t index) {
+    if (!pool || index >= pool->buffer_count)
+        return NULL;
+    return pool->slab.memory + index * pool->buffer_size;
+}
+
+/**
+ * iobuf_register_info
+ * Writes address/length pairs for buffers 0..count-1.
+ *
+ * @param pool   Pointer to the IoBufPool structure.
+ * @param info   Output array.
+ * @param count  Capacity of the output array.
+ * @return Number of entries written.
+ */
+size_t iobuf_register_info(IoBufPool* pool, IoBufInfo* info, size_t count) {
+    if (!pool || !info)
+        return 0;
+    size_t n = count < pool->buffer_count ? count : pool->buffer_count;
+    for (size_t i = 0; i < n; i++) {
+        info[i].address = pool->slab.memory + i * pool->buffer_size;
+        info[i].length = (UINT32)pool->buffer_size;
+    }
+    return n;
+}
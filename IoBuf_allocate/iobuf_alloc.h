@@ -0,0 +1,121 @@
+// iobuf_alloc.h
+
+#ifndef IOBUF_ALLOC_H
+#define IOBUF_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <windows.h>
+#include "slab_alloc.h"
+
+// IoBufPool flags (passed to iobuf_pool_init).
+#define IOBUF_ALIGN_4K   0x0  // Buffers are 4K-aligned, sizes rounded to 4K.
+#define IOBUF_ALIGN_2MB  0x1  // Buffers are 2MB-aligned, sizes rounded to 2MB.
+#define IOBUF_LOCKED     0x2  // Prefault and lock every buffer in physical memory.
+
+#define IOBUF_PAGE_SIZE  4096
+#define IOBUF_INVALID_INDEX ((size_t)-1)
+
+// IoBufInfo structure: one registered buffer, laid out like IORING_BUFFER_INFO so an
+// array can be passed to BuildIoRingRegisterBuffers (or translated to iovecs).
+typedef struct IoBufInfo {
+    void* address;               // Start of the buffer.
+    UINT32 length;               // Buffer size in bytes.
+} IoBufInfo;
+
+// IoBufPool structure: fixed-size, page-aligned I/O buffers carved from one Slab.
+// Each buffer is a whole slab object. The slab keeps its free-list link in the first
+// bytes of an object only while it is free, so an allocated buffer starts at the
+// object base (ptr - HEADER_SIZE) and keeps the full alignment of the mapping.
+// A buffer's index, (buffer - memory) / buffer_size, never changes for the life of
+// the pool, which makes it usable as a registered (fixed) buffer index.
+typedef struct IoBufPool {
+    Slab slab;                   // Backing slab; object_size == buffer_size.
+    size_t buffer_size;          // Size of every buffer (multiple of the alignment).
+    size_t buffer_count;         // Number of buffers.
+    size_t alignment;            // IOBUF_PAGE_SIZE or SLAB_ALIGN_2MB.
+    size_t in_use;               // Buffers currently handed out.
+    int flags;                   // IOBUF_* flags.
+    CRITICAL_SECTION lock;       // Serializes slab_alloc/slab_free across I/O threads.
+} IoBufPool;
+
+/**
+ * iobuf_pool_init
+ * Creates buffer_count buffers of buffer_size bytes (rounded up to the alignment).
+ *
+ * @param pool          Pointer to an IoBufPool structure.
+ * @param buffer_count  Number of buffers.
+ * @param buffer_size   Requested size of each buffer in bytes.
+ * @param flags         IOBUF_ALIGN_4K or IOBUF_ALIGN_2MB, optionally | IOBUF_LOCKED.
+ * @return 1 on success, 0 on failure.
+ */
+int iobuf_pool_init(IoBufPool* pool, size_t buffer_count, size_t buffer_size, int flags);
+
+/**
+ * iobuf_alloc
+ * Takes a free buffer.
+ *
+ * @param pool   Pointer to the IoBufPool structure.
+ * @param index  Receives the stable buffer index (may be NULL).
+ * @return Aligned buffer, or NULL if every buffer is in use.
+ */
+void* iobuf_alloc(IoBufPool* pool, size_t* index);
+
+/**
+ * iobuf_free
+ * Returns a buffer to the pool.
+ *
+ * @param pool    Pointer to the IoBufPool structure.
+ * @param buffer  Buffer returned by iobuf_alloc or iobuf_from_index.
+ */
+void iobuf_free(IoBufPool* pool, void* buffer);
+
+/**
+ * iobuf_index
+ * Returns the stable index of a buffer.
+ *
+ * @param pool    Pointer to the IoBufPool structure.
+ * @param buffer  Buffer belonging to the pool.
+ * @return Index in [0, buffer_count), or IOBUF_INVALID_INDEX.
+ */
+size_t iobuf_index(IoBufPool* pool, const void* buffer);
+
+/**
+ * iobuf_from_index
+ * Returns the buffer with the given index (whether or not it is allocated).
+ *
+ * @param pool   Pointer to the IoBufPool structure.
+ * @param index  Buffer index.
+ * @return Buffer address, or NULL if the index is out of range.
+ */
+void* iobuf_from_index(IoBufPool* pool, size_t index);
+
+/**
+ * iobuf_register_info
+ * Fills `info` with every buffer in index order, ready for fixed-buffer
+ * registration with an I/O ring.
+ *
+ * @param pool   Pointer to the IoBufPool structure.
+ * @param info   Output array.
+ * @param count  Capacity of the output array.
+ * @return Number of entries written.
+ */
+size_t iobuf_register_info(IoBufPool* pool, IoBufInfo* info, size_t count);
+
+/**
+ * iobuf_pool_destroy
+ * Unlocks (if locked) and releases all buffers.
+ *
+ * @param pool  Pointer to the IoBufPool structure.
+ */
+void iobuf_pool_destroy(IoBufPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IOBUF_ALLOC_H
@@ -0,0 +1,109 @@
+// bench_new.cpp
+//
+// Build once as is (default operator new) and once with -DUSE_NEW_ALLOC linked
+// against new_alloc.o (replacement operator new/delete) and compare the timings.
+
+#include <stdio.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <windows.h>
+#ifdef USE_NEW_ALLOC
+#include "new_alloc.hpp"
+#endif
+
+#define ELEMENTS 200000  // Elements per container.
+#define ROUNDS   5       // Fill/drain rounds per workload.
+
+static double seconds_since(LARGE_INTEGER start, LARGE_INTEGER frequency) {
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&end);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// std::map<int, std::string>: one node plus one heap string (> SSO) per insert.
+static size_t bench_map() {
+    size_t checksum = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        std::map<int, std::string> map;
+        for (int i = 0; i < ELEMENTS; i++)
+            map.emplace((i * 7919) % ELEMENTS, std::string(40, (char)('a' + i % 26)));
+        for (int i = 0; i < ELEMENTS; i += 2)
+            map.erase(i);
+        checksum += map.size();
+    }
+    return checksum;
+}
+
+// std::unordered_map<std::string, int>: nodes, keys and a growing bucket array.
+static size_t bench_unordered_map() {
+    size_t checksum = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        std::unordered_map<std::string, int> map;
+        for (int i = 0; i < ELEMENTS; i++)
+            map["key-with-a-long-prefix-" + std::to_string(i)] = i;
+        for (int i = 0; i < ELEMENTS; i += 3)
+            map.erase("key-with-a-long-prefix-" + std::to_string(i));
+        checksum += map.size();
+    }
+    return checksum;
+}
+
+// std::vector<std::unique_ptr<...>> and std::list: many small objects, freed in bulk.
+static size_t bench_small_objects() {
+    struct Item {
+        int id;
+        double weight;
+    };
+    size_t checksum = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        std::vector<std::unique_ptr<Item>> items;
+        std::list<int> list;
+        for (int i = 0; i < ELEMENTS; i++) {
+            items.push_back(std::make_unique<Item>(Item{ i, i * 0.5 }));
+            list.push_back(i);
+        }
+        for (const auto& item : items)
+            checksum += (size_t)item->id;
+        checksum += list.size();
+    }
+    return checksum;
+}
+
+int main() {
+    LARGE_INTEGER frequency, start;
+    QueryPerformanceFrequency(&frequency);
+#ifdef USE_NEW_ALLOC
+    const char* label = "new_alloc";
+#else
+    const char* label = "default new";
+#endif
+
+    // Benchmark STL-heavy workloads with the operator new the binary was linked with.
+    QueryPerformanceCounter(&start);
+    size_t checksum = bench_map();
+    printf("%s, std::map<int, std::string> x %d: %.6f seconds (checksum %zu)\n", label, ROUNDS,
+           seconds_since(start, frequency), checksum);
+    QueryPerformanceCounter(&start);
+    checksum = bench_unordered_map();
+    printf("%s, std::unordered_map<std::string, int> x %d: %.6f seconds (checksum %zu)\n", label, ROUNDS,
+           seconds_since(start, frequency), checksum);
+    QueryPerformanceCounter(&start);
+    checksum = bench_small_objects();
+    printf("%s, unique_ptr vector + std::list x %d: %.6f seconds (checksum %zu)\n", label, ROUNDS,
+           seconds_since(start, frequency), checksum);
+
+#ifdef USE_NEW_ALLOC
+    allocates::NewAllocStats stats;
+    allocates::new_alloc_get_stats(&stats);
+    size_t chunks = 0;
+    for (size_t i = 0; i < allocates::NEW_CLASS_COUNT; i++)
+        chunks += stats.class_chunks[i];
+    printf("new_alloc: %zu slab chunks, %zu refills, %zu flushes, %zu pool allocations\n", chunks,
+           stats.refills, stats.flushes, stats.pool_allocs);
+#endif
+    return 0;
+}
@@ -0,0 +1,429 @@
+// new_alloc.cpp
+
+#include "new_alloc.hpp"
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <windows.h>
+#include "slab_alloc.h"
+#include "pool_alloc.h"
+
+namespace allocates {
+namespace {
+
+// ---------------------------------------------------------------------------
+// Size Classes
+// ---------------------------------------------------------------------------
+
+#define NEW_CHUNK_SHIFT 21           // log2(NEW_CHUNK_BYTES).
+#define NEW_MAP_TOP     (1 << 15)    // Top-level map entries (47-bit addresses, 4GB each).
+#define NEW_MAP_LEAF    (1 << 11)    // 2MB regions per 4GB.
+
+// SizeClass: the Slab chunks of one class, shared by all threads.
+struct SizeClass {
+    Slab** chunks;                   // Chunks in creation order (malloc'd array).
+    std::size_t chunk_count;         // Chunks mapped for this class.
+    std::size_t chunk_capacity;      // Entries in chunks.
+    std::size_t current;             // Chunk refills take objects from first.
+};
+
+SizeClass classes[NEW_CLASS_COUNT];
+Slab** chunk_map[NEW_MAP_TOP];       // 2MB region -> owning chunk (NULL: not a Slab chunk).
+volatile LONG classes_lock = 0;      // Guards classes, chunk_map leaves and the counters.
+std::size_t refills = 0;
+std::size_t flushes = 0;
+
+Pool large_pool;                     // Large and over-aligned requests.
+volatile LONG large_pool_state = 0;  // 0: uninitialized, 1: initializing, 2: ready, 3: failed.
+volatile LONG64 pool_allocs = 0;
+
+void lock_classes() {
+    while (InterlockedExchange(&classes_lock, 1) != 0)
+        Sleep(0);
+}
+
+void unlock_classes() {
+    InterlockedExchange(&classes_lock, 0);
+}
+
+/**
+ * class_index
+ * Maps a request size (1..NEW_MAX_SMALL) to its class.
+ */
+inline std::size_t class_index(std::size_t size) {
+    if (size <= 256)
+        return size == 0 ? 0 : (size - 1) >> 4;
+    std::size_t index = 16;
+    while ((std::size_t)512 << (index - 16) < size)
+        index++;
+    return index;
+}
+
+inline std::size_t class_size(std::size_t index) {
+    return index < 16 ? (index + 1) << 4 : (std::size_t)512 << (index - 16);
+}
+
+/**
+ * chunk_of
+ * Looks up the Slab chunk that owns an address, without locking. Leaves are only
+ * ever added, and a chunk is entered before any of its objects is handed out.
+ *
+ * @return Owning chunk, or NULL for memory that did not come from a size class.
+ */
+inline Slab* chunk_of(const void* ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+    Slab** leaf = chunk_map[(address >> 32) & (NEW_MAP_TOP - 1)];
+    if (leaf == NULL)
+        return NULL;
+    return leaf[(address >> NEW_CHUNK_SHIFT) & (NEW_MAP_LEAF - 1)];
+}
+
+/**
+ * add_chunk
+ * Maps a 2MB-aligned Slab chunk for a class and enters it in the chunk map.
+ * Called with classes_lock held.
+ *
+ * @return The new chunk, or NULL on failure.
+ */
+Slab* add_chunk(std::size_t index) {
+    SizeClass* size_class = &classes[index];
+    if (size_class->chunk_count == size_class->chunk_capacity) {
+        std::size_t capacity = size_class->chunk_capacity ? size_class->chunk_capacity * 2 : 16;
+        Slab** chunks = static_cast<Slab**>(realloc(size_class->chunks, capacity * sizeof(Slab*)));
+        if (chunks == NULL)
+            return NULL;
+        size_class->chunks = chunks;
+        size_class->chunk_capacity = capacity;
+    }
+    std::size_t object_size = class_size(index) + HEADER_SIZE;
+    Slab* chunk = static_cast<Slab*>(malloc(sizeof(Slab)));
+    if (chunk == NULL || !slab_init_ex(chunk, NEW_CHUNK_BYTES / object_size, object_size, SLAB_FLAG_ALIGN_2MB)) {
+        free(chunk);
+        return NULL;
+    }
+    // Preallocates the sort scratch and counts frees, so refills can tell which
+    // chunks need a sort and sorting never allocates under classes_lock.
+    if (!slab_set_sort_period(chunk, chunk->total_objects)) {
+        slab_destroy(chunk);
+        free(chunk);
+        return NULL;
+    }
+    uintptr_t address = (uintptr_t)chunk->memory;
+    Slab**& leaf = chunk_map[(address >> 32) & (NEW_MAP_TOP - 1)];
+    if (leaf == NULL)
+        leaf = static_cast<Slab**>(calloc(NEW_MAP_LEAF, sizeof(Slab*)));
+    if (leaf == NULL) {
+        slab_destroy(chunk);
+        free(chunk);
+        return NULL;
+    }
+    leaf[(address >> NEW_CHUNK_SHIFT) & (NEW_MAP_LEAF - 1)] = chunk;
+    size_class->current = size_class->chunk_count;
+    size_class->chunks[size_class->chunk_count++] = chunk;
+    return chunk;
+}
+
+/**
+ * refill_objects
+ * Takes up to `count` objects of a class, starting with the current chunk, trying
+ * every other chunk when it runs dry, and mapping a new chunk only when all of them
+ * are exhausted. Full chunks are passed over. A chunk that has taken frees since its
+ * last sort is sorted by address when refills move to it, so objects freed in random
+ * order are handed out in address order again.
+ *
+ * @return Number of objects stored in `objects`.
+ */
+std::size_t refill_objects(std::size_t index, void** objects, std::size_t count) {
+    SizeClass* size_class = &classes[index];
+    std::size_t taken = 0;
+    std::size_t tried = 0;
+    lock_classes();
+    refills++;
+    while (taken < count) {
+        void* object = NULL;
+        if (size_class->chunk_count != 0)
+            object = slab_alloc(size_class->chunks[size_class->current]);
+        if (object != NULL) {
+            objects[taken++] = object;
+            continue;
+        }
+        if (tried < size_class->chunk_count) {
+            size_class->current = (size_class->current + 1) % size_class->chunk_count;
+            Slab* chunk = size_class->chunks[size_class->current];
+            if (chunk->free_list != NULL && chunk->frees_since_sort != 0)
+                slab_sort_free(chunk);
+            tried++;
+        } else if (add_chunk(index) == NULL) {
+            break;
+        }
+    }
+    unlock_classes();
+    return taken;
+}
+
+/**
+ * flush_objects
+ * Returns objects to the chunks that own them (found through the chunk map).
+ */
+void flush_objects(void* const* objects, std::size_t count) {
+    lock_classes();
+    flushes++;
+    for (std::size_t i = 0; i < count; i++)
+        slab_free(chunk_of(objects[i]), objects[i]);
+    unlock_classes();
+}
+
+// ---------------------------------------------------------------------------
+// Thread Caches
+// ---------------------------------------------------------------------------
+
+// ThreadCache: free objects per class owned by one thread.
+struct ThreadCache {
+    void* objects[NEW_CLASS_COUNT][NEW_CACHE_OBJECTS];
+    std::size_t count[NEW_CLASS_COUNT];
+};
+
+volatile LONG cache_index_state = 0;  // 0: not created, 1: creating, 2: ready.
+DWORD cache_index = FLS_OUT_OF_INDEXES;
+
+/**
+ * cache_thread_exit
+ * FLS callback: flushes a thread's cache when the thread exits.
+ */
+void WINAPI cache_thread_exit(void* data) {
+    ThreadCache* cache = static_cast<ThreadCache*>(data);
+    if (cache == NULL)
+        return;
+    for (std::size_t index = 0; index < NEW_CLASS_COUNT; index++) {
+        if (cache->count[index] != 0)
+            flush_objects(cache->objects[index], cache->count[index]);
+    }
+    free(cache);
+}
+
+/**
+ * thread_cache
+ * Returns the calling thread's cache, creating the FLS slot and the cache on first
+ * use (malloc, never operator new).
+ *
+ * @return The cache, or NULL if neither could be created.
+ */
+ThreadCache* thread_cache() {
+    if (cache_index_state != 2) {
+        if (InterlockedCompareExchange(&cache_index_state, 1, 0) == 0) {
+            cache_index = FlsAlloc(cache_thread_exit);
+            InterlockedExchange(&cache_index_state, 2);
+        } else {
+            while (cache_index_state != 2)
+                Sleep(0);
+        }
+    }
+    if (cache_index == FLS_OUT_OF_INDEXES)
+        return NULL;
+    ThreadCache* cache = static_cast<ThreadCache*>(FlsGetValue(cache_index));
+    if (cache == NULL) {
+        cache = static_cast<ThreadCache*>(calloc(1, sizeof(ThreadCache)));
+        if (cache != NULL && !FlsSetValue(cache_index, cache)) {
+            free(cache);
+            cache = NULL;
+        }
+    }
+    return cache;
+}
+
+/**
+ * small_alloc
+ * Pops an object of the class from the thread cache (refilling it when empty).
+ *
+ * @return Object, or NULL when no chunk can be mapped.
+ */
+void* small_alloc(std::size_t size) {
+    std::size_t index = class_index(size);
+    ThreadCache* cache = thread_cache();
+    if (cache == NULL) {
+        void* object = NULL;
+        return refill_objects(index, &object, 1) ? object : NULL;
+    }
+    if (cache->count[index] == 0)
+        cache->count[index] = refill_objects(index, cache->objects[index], NEW_CACHE_BATCH);
+    return cache->count[index] ? cache->objects[index][--cache->count[index]] : NULL;
+}
+
+/**
+ * small_free
+ * Pushes an object on the thread cache of its class, flushing the oldest
+ * NEW_CACHE_BATCH objects when the cache is full.
+ */
+void small_free(void* ptr, std::size_t index) {
+    ThreadCache* cache = thread_cache();
+    if (cache == NULL) {
+        flush_objects(&ptr, 1);
+        return;
+    }
+    if (cache->count[index] == NEW_CACHE_OBJECTS) {
+        flush_objects(cache->objects[index], NEW_CACHE_BATCH);
+        cache->count[index] -= NEW_CACHE_BATCH;
+        for (std::size_t i = 0; i < cache->count[index]; i++)
+            cache->objects[index][i] = cache->objects[index][i + NEW_CACHE_BATCH];
+    }
+    cache->objects[index][cache->count[index]++] = ptr;
+}
+
+// ---------------------------------------------------------------------------
+// Large Pool
+// ---------------------------------------------------------------------------
+
+/**
+ * large_pool_ready
+ * Initializes the shared Pool on first use.
+ *
+ * @return Nonzero if the Pool can be used.
+ */
+int large_pool_ready() {
+    if (large_pool_state == 2)
+        return 1;
+    if (InterlockedCompareExchange(&large_pool_state, 1, 0) == 0) {
+        InterlockedExchange(&large_pool_state, pool_init(&large_pool, NEW_POOL_BYTES) ? 2 : 3);
+    } else {
+        while (large_pool_state == 1)
+            Sleep(0);
+    }
+    return large_pool_state == 2;
+}
+
+void* large_alloc(std::size_t size, std::size_t alignment) {
+    if (!large_pool_ready())
+        return NULL;
+    InterlockedIncrement64(&pool_allocs);
+    return (void*)pool_alloc(&large_pool, size ? size : 1, alignment);
+}
+
+void large_free(void* ptr) {
+    pool_free(&large_pool, (uintptr_t)ptr);
+}
+
+// ---------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------
+
+inline void* try_alloc(std::size_t size, std::size_t alignment) {
+    if (size <= NEW_MAX_SMALL && alignment <= 16)
+        return small_alloc(size);
+    return large_alloc(size, alignment < 16 ? 16 : alignment);
+}
+
+/**
+ * alloc_or_handle
+ * Calls the new-handler until the request succeeds, as operator new must.
+ *
+ * @return Allocated memory, or NULL if there is no new-handler (nothrow forms).
+ */
+void* alloc_or_handle(std::size_t size, std::size_t alignment) {
+    for (;;) {
+        void* ptr = try_alloc(size, alignment);
+        if (ptr != NULL)
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == NULL)
+            return NULL;
+        handler();
+    }
+}
+
+void* alloc_or_throw(std::size_t size, std::size_t alignment) {
+    void* ptr = alloc_or_handle(size, alignment);
+    if (ptr == NULL)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void* alloc_nothrow(std::size_t size, std::size_t alignment) noexcept {
+    try {
+        return alloc_or_handle(size, alignment);
+    } catch (...) {
+        return NULL;  // A new-handler may throw std::bad_alloc.
+    }
+}
+
+// Unsized delete: the chunk map tells Slab objects from Pool blocks.
+inline void free_unsized(void* ptr) {
+    if (ptr == NULL)
+        return;
+    Slab* chunk = chunk_of(ptr);
+    if (chunk != NULL)
+        small_free(ptr, class_index(chunk->object_size - HEADER_SIZE));
+    else
+        large_free(ptr);
+}
+
+// Aligned unsized delete: over-aligned blocks always come from the Pool.
+inline void free_aligned(void* ptr, std::size_t alignment) {
+    if (alignment <= 16)
+        free_unsized(ptr);
+    else if (ptr != NULL)
+        large_free(ptr);
+}
+
+// Sized delete: the size (and alignment) pick the class; no lookup.
+inline void free_sized(void* ptr, std::size_t size, std::size_t alignment) {
+    if (ptr == NULL)
+        return;
+    if (size <= NEW_MAX_SMALL && alignment <= 16)
+        small_free(ptr, class_index(size));
+    else
+        large_free(ptr);
+}
+
+} // namespace
+
+/**
+ * new_alloc_get_stats
+ * Copies the chunk counts and cache counters under the class lock.
+ *
+ * @param stats  Receives the statistics.
+ */
+void new_alloc_get_stats(NewAllocStats* stats) {
+    if (stats == NULL)
+        return;
+    lock_classes();
+    for (std::size_t index = 0; index < NEW_CLASS_COUNT; index++)
+        stats->class_chunks[index] = classes[index].chunk_count;
+    stats->refills = refills;
+    stats->flushes = flushes;
+    unlock_classes();
+    stats->pool_allocs = (std::size_t)pool_allocs;
+}
+
+} // namespace allocates
+
+// ---------------------------------------------------------------------------
+// Replacement Operators
+// ---------------------------------------------------------------------------
+
+using allocates::alloc_nothrow;
+using allocates::alloc_or_throw;
+using allocates::free_aligned;
+using allocates::free_sized;
+using allocates::free_unsized;
+
+void* operator new(std::size_t size) { return alloc_or_throw(size, 16); }
+void* operator new[](std::size_t size) { return alloc_or_throw(size, 16); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return alloc_nothrow(size, 16); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return alloc_nothrow(size, 16); }
+void* operator new(std::size_t size, std::align_val_t al) { return alloc_or_throw(size, (std::size_t)al); }
+void* operator new[](std::size_t size, std::align_val_t al) { return alloc_or_throw(size, (std::size_t)al); }
+void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return alloc_nothrow(size, (std::size_t)al); }
+void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return alloc_nothrow(size, (std::size_t)al); }
+
+void operator delete(void* ptr) noexcept { free_unsized(ptr); }
+void operator delete[](void* ptr) noexcept { free_unsized(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { free_unsized(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { free_unsized(ptr); }
+void operator delete(void* ptr, std::size_t size) noexcept { free_sized(ptr, size, 16); }
+void operator delete[](void* ptr, std::size_t size) noexcept { free_sized(ptr, size, 16); }
+void operator delete(void* ptr, std::align_val_t al) noexcept { free_aligned(ptr, (std::size_t)al); }
+void operator delete[](void* ptr, std::align_val_t al) noexcept { free_aligned(ptr, (std::size_t)al); }
+void operator delete(void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { free_aligned(ptr, (std::size_t)al); }
+void operator delete[](void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { free_aligned(ptr, (std::size_t)al); }
+void operator delete(void* ptr, std::size_t size, std::align_val_t al) noexcept { free_sized(ptr, size, (std::size_t)al); }
+void operator delete[](void* ptr, std::size_t size, std::align_val_t al) noexcept { free_sized(ptr, size, (std::size_t)al); }
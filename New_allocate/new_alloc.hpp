@@ -0,0 +1,48 @@
+// new_alloc.hpp
+
+#ifndef NEW_ALLOC_HPP
+#define NEW_ALLOC_HPP
+
+#include <cstddef>
+
+// Linking new_alloc.o into a program replaces every global operator new/delete
+// overload (plain, array, nothrow, aligned, sized and their combinations):
+//
+// - Requests up to NEW_MAX_SMALL bytes with at most 16-byte alignment go to
+//   size-classed Slabs (16-byte steps up to 256, then powers of two), through a
+//   per-thread cache of free objects refilled and flushed in batches.
+// - Larger or over-aligned requests go to one shared Pool.
+//
+// Sized delete maps the size straight to its class (or the alignment to the Pool)
+// without looking at the pointer. Unsized delete looks the pointer up in a radix
+// map of 2MB regions: every Slab chunk is one 2MB-aligned mapping.
+
+namespace allocates {
+
+// Tuning.
+constexpr std::size_t NEW_CLASS_COUNT  = 20;        // 16, 32, ..., 256, 512, 1024, 2048, 4096.
+constexpr std::size_t NEW_MAX_SMALL    = 4096;      // Largest Slab-served request.
+constexpr std::size_t NEW_CHUNK_BYTES  = 2 << 20;   // One Slab chunk (2MB-aligned mapping).
+constexpr std::size_t NEW_CACHE_OBJECTS = 64;       // Thread cache capacity per class.
+constexpr std::size_t NEW_CACHE_BATCH  = 32;        // Objects moved per refill/flush.
+constexpr std::size_t NEW_POOL_BYTES   = 16 << 20;  // Initial size of the large-object Pool.
+
+// NewAllocStats structure filled by new_alloc_get_stats.
+struct NewAllocStats {
+    std::size_t class_chunks[NEW_CLASS_COUNT];  // Slab chunks per class.
+    std::size_t refills;                        // Thread cache refills.
+    std::size_t flushes;                        // Thread cache flushes.
+    std::size_t pool_allocs;                    // Requests served by the Pool.
+};
+
+/**
+ * new_alloc_get_stats
+ * Reports chunk, cache and Pool counters of the replacement operator new.
+ *
+ * @param stats  Receives the statistics.
+ */
+void new_alloc_get_stats(NewAllocStats* stats);
+
+} // namespace allocates
+
+#endif // NEW_ALLOC_HPP
@@ -2,9 +2,464 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <windows.h>
+#include <psapi.h>
 #include "pool_alloc.h"
 
+#define MAX_THREADS 4
+
+// Arguments for an append-only worker thread.
+typedef struct AppendArgs {
+    Pool* pool;
+    int count;
+} AppendArgs;
+
+// Append-only worker: allocates and never frees.
+static DWORD WINAPI append_worker(LPVOID arg) {
+    AppendArgs* args = (AppendArgs*)arg;
+    for (int i = 0; i < args->count; i++) {
+        if (pool_alloc(args->pool, 64, 16) == 0)
+            break;
+    }
+    return 0;
+}
+
+// Runs `total` 64-byte allocations split over `threads` threads and returns the elapsed seconds.
+static double bench_append_only(int flags, int threads, int total, LARGE_INTEGER frequency) {
+    Pool pool;
+    if (!pool_init_ex(&pool, 1024 * 1024 * 10, flags))
+        return 0.0;
+    HANDLE handles[MAX_THREADS];
+    AppendArgs args[MAX_THREADS];
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int t = 0; t < threads; t++) {
+        args[t].pool = &pool;
+        args[t].count = total / threads;
+        handles[t] = CreateThread(NULL, 0, append_worker, &args[t], 0, NULL);
+    }
+    WaitForMultipleObjects(threads, handles, TRUE, INFINITE);
+    QueryPerformanceCounter(&end);
+    for (int t = 0; t < threads; t++)
+        CloseHandle(handles[t]);
+    pool_destroy(&pool);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// Short-lived worker: most objects die immediately, one in 16 survives until the end.
+static DWORD WINAPI short_lived_worker(LPVOID arg) {
+    AppendArgs* args = (AppendArgs*)arg;
+    uintptr_t* survivors = (uintptr_t*)malloc((args->count / 16 + 1) * sizeof(uintptr_t));
+    int kept = 0;
+    for (int i = 0; i < args->count; i++) {
+        uintptr_t p = pool_alloc(args->pool, 48, 16);
+        if (p == 0)
+            break;
+        if (i % 16 == 0)
+            survivors[kept++] = p;
+        else
+            pool_free(args->pool, p);
+    }
+    for (int i = 0; i < kept; i++)
+        pool_free(args->pool, survivors[i]);
+    free(survivors);
+    return 0;
+}
+
+// Runs the short-lived workload with or without TLABs and returns the elapsed seconds.
+static double bench_short_lived(int use_tlab, int threads, int total, LARGE_INTEGER frequency) {
+    Pool pool;
+    if (!pool_init(&pool, 1024 * 1024 * 10))
+        return 0.0;
+    if (use_tlab && !pool_tlab_enable(&pool, POOL_TLAB_DEFAULT_SIZE)) {
+        pool_destroy(&pool);
+        return 0.0;
+    }
+    HANDLE handles[MAX_THREADS];
+    AppendArgs args[MAX_THREADS];
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int t = 0; t < threads; t++) {
+        args[t].pool = &pool;
+        args[t].count = total / threads;
+        handles[t] = CreateThread(NULL, 0, short_lived_worker, &args[t], 0, NULL);
+    }
+    WaitForMultipleObjects(threads, handles, TRUE, INFINITE);
+    QueryPerformanceCounter(&end);
+    for (int t = 0; t < threads; t++)
+        CloseHandle(handles[t]);
+    pool_destroy(&pool);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// Mixed workload: most requests use two exact sizes, the rest are spread out.
+// Keeps a window of 1024 live blocks and frees them in FIFO order.
+static double bench_size_mix(int flags, int total, LARGE_INTEGER frequency, PoolStats* stats) {
+    Pool pool;
+    if (!pool_init_ex(&pool, 1024 * 1024 * 10, flags))
+        return 0.0;
+    uintptr_t window[1024] = {0};
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < total; i++) {
+        int slot = i % 1024;
+        pool_free(&pool, window[slot]);
+        unsigned int r = (unsigned int)i * 2654435761u;
+        size_t size = (r % 10 < 6) ? 48 : (r % 10 < 9) ? 96 : 16 + (r >> 20) % 2000;
+        window[slot] = pool_alloc(&pool, size, 16);
+    }
+    QueryPerformanceCounter(&end);
+    pool_get_stats(&pool, stats);
+    pool_destroy(&pool);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// Bursty workload: allocate 8MB in 16KB blocks, free everything, then stay idle for
+// twice the decay time while ticking the decay curve. Returns the time spent in bursts.
+static double bench_bursty_decay(size_t decay_ms, int bursts, LARGE_INTEGER frequency, PoolStats* stats) {
+    Pool pool;
+    if (!pool_init(&pool, 1024 * 1024 * 10))
+        return 0.0;
+    if (decay_ms != 0)
+        pool_set_decay(&pool, decay_ms, POOL_PURGE_DECOMMIT);
+    uintptr_t blocks[512];
+    double busy = 0.0;
+    LARGE_INTEGER start, end;
+    for (int burst = 0; burst < bursts; burst++) {
+        QueryPerformanceCounter(&start);
+        for (int i = 0; i < 512; i++) {
+            blocks[i] = pool_alloc(&pool, 16 * 1024, 16);
+            if (blocks[i] != 0)
+                memset((void*)blocks[i], i, 16 * 1024);
+        }
+        for (int i = 0; i < 512; i++)
+            pool_free(&pool, blocks[i]);
+        QueryPerformanceCounter(&end);
+        busy += (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+        for (size_t idle = 0; decay_ms != 0 && idle < decay_ms * 2; idle += decay_ms / POOL_DECAY_STEPS) {
+            Sleep((DWORD)(decay_ms / POOL_DECAY_STEPS));
+            pool_decay_tick(&pool);
+        }
+    }
+    pool_get_stats(&pool, stats);
+    pool_destroy(&pool);
+    return busy;
+}
+
+// Page faults taken by the process so far (GetProcessMemoryInfo, the getrusage analogue).
+static DWORD page_faults(void) {
+    PROCESS_MEMORY_COUNTERS counters;
+    counters.cb = sizeof(counters);
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PageFaultCount;
+}
+
+// Steady-state churn (256 live blocks of 64..1024 bytes) after a warm-up pass.
+// Reports page faults and slow-path system calls taken during the timed part.
+static void bench_realtime_steady(int flags, const char* label, LARGE_INTEGER frequency) {
+    Pool pool;
+    if (!pool_init_ex(&pool, 1024 * 1024 * 16, flags)) {
+        printf("%s: pool initialization failed.\n", label);
+        return;
+    }
+    uintptr_t window[256] = {0};
+    const int ops = 1000000;
+    DWORD faults = 0;
+    LARGE_INTEGER start, end;
+    for (int round = 0; round < 2; round++) {
+        if (round == 1) {
+            faults = page_faults();
+            QueryPerformanceCounter(&start);
+        }
+        for (int i = 0; i < ops; i++) {
+            int slot = i % 256;
+            pool_free(&pool, window[slot]);
+            size_t size = 64 + (size_t)((i * 2654435761u) >> 22) % 961;
+            window[slot] = pool_alloc(&pool, size, 16);
+            if (window[slot] != 0)
+                *(volatile char*)window[slot] = (char)i;
+        }
+    }
+    QueryPerformanceCounter(&end);
+    faults = page_faults() - faults;
+    PoolStats stats;
+    pool_get_stats(&pool, &stats);
+    printf("%s steady state, %d ops: %.2f ops/sec, %lu page faults, %zu slow-path syscalls\n",
+           label, ops, ops / ((double)(end.QuadPart - start.QuadPart) / frequency.QuadPart),
+           (unsigned long)faults, stats.slow_syscalls);
+    pool_destroy(&pool);
+}
+
+// Reserve callback: logs the event into memory taken from the same pool, as an
+// error path would, and counts the events seen.
+static void on_reserve_event(Pool* pool, int event, size_t size, void* context) {
+    int* events = (int*)context;
+    events[event]++;
+    if (event == POOL_RESERVE_ENTERED) {
+        char* message = (char*)pool_alloc(pool, 256, 16);
+        if (message != NULL) {
+            snprintf(message, 256, "pool exhausted by a %zu-byte request, shedding load", size);
+            pool_free(pool, (uintptr_t)message);
+        }
+    }
+}
+
+// Fills a fixed 1MB pool until both the pool and its 64KB reserve are exhausted.
+static void bench_emergency_reserve(void) {
+    Pool pool;
+    int events[4] = {0};
+    if (!pool_init_ex(&pool, 1024 * 1024, POOL_FLAG_FIXED) ||
+        !pool_reserve_init(&pool, 64 * 1024, on_reserve_event, events)) {
+        printf("Emergency reserve setup failed.\n");
+        return;
+    }
+    uintptr_t blocks[1200];
+    int count = 0;
+    while (count < 1200 && (blocks[count] = pool_alloc(&pool, 1024, 16)) != 0)
+        count++;
+    PoolStats stats;
+    pool_get_stats(&pool, &stats);
+    printf("Emergency reserve: %d x 1KB allocated, %zu from the %zu-byte reserve (peak %zu bytes), %zu failures\n",
+           count, stats.reserve_allocs, stats.reserve_bytes, stats.reserve_peak, stats.reserve_failures);
+    for (int i = 0; i < count; i++)
+        pool_free(&pool, blocks[i]);
+    printf("Reserve events: entered %d, exhausted %d, recovered %d\n",
+           events[POOL_RESERVE_ENTERED], events[POOL_RESERVE_EXHAUSTED], events[POOL_RESERVE_RECOVERED]);
+    pool_destroy(&pool);
+}
+
+// Tree node used by the locality benchmark.
+typedef struct TreeNode {
+    struct TreeNode* left;
+    struct TreeNode* right;
+    size_t key;
+    size_t value;
+} TreeNode;
+
+// Looks up `lookups` pseudo-random keys in pseudo-random trees of the forest; this
+// walk is what node placement affects.
+static size_t forest_lookups(TreeNode** roots, int trees, int per_tree, int lookups) {
+    size_t found = 0;
+    for (int j = 0; j < lookups; j++) {
+        int t = (int)(((unsigned)j * 2654435761u) >> 8) % trees;
+        int i = (int)(((unsigned)j * 40503u) >> 4) % per_tree;
+        size_t key = (((size_t)i * 2654435761u) ^ ((size_t)t * 40503u)) & 0xFFFFFF;
+        const TreeNode* node = roots[t];
+        while (node && node->key != key)
+            node = key < node->key ? node->left : node->right;
+        found += node != NULL;
+    }
+    return found;
+}
+
+// Fills 8MB of a pool with blocks of 64..1024 bytes, creating the tree roots in
+// between, and frees a pseudo-random half of the blocks. Then grows the forest of
+// binary search trees one node per tree at a time (so each tree's nodes are
+// allocated at different times), with or without the parent as hint. Reports how
+// many children share the parent's page and the time for 1M lookups.
+static void bench_tree_locality(int use_hint, LARGE_INTEGER frequency) {
+    const int trees = 1024;
+    const int per_tree = 16;
+    const int fillers = 16384;
+    Pool pool;
+    if (!pool_init(&pool, 1024 * 1024 * 16))
+        return;
+    uintptr_t* filler = (uintptr_t*)malloc(fillers * sizeof(uintptr_t));
+    TreeNode** roots = (TreeNode**)calloc(trees, sizeof(TreeNode*));
+    for (int i = 0; i < fillers; i++) {
+        filler[i] = pool_alloc(&pool, 64 + (size_t)(((unsigned)i * 2654435761u) >> 22) % 961, 16);
+        if (i % (fillers / trees) == 0) {
+            // Roots are created early, scattered between the other blocks.
+            TreeNode* root = (TreeNode*)pool_alloc(&pool, sizeof(TreeNode), 16);
+            int t = i / (fillers / trees);
+            root->left = root->right = NULL;
+            root->key = ((size_t)t * 40503u) & 0xFFFFFF;
+            root->value = 0;
+            roots[t] = root;
+        }
+    }
+    for (int i = 0; i < fillers; i++) {
+        if (((unsigned)i * 40503u) & 0x100)
+            pool_free(&pool, filler[i]);
+    }
+    int same_page = 0;
+    for (int i = 1; i < per_tree; i++) {
+        for (int t = 0; t < trees; t++) {
+            size_t key = (((size_t)i * 2654435761u) ^ ((size_t)t * 40503u)) & 0xFFFFFF;
+            TreeNode* parent = NULL;
+            TreeNode** link = &roots[t];
+            while (*link) {
+                parent = *link;
+                link = key < parent->key ? &parent->left : &parent->right;
+            }
+            TreeNode* node = (TreeNode*)(use_hint ? pool_alloc_near(&pool, sizeof(TreeNode), 16, (uintptr_t)parent)
+                                                  : pool_alloc(&pool, sizeof(TreeNode), 16));
+            node->left = node->right = NULL;
+            node->key = key;
+            node->value = (size_t)i;
+            *link = node;
+            same_page += ((uintptr_t)parent / 4096) == ((uintptr_t)node / 4096);
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t found = forest_lookups(roots, trees, per_tree, 1000000);
+    QueryPerformanceCounter(&end);
+    printf("Forest of %d x %d nodes, %s: %.1f%% of children share the parent's page, 1M lookups %.6f seconds (%zu hits)\n",
+           trees, per_tree, use_hint ? "pool_alloc_near" : "pool_alloc", 100.0 * same_page / ((double)trees * (per_tree - 1)),
+           (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, found);
+    free(roots);
+    free(filler);
+    pool_destroy(&pool);
+}
+
+// Orders addresses for the fragmentation benchmark.
+static int compare_addresses(const void* a, const void* b) {
+    uintptr_t x = *(const uintptr_t*)a;
+    uintptr_t y = *(const uintptr_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Request-style workload: each round allocates 32 short-lived buffers (64..2048 bytes)
+// and frees them at the end of the round, while 2 long-lived entries (64..512 bytes)
+// per round and a permanent 128-byte record every 16 rounds survive. Reports how many
+// pages the survivors pin and how much memory the pool holds, with and without
+// lifetime hints.
+static void bench_lifetime_fragmentation(int use_hints, LARGE_INTEGER frequency) {
+    const int rounds = 2000;
+    const int shorts_per_round = 32;
+    const int survivors = rounds * 2 + rounds / 16;
+    Pool pool;
+    if (!pool_init(&pool, 1024 * 1024) || (use_hints && !pool_lifetime_init(&pool, 1024 * 1024))) {
+        printf("Lifetime benchmark skipped: pool initialization failed.\n");
+        return;
+    }
+    uintptr_t shorts[32];
+    uintptr_t* live = (uintptr_t*)malloc(survivors * sizeof(uintptr_t));
+    size_t live_count = 0;
+    size_t live_bytes = 0;
+    unsigned seed = 12345;
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < shorts_per_round; i++) {
+            seed = seed * 1103515245u + 12345u;
+            shorts[i] = pool_alloc_lifetime(&pool, 64 + (seed >> 16) % 1985, 16, POOL_LIFETIME_SHORT);
+            if (i == 10 || i == 20) {
+                size_t size = 64 + (seed >> 8) % 449;
+                live[live_count++] = pool_alloc_lifetime(&pool, size, 16, POOL_LIFETIME_LONG);
+                live_bytes += size;
+            }
+        }
+        if (round % 16 == 0) {
+            live[live_count++] = pool_alloc_lifetime(&pool, 128, 16, POOL_LIFETIME_PERMANENT);
+            live_bytes += 128;
+        }
+        for (int i = shorts_per_round; i-- > 0;)
+            pool_free(&pool, shorts[i]);
+    }
+    QueryPerformanceCounter(&end);
+    // Pages that still hold a surviving block (including its 32-byte header).
+    qsort(live, live_count, sizeof(uintptr_t), compare_addresses);
+    size_t pages = 0;
+    uintptr_t last_page = 0;
+    for (size_t i = 0; i < live_count; i++) {
+        uintptr_t first = (live[i] - 32) / 4096;
+        uintptr_t last = (live[i] + ((BlockHeader*)(live[i] - 32))->size - 1) / 4096;
+        if (first != last_page)
+            pages++;
+        pages += last - first;
+        last_page = last;
+    }
+    PoolStats stats;
+    pool_get_stats(&pool, &stats);
+    size_t held = 0;
+    for (int lifetime = 0; lifetime < POOL_LIFETIME_CLASSES; lifetime++)
+        held += stats.lifetime_reserved[lifetime];
+    printf("%s: %.6f seconds, %zu survivors (%zu KB) pin %zu pages (%zu KB), pool holds %zu KB, %zu free-list fragments, %zu bulk rewinds\n",
+           use_hints ? "Lifetime hints" : "Mixed lifetimes", (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart,
+           live_count, live_bytes / 1024, pages, pages * 4, held / 1024, stats.free_blocks, stats.lifetime_rewinds);
+    free(live);
+    pool_destroy(&pool);
+}
+
+// Appends `count` 8-byte elements one at a time, then shrinks the array to 1/8.
+// The copying array doubles through pool_alloc + memcpy + pool_free; the region
+// array commits in place. Reports time and the peak bytes held during growth.
+static void bench_array_growth(int use_region, size_t count, LARGE_INTEGER frequency) {
+    LARGE_INTEGER start, end;
+    size_t peak = 0;
+    uint64_t sum = 0;
+    QueryPerformanceCounter(&start);
+    if (use_region) {
+        PoolRegion region;
+        if (!pool_region_init(&region, count * sizeof(uint64_t), 0)) {
+            printf("Region growth skipped: reservation failed.\n");
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint64_t* slot = (uint64_t*)pool_region_extend(&region, sizeof(uint64_t));
+            if (slot == NULL) {
+                printf("Region growth failed at element %zu.\n", i);
+                break;
+            }
+            *slot = i;
+        }
+        peak = region.committed;
+        const uint64_t* array = (const uint64_t*)region.base;
+        for (size_t i = 0; i < count; i += 4096)
+            sum += array[i];
+        pool_region_resize(&region, count / 8 * sizeof(uint64_t));
+        QueryPerformanceCounter(&end);
+        printf("Region array, %zu elements: %.6f seconds, peak %zu MB, %zu MB committed after shrink, %zu commits (%llu)\n",
+               count, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, peak >> 20,
+               region.committed >> 20, region.commits, (unsigned long long)sum);
+        pool_region_destroy(&region);
+        return;
+    }
+
+    Pool pool;
+    if (!pool_init(&pool, 1024 * 1024)) {
+        printf("Copying growth skipped: pool initialization failed.\n");
+        return;
+    }
+    size_t capacity = 16, length = 0, copies = 0;
+    uint64_t* array = (uint64_t*)pool_alloc(&pool, capacity * sizeof(uint64_t), 16);
+    for (size_t i = 0; i < count && array != NULL; i++) {
+        if (length == capacity) {
+            uint64_t* grown = (uint64_t*)pool_alloc(&pool, capacity * 2 * sizeof(uint64_t), 16);
+            if (grown == NULL) {
+                printf("Copying growth failed at element %zu.\n", i);
+                break;
+            }
+            if (peak < capacity * 3 * sizeof(uint64_t))
+                peak = capacity * 3 * sizeof(uint64_t);
+            memcpy(grown, array, length * sizeof(uint64_t));
+            pool_free(&pool, (uintptr_t)array);
+            array = grown;
+            capacity *= 2;
+            copies++;
+        }
+        array[length++] = i;
+    }
+    for (size_t i = 0; array != NULL && i < length; i += 4096)
+        sum += array[i];
+    // Shrinking a copying array means one more allocate-copy-free.
+    uint64_t* shrunk = (uint64_t*)pool_alloc(&pool, length / 8 * sizeof(uint64_t), 16);
+    if (shrunk != NULL && array != NULL) {
+        memcpy(shrunk, array, length / 8 * sizeof(uint64_t));
+        pool_free(&pool, (uintptr_t)array);
+    }
+    QueryPerformanceCounter(&end);
+    PoolStats stats;
+    pool_get_stats(&pool, &stats);
+    printf("Copying array, %zu elements: %.6f seconds, peak %zu MB, pool holds %zu MB after shrink, %zu copies (%llu)\n",
+           count, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, peak >> 20,
+           stats.reserved_bytes >> 20, copies, (unsigned long long)sum);
+    pool_destroy(&pool);
+}
+
 int main(void) {
     // Benchmark parameters
     const int iterations = 1000000;  // 1 million allocations
@@ -67,5 +522,59 @@ int main(void) {
     pool_destroy(&pool);
     printf("Memory pool destroyed.\n");
 
+    // Benchmark multithreaded append-only allocation, locked vs concurrent bump.
+    const int appendTotal = 4000000;
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double lockedTime = bench_append_only(0, threads, appendTotal, frequency);
+        double bumpTime = bench_append_only(POOL_FLAG_CONCURRENT_BUMP, threads, appendTotal, frequency);
+        printf("Append-only, %d thread(s): locked %.2f ops/sec, concurrent bump %.2f ops/sec\n",
+               threads, appendTotal / lockedTime, appendTotal / bumpTime);
+    }
+
+    // Benchmark short-lived, thread-private allocations with and without TLABs.
+    const int shortTotal = 400000;
+    double sharedTime = bench_short_lived(0, MAX_THREADS, shortTotal, frequency);
+    double tlabTime = bench_short_lived(1, MAX_THREADS, shortTotal, frequency);
+    printf("Short-lived, %d threads: shared %.2f ops/sec, TLAB %.2f ops/sec\n",
+           MAX_THREADS, shortTotal / sharedTime, shortTotal / tlabTime);
+
+    // Benchmark a size mix dominated by two sizes, generic vs adaptive slab promotion.
+    const int mixTotal = 200000;
+    PoolStats stats;
+    double genericTime = bench_size_mix(0, mixTotal, frequency, &stats);
+    double adaptiveTime = bench_size_mix(POOL_FLAG_ADAPTIVE, mixTotal, frequency, &stats);
+    printf("Size mix, %d ops: generic %.2f ops/sec, adaptive %.2f ops/sec\n",
+           mixTotal, mixTotal / genericTime, mixTotal / adaptiveTime);
+    printf("Adaptive: %zu promoted sizes, %zu promotions, %zu retirements, %zu slab allocations\n",
+           stats.adaptive_classes, stats.adaptive_promotions, stats.adaptive_retirements, stats.adaptive_allocs);
+
+    // Benchmark steady-state faults in real-time mode.
+    bench_realtime_steady(0, "Default pool", frequency);
+    bench_realtime_steady(POOL_FLAG_REALTIME, "Real-time pool", frequency);
+
+    // Exercise the emergency reserve under exhaustion.
+    bench_emergency_reserve();
+
+    // Benchmark tree locality with and without allocation hints.
+    bench_tree_locality(0, frequency);
+    bench_tree_locality(1, frequency);
+
+    // Benchmark fragmentation from mixed lifetimes with and without lifetime hints.
+    bench_lifetime_fragmentation(0, frequency);
+    bench_lifetime_fragmentation(1, frequency);
+
+    // Benchmark bursty usage with idle gaps, without and with dirty page decay.
+    const int bursts = 4;
+    double keepTime = bench_bursty_decay(0, bursts, frequency, &stats);
+    double decayTime = bench_bursty_decay(200, bursts, frequency, &stats);
+    printf("Bursty 8MB x %d: no decay %.6f seconds, 200ms decay %.6f seconds\n", bursts, keepTime, decayTime);
+    printf("Decay: %zu bytes purged in %zu calls, %zu refaults, %zu bytes still purged\n",
+           stats.purged_bytes_total, stats.purge_calls, stats.refaults, stats.purged_bytes);
+
+    // Benchmark growing a 256MB array by copying vs in a reserved region.
+    const size_t growCount = 32 * 1024 * 1024;
+    bench_array_growth(0, growCount, frequency);
+    bench_array_growth(1, growCount, frequency);
+
     return 0;
 }
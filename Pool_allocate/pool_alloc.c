@@ -1,6 +1,7 @@
 // pool_alloc.c
 
 #include "pool_alloc.h"
+#include "slab_alloc.h"
 #include <windows.h>
 #include <stdlib.h>
 #include <string.h>
@@ -17,6 +18,9 @@
 // MIN_SPLIT_THRESHOLD: Minimum extra space required to split a free block.
 #define MIN_SPLIT_THRESHOLD 16
 
+// TLAB_MAX_FRACTION: Requests larger than tlab_size / TLAB_MAX_FRACTION bypass the TLAB.
+#define TLAB_MAX_FRACTION 8
+
 // -----------------------------------------------------------------------------
 // Spin Lock Helper Functions for Free List
 // -----------------------------------------------------------------------------
@@ -24,9 +28,17 @@
 /**
  * acquire_free_list_lock
  * Acquires the spin lock used for protecting the free list.
- * Uses a busy-wait loop with a timeout to prevent deadlock.
+ * Uses a busy-wait loop with a timeout to prevent deadlock. A real-time pool spins
+ * with PAUSE instead of yielding, so contention never enters the kernel.
  */
-static void acquire_free_list_lock(volatile LONG* lock) {
+static void acquire_free_list_lock(Pool* pool, volatile LONG* lock) {
+    if (pool->flags & POOL_FLAG_REALTIME) {
+        while (InterlockedExchange(lock, 1) != 0) {
+            while (*lock != 0)
+                _mm_pause();
+        }
+        return;
+    }
     int timeout = 1000000;  // Arbitrary large timeout value.
     int count = 0;
     while (InterlockedExchange(lock, 1) != 0) {
@@ -93,15 +105,331 @@ static void simd_memset(void* ptr, int value, size_t size) {
     // Debug prints disabled.
 }
 
+// -----------------------------------------------------------------------------
+// PoolBlock Lookup
+// -----------------------------------------------------------------------------
+
+/**
+ * find_block
+ * Returns the PoolBlock whose usable area contains addr, or NULL.
+ */
+static PoolBlock* find_block(Pool* pool, uintptr_t addr) {
+    for (uintptr_t block_ptr = pool->block_head; block_ptr != 0; block_ptr = ((PoolBlock*)block_ptr)->next) {
+        PoolBlock* block = (PoolBlock*)block_ptr;
+        if (addr >= block->base && addr < block->base + block->size)
+            return block;
+    }
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Real-Time Mode
+// -----------------------------------------------------------------------------
+
+/**
+ * note_slow_syscall
+ * Counts a system call made after init. With POOL_REALTIME_ASSERT defined, a
+ * real-time pool treats it as a fatal error.
+ */
+static void note_slow_syscall(Pool* pool) {
+    pool->slow_syscalls++;
+#ifdef POOL_REALTIME_ASSERT
+    if (pool->flags & POOL_FLAG_REALTIME) {
+        fprintf(stderr, "pool_alloc: system call on a real-time pool after init\n");
+        abort();
+    }
+#endif
+}
+
+/**
+ * note_heap_call
+ * Counts a CRT heap call on an allocation or free path of a real-time pool as a
+ * slow system call (the heap may map memory or take its own lock).
+ */
+static void note_heap_call(Pool* pool) {
+    if (pool->flags & POOL_FLAG_REALTIME)
+        note_slow_syscall(pool);
+}
+
+/**
+ * lock_block
+ * Grows the working set by the block size, touches every page, and locks the block.
+ * The old working-set limits are restored if the lock fails.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+static int lock_block(PoolBlock* block, size_t total_size) {
+    SIZE_T min_ws, max_ws;
+    if (!GetProcessWorkingSetSize(GetCurrentProcess(), &min_ws, &max_ws))
+        return 0;
+    if (!SetProcessWorkingSetSize(GetCurrentProcess(), min_ws + total_size, max_ws + total_size))
+        return 0;
+    for (size_t offset = 0; offset < total_size; offset += POOL_PAGE_SIZE)
+        ((volatile unsigned char*)block)[offset] = ((volatile unsigned char*)block)[offset];
+    if (!VirtualLock(block, total_size)) {
+        SetProcessWorkingSetSize(GetCurrentProcess(), min_ws, max_ws);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * unlock_block
+ * Unlocks a block locked by lock_block and gives its size back to the working-set
+ * limits.
+ */
+static void unlock_block(PoolBlock* block, size_t total_size) {
+    SIZE_T min_ws, max_ws;
+    VirtualUnlock(block, total_size);
+    if (GetProcessWorkingSetSize(GetCurrentProcess(), &min_ws, &max_ws) && min_ws > total_size && max_ws > total_size)
+        SetProcessWorkingSetSize(GetCurrentProcess(), min_ws - total_size, max_ws - total_size);
+}
+
+// -----------------------------------------------------------------------------
+// Dirty Page Decay
+// -----------------------------------------------------------------------------
+
+/**
+ * decay_attach_block
+ * Allocates the page state map of a PoolBlock (all pages POOL_PAGE_USED).
+ *
+ * @return 1 on success, 0 if the map could not be allocated (block stays untracked).
+ */
+static int decay_attach_block(PoolBlock* block) {
+    if (block->page_state != NULL)
+        return 1;
+    uintptr_t first = block->base / POOL_PAGE_SIZE;
+    uintptr_t last = (block->base + block->size - 1) / POOL_PAGE_SIZE;
+    block->first_page = first;
+    block->page_state = (unsigned char*)calloc(last - first + 1, 1);
+    return block->page_state != NULL;
+}
+
+/**
+ * decay_release_range
+ * Hands a page-aligned range back to the OS with the pool's purge method.
+ */
+static void decay_release_range(Pool* pool, uintptr_t addr, size_t len) {
+    if (pool->purge_mode == POOL_PURGE_DECOMMIT)
+        VirtualFree((LPVOID)addr, len, MEM_DECOMMIT);
+    else
+        VirtualAlloc((LPVOID)addr, len, MEM_RESET, PAGE_READWRITE);
+    note_slow_syscall(pool);
+    pool->purge_calls++;
+    pool->purged_bytes_total += len;
+}
+
+/**
+ * decay_mark_used
+ * Must be called before a free-list range is written or handed out. Pages that
+ * overlap [addr, addr + len) go back to POOL_PAGE_USED; purged pages count as a
+ * refault and are recommitted first in POOL_PURGE_DECOMMIT mode.
+ */
+static void decay_mark_used(Pool* pool, uintptr_t addr, size_t len) {
+    if (pool->decay_ms == 0 && pool->purged_pages == 0)
+        return;
+    PoolBlock* block = find_block(pool, addr);
+    if (block == NULL || block->page_state == NULL)
+        return;
+    uintptr_t first = addr / POOL_PAGE_SIZE;
+    uintptr_t last = (addr + len - 1) / POOL_PAGE_SIZE;
+    for (uintptr_t page = first; page <= last; page++) {
+        unsigned char* state = &block->page_state[page - block->first_page];
+        if (*state == POOL_PAGE_DIRTY) {
+            pool->dirty_pages--;
+        } else if (*state == POOL_PAGE_PURGED) {
+            if (pool->purge_mode == POOL_PURGE_DECOMMIT) {
+                VirtualAlloc((LPVOID)(page * POOL_PAGE_SIZE), POOL_PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE);
+                note_slow_syscall(pool);
+            }
+            pool->purged_pages--;
+            pool->refaults++;
+        }
+        *state = POOL_PAGE_USED;
+    }
+}
+
+/**
+ * decay_scan
+ * Marks every page lying entirely inside a free block's payload as dirty.
+ * The block header (which holds next_free) is never part of such a page.
+ *
+ * @return Number of pages that became dirty.
+ */
+static size_t decay_scan(Pool* pool) {
+    size_t newly_dirty = 0;
+    for (BlockHeader* cur = (BlockHeader*)pool->free_list; cur; cur = (BlockHeader*)cur->next_free) {
+        uintptr_t start = (uintptr_t)cur + HEADER_SIZE;
+        uintptr_t first = (start + POOL_PAGE_SIZE - 1) / POOL_PAGE_SIZE;
+        uintptr_t stop = (start + cur->size) / POOL_PAGE_SIZE;
+        if (first >= stop)
+            continue;
+        PoolBlock* block = find_block(pool, start);
+        if (block == NULL || block->page_state == NULL)
+            continue;
+        for (uintptr_t page = first; page < stop; page++) {
+            unsigned char* state = &block->page_state[page - block->first_page];
+            if (*state == POOL_PAGE_USED) {
+                *state = POOL_PAGE_DIRTY;
+                pool->dirty_pages++;
+                newly_dirty++;
+            }
+        }
+    }
+    return newly_dirty;
+}
+
+/**
+ * decay_purge
+ * Purges up to max_pages dirty pages, one system call per run of contiguous pages.
+ *
+ * @return Bytes purged.
+ */
+static size_t decay_purge(Pool* pool, size_t max_pages) {
+    size_t purged = 0;
+    for (BlockHeader* cur = (BlockHeader*)pool->free_list; cur && purged < max_pages; cur = (BlockHeader*)cur->next_free) {
+        uintptr_t start = (uintptr_t)cur + HEADER_SIZE;
+        uintptr_t first = (start + POOL_PAGE_SIZE - 1) / POOL_PAGE_SIZE;
+        uintptr_t stop = (start + cur->size) / POOL_PAGE_SIZE;
+        if (first >= stop)
+            continue;
+        PoolBlock* block = find_block(pool, start);
+        if (block == NULL || block->page_state == NULL)
+            continue;
+        unsigned char* state = block->page_state - block->first_page;
+        uintptr_t page = first;
+        while (page < stop && purged < max_pages) {
+            if (state[page] != POOL_PAGE_DIRTY) {
+                page++;
+                continue;
+            }
+            uintptr_t run = page;
+            while (run < stop && state[run] == POOL_PAGE_DIRTY && purged + (run - page) < max_pages)
+                run++;
+            decay_release_range(pool, page * POOL_PAGE_SIZE, (run - page) * POOL_PAGE_SIZE);
+            for (uintptr_t p = page; p < run; p++)
+                state[p] = POOL_PAGE_PURGED;
+            pool->dirty_pages -= run - page;
+            pool->purged_pages += run - page;
+            purged += run - page;
+            page = run;
+        }
+    }
+    return purged * POOL_PAGE_SIZE;
+}
+
+/**
+ * decay_restore
+ * Returns every tracked page to POOL_PAGE_USED, recommitting decommitted pages,
+ * and optionally frees the page state maps.
+ */
+static void decay_restore(Pool* pool, int free_maps) {
+    for (uintptr_t block_ptr = pool->block_head; block_ptr != 0; block_ptr = ((PoolBlock*)block_ptr)->next) {
+        PoolBlock* block = (PoolBlock*)block_ptr;
+        if (block->page_state == NULL)
+            continue;
+        uintptr_t count = (block->base + block->size - 1) / POOL_PAGE_SIZE - block->first_page + 1;
+        if (pool->purge_mode == POOL_PURGE_DECOMMIT && pool->purged_pages != 0) {
+            for (uintptr_t i = 0; i < count; i++) {
+                if (block->page_state[i] == POOL_PAGE_PURGED) {
+                    VirtualAlloc((LPVOID)((block->first_page + i) * POOL_PAGE_SIZE), POOL_PAGE_SIZE,
+                                 MEM_COMMIT, PAGE_READWRITE);
+                    note_slow_syscall(pool);
+                }
+            }
+        }
+        if (free_maps) {
+            free(block->page_state);
+            block->page_state = NULL;
+        } else {
+            memset(block->page_state, POOL_PAGE_USED, count);
+        }
+    }
+    pool->dirty_pages = 0;
+    pool->purged_pages = 0;
+    memset(pool->decay_backlog, 0, sizeof(pool->decay_backlog));
+}
+
+/**
+ * decay_keep_fraction
+ * Fraction of the pages dirtied `age` steps ago that may stay resident:
+ * 1 - smoothstep((age + 1) / POOL_DECAY_STEPS), reaching 0 at the last step.
+ */
+static double decay_keep_fraction(int age) {
+    double x = (double)(age + 1) / POOL_DECAY_STEPS;
+    return 1.0 - x * x * (3.0 - 2.0 * x);
+}
+
+/**
+ * decay_thread_main
+ * Background purger: ticks the decay curve once per step until woken for shutdown.
+ */
+static DWORD WINAPI decay_thread_main(LPVOID arg) {
+    Pool* pool = (Pool*)arg;
+    for (;;) {
+        DWORD wait = (DWORD)(pool->decay_ms / POOL_DECAY_STEPS);
+        if (wait == 0)
+            wait = pool->decay_ms ? 1 : 100;
+        if (WaitForSingleObject(pool->decay_wakeup, wait) == WAIT_OBJECT_0)
+            break;
+        pool_decay_tick(pool);
+    }
+    return 0;
+}
+
 // -----------------------------------------------------------------------------
 // Free List Block Removal (First-Fit)
 // -----------------------------------------------------------------------------
 
+/**
+ * take_free_block
+ * Unlinks `current` (whose predecessor is `prev`, or NULL for the list head) and
+ * splits off the unused tail as a new free block when it is large enough.
+ *
+ * @return Pointer to the allocated block (user pointer).
+ */
+static uintptr_t take_free_block(Pool* pool, BlockHeader* prev, BlockHeader* current, size_t alloc_size) {
+    if (prev == NULL) {
+        pool->free_list = current->next_free;
+    } else {
+        prev->next_free = current->next_free;
+    }
+    // Pages about to be written must be resident (and committed) again.
+    if (current->size >= alloc_size + HEADER_SIZE + MIN_SPLIT_THRESHOLD)
+        decay_mark_used(pool, (uintptr_t)current, HEADER_SIZE + alloc_size + HEADER_SIZE);
+    else
+        decay_mark_used(pool, (uintptr_t)current, HEADER_SIZE + current->size);
+    // If the free block is large enough, perform splitting.
+    if (current->size >= alloc_size + HEADER_SIZE + MIN_SPLIT_THRESHOLD) {
+        size_t original_size = current->size;
+        current->size = alloc_size;  // Set allocated size.
+        // Calculate address for the leftover block.
+        uintptr_t leftover_addr = ((uintptr_t)current) + HEADER_SIZE + alloc_size;
+        size_t leftover_size = original_size - alloc_size - HEADER_SIZE;
+        BlockHeader* leftover_header = (BlockHeader*)leftover_addr;
+        leftover_header->size = leftover_size;
+        leftover_header->padding = 0;
+        if (pool->flags & POOL_FLAG_REALTIME) {
+            // Keep the list address-ordered: the tail takes the block's place.
+            leftover_header->next_free = current->next_free;
+            if (prev == NULL)
+                pool->free_list = leftover_addr;
+            else
+                prev->next_free = leftover_addr;
+        } else {
+            leftover_header->next_free = pool->free_list;
+            pool->free_list = leftover_addr;
+        }
+    }
+    return ((uintptr_t)current) + HEADER_SIZE;
+}
+
 /**
  * remove_free_block
  * Traverses the free list and returns the first block that satisfies
- * the allocation size and alignment requirements. If the block is sufficiently
- * large, it splits the block and returns the allocated portion.
+ * the allocation size and alignment requirements (with POOL_FLAG_BEST_FIT, the
+ * smallest such block). If the block is sufficiently large, it splits the block
+ * and returns the allocated portion.
  *
  * @param pool       Pointer to the Pool structure.
  * @param alloc_size Number of bytes requested.
@@ -109,36 +437,59 @@ static void simd_memset(void* ptr, int value, size_t size) {
  * @return Pointer to the allocated block (user pointer), or 0 if none found.
  */
 static uintptr_t remove_free_block(Pool* pool, size_t alloc_size, size_t alignment) {
+    int best_fit = (pool->flags & POOL_FLAG_BEST_FIT) != 0;
+    BlockHeader* best = NULL;
+    BlockHeader* best_prev = NULL;
     BlockHeader* prev = NULL;
     BlockHeader* current = (BlockHeader*)pool->free_list;
     while (current) {
         uintptr_t candidate_user_ptr = ((uintptr_t)current) + HEADER_SIZE;
         if ((candidate_user_ptr % alignment) == 0 && current->size >= alloc_size) {
             // Suitable free block found.
-            if (prev == NULL) {
-                pool->free_list = current->next_free;
-            } else {
-                prev->next_free = current->next_free;
-            }
-            // If the free block is large enough, perform splitting.
-            if (current->size >= alloc_size + HEADER_SIZE + MIN_SPLIT_THRESHOLD) {
-                size_t original_size = current->size;
-                current->size = alloc_size;  // Set allocated size.
-                // Calculate address for the leftover block.
-                uintptr_t leftover_addr = ((uintptr_t)current) + HEADER_SIZE + alloc_size;
-                size_t leftover_size = original_size - alloc_size - HEADER_SIZE;
-                BlockHeader* leftover_header = (BlockHeader*)leftover_addr;
-                leftover_header->size = leftover_size;
-                leftover_header->padding = 0;
-                leftover_header->next_free = pool->free_list;
-                pool->free_list = leftover_addr;
+            if (!best_fit)
+                return take_free_block(pool, prev, current, alloc_size);
+            if (best == NULL || current->size < best->size) {
+                best = current;
+                best_prev = prev;
+                if (current->size == alloc_size)
+                    break;
             }
-            return ((uintptr_t)current) + HEADER_SIZE;
         }
         prev = current;
         current = (BlockHeader*)current->next_free;
     }
-    return 0;
+    return best ? take_free_block(pool, best_prev, best, alloc_size) : 0;
+}
+
+/**
+ * remove_free_block_near
+ * Like remove_free_block, but among the fitting blocks inside `home` picks the one
+ * closest to `hint`, stopping early at a block in the hint's page.
+ *
+ * @return Pointer to the allocated block (user pointer), or 0 if none found in `home`.
+ */
+static uintptr_t remove_free_block_near(Pool* pool, size_t alloc_size, size_t alignment,
+                                        PoolBlock* home, uintptr_t hint) {
+    BlockHeader* best = NULL;
+    BlockHeader* best_prev = NULL;
+    uintptr_t best_distance = (uintptr_t)-1;
+    BlockHeader* prev = NULL;
+    for (BlockHeader* current = (BlockHeader*)pool->free_list; current; current = (BlockHeader*)current->next_free) {
+        uintptr_t candidate_user_ptr = ((uintptr_t)current) + HEADER_SIZE;
+        if ((candidate_user_ptr % alignment) == 0 && current->size >= alloc_size &&
+            candidate_user_ptr >= home->base && candidate_user_ptr < home->base + home->size) {
+            uintptr_t distance = candidate_user_ptr > hint ? candidate_user_ptr - hint : hint - candidate_user_ptr;
+            if (distance < best_distance) {
+                best = current;
+                best_prev = prev;
+                best_distance = distance;
+                if (candidate_user_ptr / POOL_PAGE_SIZE == hint / POOL_PAGE_SIZE)
+                    break;
+            }
+        }
+        prev = current;
+    }
+    return best ? take_free_block(pool, best_prev, best, alloc_size) : 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -200,6 +551,40 @@ static uintptr_t alloc_from_block(uintptr_t block_ptr, size_t alloc_size, size_t
     return result;
 }
 
+/**
+ * alloc_from_block_atomic
+ * Lock-free variant of alloc_from_block used in POOL_FLAG_CONCURRENT_BUMP mode.
+ * The new offset is computed from a snapshot of the current one and published with
+ * a compare-and-swap; the winner then owns [offset, new offset) and writes the block
+ * header without any lock. A CAS is used rather than a plain fetch-add so that a
+ * request that does not fit never moves the offset past the end of the block.
+ *
+ * @param block_ptr  Pointer (as an integer) to the PoolBlock.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement.
+ * @return User pointer to the allocated memory, or 0 if insufficient space.
+ */
+static uintptr_t alloc_from_block_atomic(uintptr_t block_ptr, size_t alloc_size, size_t alignment) {
+    PoolBlock* block = (PoolBlock*)block_ptr;
+    volatile LONG64* offset_ptr = (volatile LONG64*)&block->offset;
+    for (;;) {
+        LONG64 offset = *offset_ptr;
+        uintptr_t raw = block->base + (uintptr_t)offset;
+        uintptr_t aligned = (raw + HEADER_SIZE + alignment - 1) & ~((uintptr_t)alignment - 1);
+        size_t padding = aligned - (raw + HEADER_SIZE);
+        size_t new_offset = (size_t)offset + HEADER_SIZE + padding + alloc_size;
+        if (new_offset > block->size)
+            return 0;
+        if (InterlockedCompareExchange64(offset_ptr, (LONG64)new_offset, offset) == offset) {
+            BlockHeader* header = (BlockHeader*)(aligned - HEADER_SIZE);
+            header->size = alloc_size;
+            header->padding = padding;
+            header->next_free = 0;
+            return aligned;
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Coalescing Free Blocks in the Free List
 // -----------------------------------------------------------------------------
@@ -219,6 +604,7 @@ static void coalesce_free_list(Pool* pool) {
     }
     if (count == 0)
         return;
+    note_heap_call(pool);  // Real-time pools use insert_free_ordered instead.
     uintptr_t* arr = (uintptr_t*)malloc(count * sizeof(uintptr_t));
     if (!arr)
         return;
@@ -236,11 +622,16 @@ static void coalesce_free_list(Pool* pool) {
     qsort(arr, count, sizeof(uintptr_t), cmp);
     for (i = 0; i < count - 1; i++) {
         BlockHeader* a = (BlockHeader*)arr[i];
-        BlockHeader* b = (BlockHeader*)arr[i + 1];
-        uintptr_t a_end = ((uintptr_t)a) + HEADER_SIZE + a->size;
-        if (a_end == (uintptr_t)b) {
+        if (a == NULL)
+            continue;  // Already merged into an earlier block.
+        // Absorb every following block that starts where a ends.
+        for (int j = i + 1; j < count; j++) {
+            BlockHeader* b = (BlockHeader*)arr[j];
+            uintptr_t a_end = ((uintptr_t)a) + HEADER_SIZE + a->size;
+            if (a_end != (uintptr_t)b)
+                break;
             a->size = a->size + HEADER_SIZE + b->size;
-            arr[i + 1] = 0;  // Mark block b as merged.
+            arr[j] = 0;  // Mark block b as merged.
         }
     }
     uintptr_t new_free_list = 0;
@@ -277,8 +668,25 @@ static void coalesce_free_list(Pool* pool) {
  * @return 1 on success, 0 on failure.
  */
 int pool_init(Pool* pool, size_t pool_size) {
+    return pool_init_ex(pool, pool_size, 0);
+}
+
+/**
+ * pool_init_ex
+ * Initializes the memory pool like pool_init and records the POOL_FLAG_* options.
+ *
+ * @param pool      Pointer to a Pool structure.
+ * @param pool_size Total size (in bytes) for the initial PoolBlock.
+ * @param flags     Combination of POOL_FLAG_* values.
+ * @return 1 on success, 0 on failure.
+ */
+int pool_init_ex(Pool* pool, size_t pool_size, int flags) {
     if (!pool || pool_size == 0)
         return 0;
+    if ((flags & POOL_FLAG_REALTIME) && (flags & POOL_FLAG_ADAPTIVE))
+        return 0;  // Adaptive classes map slabs on demand.
+    if (flags & POOL_FLAG_REALTIME)
+        flags |= POOL_FLAG_FIXED;
     InitializeCriticalSection(&pool->lock);
     pool->free_list_lock = 0;
     size_t block_total_size = pool_size + sizeof(PoolBlock);
@@ -287,6 +695,11 @@ int pool_init(Pool* pool, size_t pool_size) {
         DeleteCriticalSection(&pool->lock);
         return 0;
     }
+    if ((flags & POOL_FLAG_REALTIME) && !lock_block(block, block_total_size)) {
+        VirtualFree(block, 0, MEM_RELEASE);
+        DeleteCriticalSection(&pool->lock);
+        return 0;
+    }
     // Ensure the usable base is aligned to 16 bytes.
     uintptr_t base = (uintptr_t)block + sizeof(PoolBlock);
     uintptr_t aligned_base = (base + 15) & ~((uintptr_t)15);
@@ -294,31 +707,84 @@ int pool_init(Pool* pool, size_t pool_size) {
     block->size = pool_size;
     block->offset = 0;
     block->next = 0;
+    block->page_state = NULL;
+    block->first_page = 0;
     pool->block_head = (uintptr_t)block;
     pool->free_list = 0;
     pool->initial_block_size = pool_size;
+    pool->flags = flags;
+    pool->locked_bytes = (flags & POOL_FLAG_REALTIME) ? block_total_size : 0;
+    pool->bump_block = (uintptr_t)block;
+    pool->tlab_index = FLS_OUT_OF_INDEXES;
+    pool->tlab_size = 0;
+    pool->tlab_epoch = 0;
+    memset(pool->classes, 0, sizeof(pool->classes));
+    memset(pool->sample_sizes, 0, sizeof(pool->sample_sizes));
+    memset(pool->sample_hits, 0, sizeof(pool->sample_hits));
+    pool->sample_count = 0;
+    pool->sample_tick = 0;
+    pool->adaptive_promotions = 0;
+    pool->adaptive_retirements = 0;
+    pool->adaptive_allocs = 0;
+    pool->decay_ms = 0;
+    pool->purge_mode = POOL_PURGE_RESET;
+    pool->decay_tick = 0;
+    memset(pool->decay_backlog, 0, sizeof(pool->decay_backlog));
+    pool->dirty_pages = 0;
+    pool->purged_pages = 0;
+    pool->purged_bytes_total = 0;
+    pool->purge_calls = 0;
+    pool->refaults = 0;
+    pool->decay_thread = NULL;
+    pool->decay_wakeup = NULL;
+    pool->slow_syscalls = 0;
+    pool->reserve = NULL;
+    pool->reserve_begin = 0;
+    pool->reserve_end = 0;
+    pool->reserve_callback = NULL;
+    pool->reserve_context = NULL;
+    pool->reserve_used = 0;
+    pool->reserve_peak = 0;
+    pool->reserve_allocs = 0;
+    pool->reserve_failures = 0;
+    memset(pool->lifetime, 0, sizeof(pool->lifetime));
+    pool->lifetime_lock = 0;
+    memset((void*)pool->lifetime_live, 0, sizeof(pool->lifetime_live));
+    pool->lifetime_rewinds = 0;
     return 1;
 }
 
 /**
- * pool_alloc
- * Allocates a memory block of the specified size and alignment.
- * It first checks the free list (using first-fit), then attempts sequential allocation
- * from existing PoolBlocks, and if necessary performs dynamic expansion.
+ * pool_alloc_shared
+ * Allocates from the shared pool structures: the free list (using first-fit), then
+ * sequential allocation from existing PoolBlocks, and if necessary dynamic expansion.
+ * In POOL_FLAG_CONCURRENT_BUMP mode the sequential step is tried first without the
+ * pool lock whenever the free list is empty.
  *
  * @param pool       Pointer to the Pool structure.
  * @param alloc_size Number of bytes requested.
  * @param alignment  Alignment requirement (must be a power of 2).
  * @return Pointer to the allocated memory (user pointer), or 0 if allocation fails.
  */
-uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
-    if (!pool || alloc_size == 0 || (alignment & (alignment - 1)) != 0)
-        return 0;
+static uintptr_t pool_alloc_shared(Pool* pool, size_t alloc_size, size_t alignment) {
     uintptr_t result = 0;
+    int concurrent = (pool->flags & POOL_FLAG_CONCURRENT_BUMP) != 0;
+
+    // Lock-free bump allocation while there is nothing on the free list to reuse.
+    if (concurrent && pool->free_list == 0) {
+        uintptr_t bump_ptr = pool->bump_block;
+        while (bump_ptr != 0) {
+            result = alloc_from_block_atomic(bump_ptr, alloc_size, alignment);
+            if (result != 0)
+                return result;
+            bump_ptr = ((PoolBlock*)bump_ptr)->next;
+        }
+    }
+
     EnterCriticalSection(&pool->lock);
 
     // Attempt to find a suitable free block (first-fit).
-    acquire_free_list_lock(&pool->free_list_lock);
+    acquire_free_list_lock(pool, &pool->free_list_lock);
     result = remove_free_block(pool, alloc_size, alignment);
     release_free_list_lock(&pool->free_list_lock);
     if (result != 0) {
@@ -331,7 +797,10 @@ uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
     PoolBlock* block;
     while (block_ptr != 0) {
         block = (PoolBlock*)block_ptr;
-        result = alloc_from_block(block_ptr, alloc_size, alignment);
+        if (concurrent)
+            result = alloc_from_block_atomic(block_ptr, alloc_size, alignment);
+        else
+            result = alloc_from_block(block_ptr, alloc_size, alignment);
         if (result != 0) {
             LeaveCriticalSection(&pool->lock);
             return result;
@@ -340,11 +809,16 @@ uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
     }
 
     // Dynamic Expansion: allocate a new PoolBlock if necessary.
+    if (pool->flags & POOL_FLAG_FIXED) {
+        LeaveCriticalSection(&pool->lock);
+        return 0;
+    }
     size_t new_block_size = pool->initial_block_size;
     if (new_block_size < alloc_size + HEADER_SIZE)
         new_block_size = alloc_size + HEADER_SIZE;
     size_t total_new_block_size = new_block_size + sizeof(PoolBlock);
     PoolBlock* new_block = (PoolBlock*)VirtualAlloc(NULL, total_new_block_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    note_slow_syscall(pool);
     if (new_block == 0) {
         LeaveCriticalSection(&pool->lock);
         return 0;
@@ -353,6 +827,12 @@ uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
     new_block->size = new_block_size;
     new_block->offset = 0;
     new_block->next = 0;
+    new_block->page_state = NULL;
+    new_block->first_page = 0;
+    if (pool->decay_ms != 0)
+        decay_attach_block(new_block);
+    // Lock-free allocators may walk the chain concurrently; publish a fully built block.
+    MemoryBarrier();
     if (pool->block_head == 0) {
         pool->block_head = (uintptr_t)new_block;
     } else {
@@ -362,77 +842,1140 @@ uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
         }
         last->next = (uintptr_t)new_block;
     }
-    result = alloc_from_block((uintptr_t)new_block, alloc_size, alignment);
+    pool->bump_block = (uintptr_t)new_block;
+    if (concurrent)
+        result = alloc_from_block_atomic((uintptr_t)new_block, alloc_size, alignment);
+    else
+        result = alloc_from_block((uintptr_t)new_block, alloc_size, alignment);
+    if (pool->decay_ms != 0)
+        pool_decay_tick(pool);  // Expansion is a slow path; let the decay curve advance.
     LeaveCriticalSection(&pool->lock);
     return result;
 }
 
 /**
- * pool_free
- * Frees a previously allocated block by inserting it into the free list
- * and then coalescing adjacent free blocks.
+ * insert_free_ordered
+ * Real-time pools keep the free list in address order: the block is linked in
+ * place and merged with the neighbours it touches in the same walk, so a free
+ * needs neither the sort array nor qsort of coalesce_free_list.
+ *
+ * @param pool   Pointer to the Pool structure.
+ * @param header Header of the block being freed.
+ */
+static void insert_free_ordered(Pool* pool, BlockHeader* header) {
+    BlockHeader* prev = NULL;
+    BlockHeader* cur = (BlockHeader*)pool->free_list;
+    while (cur != NULL && cur < header) {
+        prev = cur;
+        cur = (BlockHeader*)cur->next_free;
+    }
+    if (cur != NULL && (uintptr_t)header + HEADER_SIZE + header->size == (uintptr_t)cur) {
+        header->size += HEADER_SIZE + cur->size;
+        cur = (BlockHeader*)cur->next_free;
+    }
+    if (prev != NULL && (uintptr_t)prev + HEADER_SIZE + prev->size == (uintptr_t)header) {
+        prev->size += HEADER_SIZE + header->size;
+        prev->next_free = (uintptr_t)cur;
+        return;
+    }
+    header->next_free = (uintptr_t)cur;
+    if (prev != NULL)
+        prev->next_free = (uintptr_t)header;
+    else
+        pool->free_list = (uintptr_t)header;
+}
+
+/**
+ * pool_free_shared
+ * Inserts a block into the shared free list and coalesces adjacent free blocks.
  *
  * @param pool Pointer to the Pool structure.
  * @param ptr  User pointer to the block to free.
  */
-void pool_free(Pool* pool, uintptr_t ptr) {
-    if (!pool || ptr == 0)
-        return;
+static void pool_free_shared(Pool* pool, uintptr_t ptr) {
     EnterCriticalSection(&pool->lock);
     uintptr_t header_addr = ptr - HEADER_SIZE;
     BlockHeader* header = (BlockHeader*)header_addr;
-    acquire_free_list_lock(&pool->free_list_lock);
+    acquire_free_list_lock(pool, &pool->free_list_lock);
+    if (pool->flags & POOL_FLAG_REALTIME) {
+        insert_free_ordered(pool, header);
+        release_free_list_lock(&pool->free_list_lock);
+        LeaveCriticalSection(&pool->lock);
+        return;
+    }
     header->next_free = pool->free_list;
     pool->free_list = header_addr;
     release_free_list_lock(&pool->free_list_lock);
     coalesce_free_list(pool);
+    if (pool->decay_ms != 0)
+        pool_decay_tick(pool);
     LeaveCriticalSection(&pool->lock);
 }
 
+// -----------------------------------------------------------------------------
+// Thread-Local Allocation Buffers (TLABs)
+// -----------------------------------------------------------------------------
+
+// PoolTlab: per-thread chunk claimed from the pool, stored in the pool's FLS slot.
+// [start, end) is the chunk including the header slot of the claiming allocation,
+// so every byte of it is later covered by an object header or the returned tail.
+typedef struct PoolTlab {
+    Pool* pool;
+    LONG epoch;           // pool->tlab_epoch when the chunk was claimed.
+    uintptr_t cursor;     // Next raw address to hand out.
+    uintptr_t end;        // End of the chunk.
+    uintptr_t last;       // User pointer of the most recent allocation (0 if none).
+                          // Its header's next_free holds the PoolTlab address while
+                          // the block is still that untouched allocation.
+    uintptr_t last_raw;   // Cursor value before that allocation, for LIFO rollback.
+} PoolTlab;
+
+/**
+ * tlab_retire
+ * Returns the unused tail of a TLAB to the shared free list as one free block.
+ * Chunks claimed before the last pool_reset are simply dropped.
+ *
+ * @param tlab Pointer to the PoolTlab.
+ */
+static void tlab_retire(PoolTlab* tlab) {
+    Pool* pool = tlab->pool;
+    if (tlab->cursor != 0 && tlab->epoch == pool->tlab_epoch) {
+        uintptr_t tail = (tlab->cursor + 15) & ~((uintptr_t)15);
+        if (tail + HEADER_SIZE + MIN_SPLIT_THRESHOLD <= tlab->end) {
+            BlockHeader* header = (BlockHeader*)tail;
+            header->size = tlab->end - tail - HEADER_SIZE;
+            header->padding = 0;
+            header->next_free = 0;
+            pool_free_shared(pool, tail + HEADER_SIZE);
+        }
+    }
+    tlab->cursor = 0;
+    tlab->end = 0;
+    tlab->last = 0;
+}
+
 /**
- * pool_reset
- * Resets the memory pool by clearing the free list and resetting the offset
- * of every PoolBlock. Also, the usable memory is cleared using SIMD/AVX.
+ * tlab_thread_exit
+ * FLS callback run when a thread exits (or the slot is freed): returns the
+ * thread's TLAB tail and releases the PoolTlab.
  *
- * @param pool Pointer to the Pool structure.
+ * @param data Pointer to the PoolTlab stored in the slot.
  */
-void pool_reset(Pool* pool) {
-    if (!pool)
+static void WINAPI tlab_thread_exit(PVOID data) {
+    PoolTlab* tlab = (PoolTlab*)data;
+    if (tlab == NULL)
         return;
+    tlab_retire(tlab);
+    free(tlab);
+}
+
+/**
+ * tlab_alloc
+ * Bumps the calling thread's TLAB cursor, writing a regular BlockHeader in front
+ * of the returned block. Claims a fresh chunk when the current one is exhausted.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement.
+ * @return User pointer, or 0 if no chunk could be claimed.
+ */
+static uintptr_t tlab_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
+    PoolTlab* tlab = (PoolTlab*)FlsGetValue(pool->tlab_index);
+    if (tlab == NULL) {
+        note_heap_call(pool);
+        tlab = (PoolTlab*)calloc(1, sizeof(PoolTlab));
+        if (tlab == NULL)
+            return 0;
+        tlab->pool = pool;
+        FlsSetValue(pool->tlab_index, tlab);
+    }
+    if (alignment < 16)
+        alignment = 16;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (tlab->cursor != 0 && tlab->epoch == pool->tlab_epoch) {
+            uintptr_t raw = tlab->cursor;
+            uintptr_t aligned = (raw + HEADER_SIZE + alignment - 1) & ~((uintptr_t)alignment - 1);
+            // Round to 16 so consecutive TLAB blocks tile without gaps and coalesce once freed.
+            size_t rounded = (alloc_size + 15) & ~((size_t)15);
+            if (aligned + rounded <= tlab->end) {
+                BlockHeader* header = (BlockHeader*)(aligned - HEADER_SIZE);
+                header->size = rounded;
+                header->padding = aligned - (raw + HEADER_SIZE);
+                header->next_free = (uintptr_t)tlab;  // Owner tag, checked before a rollback.
+                tlab->last = aligned;
+                tlab->last_raw = raw;
+                tlab->cursor = aligned + rounded;
+                return aligned;
+            }
+            tlab_retire(tlab);
+        }
+        // Refill: claim a new chunk through the shared path.
+        uintptr_t chunk = pool_alloc_shared(pool, pool->tlab_size, 16);
+        if (chunk == 0)
+            return 0;
+        tlab->epoch = pool->tlab_epoch;
+        tlab->cursor = chunk - HEADER_SIZE;
+        tlab->end = chunk + ((BlockHeader*)(chunk - HEADER_SIZE))->size;
+        tlab->last = 0;
+    }
+    return 0;
+}
+
+/**
+ * pool_tlab_enable
+ * Allocates the FLS slot whose callback returns TLAB tails on thread exit.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param tlab_size  Chunk size in bytes (0 for the default).
+ * @return 1 on success, 0 on failure.
+ */
+int pool_tlab_enable(Pool* pool, size_t tlab_size) {
+    if (!pool)
+        return 0;
+    if (tlab_size == 0)
+        tlab_size = POOL_TLAB_DEFAULT_SIZE;
+    if (tlab_size < POOL_TLAB_MIN_SIZE)
+        tlab_size = POOL_TLAB_MIN_SIZE;
+    if (tlab_size > POOL_TLAB_MAX_SIZE)
+        tlab_size = POOL_TLAB_MAX_SIZE;
     EnterCriticalSection(&pool->lock);
-    acquire_free_list_lock(&pool->free_list_lock);
-    pool->free_list = 0;
-    release_free_list_lock(&pool->free_list_lock);
-    uintptr_t block_ptr = pool->block_head;
-    while (block_ptr != 0) {
-        PoolBlock* block = (PoolBlock*)block_ptr;
-        block->offset = 0;
-        simd_memset((void*)block->base, 0, block->size);
-        block_ptr = block->next;
+    if (pool->tlab_index == FLS_OUT_OF_INDEXES) {
+        DWORD index = FlsAlloc(tlab_thread_exit);
+        if (index == FLS_OUT_OF_INDEXES) {
+            LeaveCriticalSection(&pool->lock);
+            return 0;
+        }
+        pool->tlab_size = tlab_size;
+        pool->tlab_index = index;
     }
     LeaveCriticalSection(&pool->lock);
+    return 1;
 }
 
 /**
- * pool_destroy
- * Destroys the memory pool by releasing all allocated PoolBlocks and cleaning up
- * the synchronization primitives.
+ * pool_tlab_flush
+ * Retires the calling thread's TLAB so its tail goes back to the free list.
  *
- * @param pool Pointer to the Pool structure.
+ * @param pool  Pointer to the Pool structure.
  */
-void pool_destroy(Pool* pool) {
-    if (!pool)
+void pool_tlab_flush(Pool* pool) {
+    if (!pool || pool->tlab_index == FLS_OUT_OF_INDEXES)
         return;
-    EnterCriticalSection(&pool->lock);
-    uintptr_t block_ptr = pool->block_head;
-    while (block_ptr != 0) {
-        PoolBlock* block = (PoolBlock*)block_ptr;
-        uintptr_t next = block->next;
-        VirtualFree((LPVOID)block, 0, MEM_RELEASE);
-        block_ptr = next;
+    PoolTlab* tlab = (PoolTlab*)FlsGetValue(pool->tlab_index);
+    if (tlab != NULL)
+        tlab_retire(tlab);
+}
+
+// -----------------------------------------------------------------------------
+// Adaptive Size Classes (Slab Promotion)
+// -----------------------------------------------------------------------------
+
+/**
+ * adaptive_find
+ * Returns the size class serving exactly `size`, or NULL.
+ */
+static PoolSizeClass* adaptive_find(Pool* pool, size_t size) {
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES; i++) {
+        if (pool->classes[i].size == size)
+            return &pool->classes[i];
     }
-    pool->block_head = 0;
-    acquire_free_list_lock(&pool->free_list_lock);
+    return NULL;
+}
+
+/**
+ * adaptive_destroy_class
+ * Destroys the internal slab of a size class and frees the slot.
+ */
+static void adaptive_destroy_class(Pool* pool, PoolSizeClass* cls) {
+    slab_destroy(cls->slab);
+    note_slow_syscall(pool);
+    free(cls->slab);
+    memset(cls, 0, sizeof(*cls));
+    pool->adaptive_retirements++;
+}
+
+/**
+ * adaptive_promote
+ * Creates an internal slab for `size` in a free class slot. Silently gives up when
+ * every slot is taken or the slab cannot be mapped.
+ */
+static void adaptive_promote(Pool* pool, size_t size) {
+    PoolSizeClass* cls = adaptive_find(pool, 0);
+    if (cls == NULL)
+        return;
+    Slab* slab = (Slab*)malloc(sizeof(Slab));
+    if (slab == NULL)
+        return;
+    // slab_alloc hands out object + HEADER_SIZE, so the header is part of the object.
+    note_slow_syscall(pool);
+    if (!slab_init(slab, POOL_ADAPTIVE_SLAB_OBJECTS, size + HEADER_SIZE)) {
+        free(slab);
+        return;
+    }
+    cls->size = size;
+    cls->slab = slab;
+    cls->begin = (uintptr_t)slab->memory;
+    cls->end = cls->begin + slab->object_size * slab->total_objects;
+    cls->live = 0;
+    cls->hits = 0;
+    cls->retiring = 0;
+    pool->adaptive_promotions++;
+}
+
+/**
+ * adaptive_rebalance
+ * Runs at the end of every sampling window: retires promoted sizes that went cold,
+ * revives retiring sizes that became hot again, and promotes new dominant sizes.
+ */
+static void adaptive_rebalance(Pool* pool) {
+    const size_t hot = POOL_SAMPLE_WINDOW / 8;
+    const size_t cold = POOL_SAMPLE_WINDOW / 64;
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES; i++) {
+        PoolSizeClass* cls = &pool->classes[i];
+        if (cls->size == 0)
+            continue;
+        if (cls->hits < cold)
+            cls->retiring = 1;
+        else if (cls->hits >= hot)
+            cls->retiring = 0;
+        cls->hits = 0;
+        if (cls->retiring && cls->live == 0)
+            adaptive_destroy_class(pool, cls);
+    }
+    for (int i = 0; i < POOL_SAMPLE_SLOTS; i++) {
+        size_t size = pool->sample_sizes[i];
+        if (size != 0 && size <= POOL_ADAPTIVE_MAX_SIZE && pool->sample_hits[i] >= hot &&
+            adaptive_find(pool, size) == NULL)
+            adaptive_promote(pool, size);
+        pool->sample_sizes[i] = 0;
+        pool->sample_hits[i] = 0;
+    }
+    pool->sample_count = 0;
+}
+
+/**
+ * adaptive_sample
+ * Counts one request of `size` in the open-addressed sample table (sizes that
+ * find no slot within a short probe are dropped) and closes the window when full.
+ */
+static void adaptive_sample(Pool* pool, size_t size) {
+    size_t slot = ((size >> 4) * 2654435761u) % POOL_SAMPLE_SLOTS;
+    for (int probe = 0; probe < 4; probe++) {
+        size_t i = (slot + probe) % POOL_SAMPLE_SLOTS;
+        if (pool->sample_sizes[i] == size || pool->sample_sizes[i] == 0) {
+            pool->sample_sizes[i] = size;
+            pool->sample_hits[i]++;
+            break;
+        }
+    }
+    PoolSizeClass* cls = adaptive_find(pool, size);
+    if (cls != NULL)
+        cls->hits++;
+    if (++pool->sample_count >= POOL_SAMPLE_WINDOW)
+        adaptive_rebalance(pool);
+}
+
+/**
+ * adaptive_promoted
+ * Checks the promoted-size table without the lock. Slots are only written under
+ * pool->lock, so a stale answer merely sends the caller to the locked recheck.
+ */
+static int adaptive_promoted(Pool* pool, size_t size) {
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES; i++) {
+        if (*(volatile size_t*)&pool->classes[i].size == size)
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * adaptive_alloc
+ * Samples the request and serves it from the size's slab when it is promoted. With
+ * POOL_FLAG_CONCURRENT_BUMP the lock is only taken for promoted sizes and for one
+ * request in POOL_SAMPLE_STRIDE, so the lock-free bump path stays lock-free.
+ *
+ * @return User pointer, or 0 to fall through to the generic path.
+ */
+static uintptr_t adaptive_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
+    uintptr_t result = 0;
+    int sample = 1;
+    if (pool->flags & POOL_FLAG_CONCURRENT_BUMP) {
+        // Golden-ratio scrambling of the tick, so the sample does not alias with
+        // periodic request patterns the way every Nth request would.
+        uint32_t tick = (uint32_t)InterlockedIncrement(&pool->sample_tick) * 2654435761u;
+        sample = tick < UINT32_MAX / POOL_SAMPLE_STRIDE;
+        if (!sample && !adaptive_promoted(pool, alloc_size))
+            return 0;
+    }
+    EnterCriticalSection(&pool->lock);
+    if (sample)
+        adaptive_sample(pool, alloc_size);
+    PoolSizeClass* cls = adaptive_find(pool, alloc_size);
+    if (cls != NULL && !cls->retiring && alignment <= 16) {
+        result = (uintptr_t)slab_alloc(cls->slab);
+        if (result != 0) {
+            cls->live++;
+            pool->adaptive_allocs++;
+        }
+    }
+    LeaveCriticalSection(&pool->lock);
+    return result;
+}
+
+/**
+ * adaptive_free
+ * Returns a block to its size-class slab if it came from one.
+ *
+ * @return 1 if the block belonged to a promoted slab, 0 otherwise.
+ */
+static int adaptive_free(Pool* pool, uintptr_t ptr) {
+    int handled = 0;
+    // A live slab object keeps its class alive, so an unlocked miss is final.
+    int owned = 0;
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES && !owned; i++) {
+        PoolSizeClass* cls = &pool->classes[i];
+        owned = *(volatile size_t*)&cls->size != 0 && ptr >= cls->begin && ptr < cls->end;
+    }
+    if (!owned)
+        return 0;
+    EnterCriticalSection(&pool->lock);
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES; i++) {
+        PoolSizeClass* cls = &pool->classes[i];
+        if (cls->size != 0 && ptr >= cls->begin && ptr < cls->end) {
+            slab_free(cls->slab, (void*)ptr);
+            cls->live--;
+            if (cls->retiring && cls->live == 0)
+                adaptive_destroy_class(pool, cls);
+            handled = 1;
+            break;
+        }
+    }
+    LeaveCriticalSection(&pool->lock);
+    return handled;
+}
+
+/**
+ * adaptive_clear
+ * Destroys every internal slab and forgets the current window (reset/destroy).
+ */
+static void adaptive_clear(Pool* pool) {
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES; i++) {
+        if (pool->classes[i].size != 0)
+            adaptive_destroy_class(pool, &pool->classes[i]);
+    }
+    memset(pool->sample_sizes, 0, sizeof(pool->sample_sizes));
+    memset(pool->sample_hits, 0, sizeof(pool->sample_hits));
+    pool->sample_count = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Emergency Reserve
+// -----------------------------------------------------------------------------
+
+/**
+ * reserve_notify
+ * Invokes the reserve callback, if any.
+ */
+static void reserve_notify(Pool* pool, int event, size_t size) {
+    if (pool->reserve_callback)
+        pool->reserve_callback(pool, event, size, pool->reserve_context);
+}
+
+/**
+ * reserve_alloc
+ * Serves a request from the emergency reserve after the normal path failed.
+ *
+ * @return User pointer, or 0 if the reserve is missing or exhausted.
+ */
+static uintptr_t reserve_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
+    if (pool->reserve == NULL)
+        return 0;
+    uintptr_t result = pool_alloc(pool->reserve, alloc_size, alignment);
+    if (result == 0) {
+        InterlockedIncrement64(&pool->reserve_failures);
+        reserve_notify(pool, POOL_RESERVE_EXHAUSTED, alloc_size);
+        return 0;
+    }
+    size_t size = ((BlockHeader*)(result - HEADER_SIZE))->size;
+    LONG64 before = InterlockedExchangeAdd64(&pool->reserve_used, (LONG64)size);
+    LONG64 peak = pool->reserve_peak;
+    while (before + (LONG64)size > peak) {
+        LONG64 seen = InterlockedCompareExchange64(&pool->reserve_peak, before + (LONG64)size, peak);
+        if (seen == peak)
+            break;
+        peak = seen;
+    }
+    InterlockedIncrement64(&pool->reserve_allocs);
+    if (before == 0)
+        reserve_notify(pool, POOL_RESERVE_ENTERED, alloc_size);
+    return result;
+}
+
+/**
+ * reserve_free
+ * Returns a block to the reserve if it lives there.
+ *
+ * @return 1 if ptr belonged to the reserve, 0 otherwise.
+ */
+static int reserve_free(Pool* pool, uintptr_t ptr) {
+    if (pool->reserve == NULL || ptr < pool->reserve_begin || ptr >= pool->reserve_end)
+        return 0;
+    size_t size = ((BlockHeader*)(ptr - HEADER_SIZE))->size;
+    pool_free(pool->reserve, ptr);
+    if (InterlockedExchangeAdd64(&pool->reserve_used, -(LONG64)size) == (LONG64)size)
+        reserve_notify(pool, POOL_RESERVE_RECOVERED, 0);
+    return 1;
+}
+
+/**
+ * pool_reserve_init
+ * Creates the fixed-size reserve pool (real-time pools get a real-time reserve) and
+ * touches every page so the memory is resident before it is needed.
+ *
+ * @param pool          Pointer to the Pool structure.
+ * @param reserve_size  Size of the emergency region in bytes.
+ * @param callback      Notified on POOL_RESERVE_* events (may be NULL).
+ * @param context       Passed to the callback.
+ * @return 1 on success, 0 on failure.
+ */
+int pool_reserve_init(Pool* pool, size_t reserve_size, PoolReserveCallback callback, void* context) {
+    if (!pool || reserve_size == 0 || pool->reserve != NULL)
+        return 0;
+    Pool* reserve = (Pool*)malloc(sizeof(Pool));
+    if (reserve == NULL)
+        return 0;
+    int flags = POOL_FLAG_FIXED | (pool->flags & POOL_FLAG_REALTIME);
+    if (!pool_init_ex(reserve, reserve_size, flags)) {
+        free(reserve);
+        return 0;
+    }
+    PoolBlock* block = (PoolBlock*)reserve->block_head;
+    for (uintptr_t page = block->base; page < block->base + block->size; page += POOL_PAGE_SIZE)
+        *(volatile unsigned char*)page = 0;
+    EnterCriticalSection(&pool->lock);
+    pool->reserve_begin = block->base;
+    pool->reserve_end = block->base + block->size;
+    pool->reserve_callback = callback;
+    pool->reserve_context = context;
+    pool->reserve = reserve;
+    LeaveCriticalSection(&pool->lock);
+    return 1;
+}
+
+// -----------------------------------------------------------------------------
+// Lifetime Chains
+// -----------------------------------------------------------------------------
+
+/**
+ * lifetime_rewind
+ * Empties a chain without touching its memory: the free list is dropped and every
+ * PoolBlock offset goes back to 0. Blocks stay mapped for the next allocations.
+ */
+static void lifetime_rewind(Pool* chain) {
+    EnterCriticalSection(&chain->lock);
+    acquire_free_list_lock(chain, &chain->free_list_lock);
+    chain->free_list = 0;
+    release_free_list_lock(&chain->free_list_lock);
+    for (uintptr_t block_ptr = chain->block_head; block_ptr != 0; block_ptr = ((PoolBlock*)block_ptr)->next)
+        ((PoolBlock*)block_ptr)->offset = 0;
+    chain->bump_block = chain->block_head;
+    LeaveCriticalSection(&chain->lock);
+}
+
+/**
+ * lifetime_free
+ * Returns a block to the lifetime chain that owns it. Permanent blocks are left in
+ * place; the short chain is rewound when its last live block is freed.
+ *
+ * @return 1 if ptr belonged to a lifetime chain, 0 otherwise.
+ */
+static int lifetime_free(Pool* pool, uintptr_t ptr) {
+    for (int lifetime = 0; lifetime < POOL_LIFETIME_CLASSES; lifetime++) {
+        Pool* chain = pool->lifetime[lifetime];
+        if (chain == NULL || find_block(chain, ptr) == NULL)
+            continue;
+        if (lifetime == POOL_LIFETIME_PERMANENT)
+            return 1;
+        if (lifetime == POOL_LIFETIME_SHORT) {
+            acquire_free_list_lock(pool, &pool->lifetime_lock);
+            if (--pool->lifetime_live[lifetime] == 0) {
+                lifetime_rewind(chain);
+                pool->lifetime_rewinds++;
+            } else {
+                pool_free(chain, ptr);
+            }
+            release_free_list_lock(&pool->lifetime_lock);
+        } else {
+            pool_free(chain, ptr);
+            InterlockedDecrement64(&pool->lifetime_live[lifetime]);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * pool_lifetime_init
+ * Creates the internal pools backing the short, long and permanent chains.
+ *
+ * @param pool        Pointer to the Pool structure.
+ * @param chain_size  Initial block size of each chain in bytes.
+ * @return 1 on success, 0 on failure.
+ */
+int pool_lifetime_init(Pool* pool, size_t chain_size) {
+    if (!pool || chain_size == 0 || pool->lifetime[POOL_LIFETIME_SHORT] != NULL)
+        return 0;
+    Pool* chains[POOL_LIFETIME_CLASSES] = { NULL, NULL, NULL, NULL };
+    int base_flags = pool->flags & (POOL_FLAG_FIXED | POOL_FLAG_REALTIME);
+    for (int lifetime = 0; lifetime < POOL_LIFETIME_CLASSES; lifetime++) {
+        if (lifetime == POOL_LIFETIME_MEDIUM)
+            continue;
+        int flags = base_flags | (lifetime == POOL_LIFETIME_LONG ? POOL_FLAG_BEST_FIT : 0);
+        chains[lifetime] = (Pool*)malloc(sizeof(Pool));
+        if (chains[lifetime] == NULL || !pool_init_ex(chains[lifetime], chain_size, flags)) {
+            free(chains[lifetime]);
+            for (int i = 0; i < lifetime; i++) {
+                if (chains[i] != NULL) {
+                    pool_destroy(chains[i]);
+                    free(chains[i]);
+                }
+            }
+            return 0;
+        }
+    }
+    EnterCriticalSection(&pool->lock);
+    memcpy(pool->lifetime, chains, sizeof(chains));
+    LeaveCriticalSection(&pool->lock);
+    return 1;
+}
+
+/**
+ * pool_lifetime_reset
+ * Rewinds one lifetime chain and forgets its live blocks.
+ *
+ * @param pool      Pointer to the Pool structure.
+ * @param lifetime  POOL_LIFETIME_SHORT, POOL_LIFETIME_LONG or POOL_LIFETIME_PERMANENT.
+ */
+void pool_lifetime_reset(Pool* pool, int lifetime) {
+    if (!pool || lifetime < 0 || lifetime >= POOL_LIFETIME_CLASSES || pool->lifetime[lifetime] == NULL)
+        return;
+    acquire_free_list_lock(pool, &pool->lifetime_lock);
+    lifetime_rewind(pool->lifetime[lifetime]);
+    pool->lifetime_live[lifetime] = 0;
+    release_free_list_lock(&pool->lifetime_lock);
+}
+
+// -----------------------------------------------------------------------------
+// Growable Regions
+// -----------------------------------------------------------------------------
+
+/**
+ * pool_region_init
+ * Reserves the range with no access; pool_region_resize commits it chunk by chunk.
+ *
+ * @param region        Pointer to a PoolRegion structure.
+ * @param max_size      Largest size the region can ever reach.
+ * @param commit_chunk  Commit granularity (0 for the default).
+ * @return 1 on success, 0 on failure.
+ */
+int pool_region_init(PoolRegion* region, size_t max_size, size_t commit_chunk) {
+    if (!region || max_size == 0 || max_size > ((size_t)-1 >> 1))
+        return 0;
+    if (commit_chunk == 0)
+        commit_chunk = POOL_REGION_DEFAULT_CHUNK;
+    if (commit_chunk > max_size)
+        commit_chunk = max_size;
+    commit_chunk = (commit_chunk + POOL_REGION_MIN_CHUNK - 1) & ~((size_t)POOL_REGION_MIN_CHUNK - 1);
+    size_t reserved = (max_size + POOL_REGION_MIN_CHUNK - 1) & ~((size_t)POOL_REGION_MIN_CHUNK - 1);
+    unsigned char* base = (unsigned char*)VirtualAlloc(NULL, reserved, MEM_RESERVE, PAGE_NOACCESS);
+    if (base == NULL)
+        return 0;
+    region->base = base;
+    region->reserved = reserved;
+    region->committed = 0;
+    region->size = 0;
+    region->commit_chunk = commit_chunk;
+    region->commits = 0;
+    region->decommits = 0;
+    return 1;
+}
+
+/**
+ * pool_region_resize
+ * Commits [committed, round_up(size)) when growing, or decommits everything past
+ * round_up(size) + commit_chunk when shrinking. The base never moves.
+ *
+ * @param region  Pointer to the PoolRegion structure.
+ * @param size    New size in bytes.
+ * @return 1 on success, 0 if size exceeds the reservation or the commit failed.
+ */
+int pool_region_resize(PoolRegion* region, size_t size) {
+    if (!region || region->base == NULL || size > region->reserved)
+        return 0;
+    size_t chunk = region->commit_chunk;
+    size_t needed = (size + chunk - 1) / chunk * chunk;
+    if (needed > region->reserved)
+        needed = region->reserved;
+    if (needed > region->committed) {
+        if (VirtualAlloc(region->base + region->committed, needed - region->committed, MEM_COMMIT,
+                         PAGE_READWRITE) == NULL)
+            return 0;
+        region->committed = needed;
+        region->commits++;
+    } else if (region->committed - needed > chunk) {
+        size_t keep = needed + chunk;
+        if (VirtualFree(region->base + keep, region->committed - keep, MEM_DECOMMIT)) {
+            region->committed = keep;
+            region->decommits++;
+        }
+    }
+    region->size = size;
+    return 1;
+}
+
+/**
+ * pool_region_extend
+ * Resizes to size + bytes and returns the old end.
+ *
+ * @param region  Pointer to the PoolRegion structure.
+ * @param bytes   Number of bytes to append.
+ * @return Pointer to the first appended byte, or NULL on failure.
+ */
+void* pool_region_extend(PoolRegion* region, size_t bytes) {
+    if (!region || bytes > region->reserved - region->size)
+        return NULL;
+    size_t old_size = region->size;
+    if (old_size + bytes > region->committed && !pool_region_resize(region, old_size + bytes))
+        return NULL;
+    region->size = old_size + bytes;
+    return region->base + old_size;
+}
+
+/**
+ * pool_region_destroy
+ * Releases the reservation (committed pages included).
+ *
+ * @param region  Pointer to the PoolRegion structure.
+ */
+void pool_region_destroy(PoolRegion* region) {
+    if (!region || region->base == NULL)
+        return;
+    VirtualFree(region->base, 0, MEM_RELEASE);
+    region->base = NULL;
+    region->reserved = 0;
+    region->committed = 0;
+    region->size = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Public Allocation and Free
+// -----------------------------------------------------------------------------
+
+/**
+ * pool_alloc
+ * Allocates a memory block of the specified size and alignment. Small requests are
+ * served from the calling thread's TLAB when TLABs are enabled, then from a promoted
+ * size-class slab in POOL_FLAG_ADAPTIVE mode; everything else goes through the shared
+ * free list, sequential allocation and expansion.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement (must be a power of 2).
+ * @return Pointer to the allocated memory (user pointer), or 0 if allocation fails.
+ */
+uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment) {
+    if (!pool || alloc_size == 0 || (alignment & (alignment - 1)) != 0)
+        return 0;
+    if (pool->tlab_index != FLS_OUT_OF_INDEXES &&
+        alloc_size + HEADER_SIZE + alignment <= pool->tlab_size / TLAB_MAX_FRACTION) {
+        uintptr_t result = tlab_alloc(pool, alloc_size, alignment);
+        if (result != 0)
+            return result;
+    }
+    if (pool->flags & POOL_FLAG_ADAPTIVE) {
+        uintptr_t result = adaptive_alloc(pool, alloc_size, alignment);
+        if (result != 0)
+            return result;
+    }
+    uintptr_t result = pool_alloc_shared(pool, alloc_size, alignment);
+    if (result == 0)
+        result = reserve_alloc(pool, alloc_size, alignment);
+    return result;
+}
+
+/**
+ * pool_alloc_near
+ * Serves the request from the PoolBlock that contains `hint`: the fitting free block
+ * closest to the hint (same page first), else sequential space in that PoolBlock.
+ * Falls back to pool_alloc when the hint is 0, foreign, or its PoolBlock is full.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement (must be a power of 2).
+ * @param hint       User pointer of a related block (e.g. the parent node), or 0.
+ * @return Pointer to the allocated memory (user pointer), or 0 if allocation fails.
+ */
+uintptr_t pool_alloc_near(Pool* pool, size_t alloc_size, size_t alignment, uintptr_t hint) {
+    if (!pool || alloc_size == 0 || (alignment & (alignment - 1)) != 0)
+        return 0;
+    if (hint != 0) {
+        uintptr_t result = 0;
+        EnterCriticalSection(&pool->lock);
+        PoolBlock* home = find_block(pool, hint);
+        if (home != NULL) {
+            acquire_free_list_lock(pool, &pool->free_list_lock);
+            result = remove_free_block_near(pool, alloc_size, alignment, home, hint);
+            release_free_list_lock(&pool->free_list_lock);
+            if (result == 0 && (pool->flags & POOL_FLAG_CONCURRENT_BUMP))
+                result = alloc_from_block_atomic((uintptr_t)home, alloc_size, alignment);
+            else if (result == 0)
+                result = alloc_from_block((uintptr_t)home, alloc_size, alignment);
+        }
+        LeaveCriticalSection(&pool->lock);
+        if (result != 0)
+            return result;
+    }
+    return pool_alloc(pool, alloc_size, alignment);
+}
+
+/**
+ * pool_alloc_lifetime
+ * Routes the request to the chain of its lifetime class; MEDIUM and pools without
+ * chains use pool_alloc. Short-chain allocations are ordered against the bulk
+ * rewind by lifetime_lock.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement (must be a power of 2).
+ * @param lifetime   One of the POOL_LIFETIME_* classes.
+ * @return Pointer to the allocated memory (user pointer), or 0 if allocation fails.
+ */
+uintptr_t pool_alloc_lifetime(Pool* pool, size_t alloc_size, size_t alignment, int lifetime) {
+    if (!pool || lifetime < 0 || lifetime >= POOL_LIFETIME_CLASSES)
+        return 0;
+    Pool* chain = pool->lifetime[lifetime];
+    if (chain == NULL)
+        return pool_alloc(pool, alloc_size, alignment);
+    uintptr_t result;
+    if (lifetime == POOL_LIFETIME_SHORT) {
+        acquire_free_list_lock(pool, &pool->lifetime_lock);
+        result = pool_alloc(chain, alloc_size, alignment);
+        if (result != 0)
+            pool->lifetime_live[lifetime]++;
+        release_free_list_lock(&pool->lifetime_lock);
+    } else {
+        result = pool_alloc(chain, alloc_size, alignment);
+        if (result != 0)
+            InterlockedIncrement64(&pool->lifetime_live[lifetime]);
+    }
+    return result;
+}
+
+/**
+ * pool_free
+ * Frees a previously allocated block. Freeing the calling thread's most recent TLAB
+ * allocation (still carrying the TLAB's owner tag) rolls the TLAB cursor back
+ * without taking any lock; blocks served by a promoted size class go back to their
+ * slab, reserve and lifetime-chain blocks to their internal pool; any other block
+ * (including one that lives in another thread's TLAB) is inserted into the shared
+ * free list and coalesced with adjacent free blocks.
+ *
+ * @param pool Pointer to the Pool structure.
+ * @param ptr  User pointer to the block to free.
+ */
+void pool_free(Pool* pool, uintptr_t ptr) {
+    if (!pool || ptr == 0)
+        return;
+    if (pool->tlab_index != FLS_OUT_OF_INDEXES) {
+        PoolTlab* tlab = (PoolTlab*)FlsGetValue(pool->tlab_index);
+        // The tag is gone if another thread freed the block meanwhile (free list
+        // link) and it was handed out again (stale link, 0, or another tag).
+        if (tlab != NULL && tlab->last == ptr && tlab->epoch == pool->tlab_epoch &&
+            ((BlockHeader*)(ptr - HEADER_SIZE))->next_free == (uintptr_t)tlab) {
+            tlab->cursor = tlab->last_raw;
+            tlab->last = 0;
+            return;
+        }
+    }
+    if ((pool->flags & POOL_FLAG_ADAPTIVE) && adaptive_free(pool, ptr))
+        return;
+    if (reserve_free(pool, ptr))
+        return;
+    if (pool->lifetime[POOL_LIFETIME_SHORT] != NULL && lifetime_free(pool, ptr))
+        return;
+    pool_free_shared(pool, ptr);
+}
+
+/**
+ * pool_set_decay
+ * Attaches page state maps to every PoolBlock and starts the decay clock. Changing
+ * the purge method or disabling decay first restores every purged page.
+ *
+ * @param pool        Pointer to the Pool structure.
+ * @param decay_ms    Decay time in milliseconds (0 disables purging).
+ * @param purge_mode  POOL_PURGE_RESET or POOL_PURGE_DECOMMIT.
+ * @return 1 on success, 0 on failure.
+ */
+int pool_set_decay(Pool* pool, size_t decay_ms, int purge_mode) {
+    if (!pool || (purge_mode != POOL_PURGE_RESET && purge_mode != POOL_PURGE_DECOMMIT))
+        return 0;
+    if ((pool->flags & POOL_FLAG_REALTIME) && decay_ms != 0)
+        return 0;
+    EnterCriticalSection(&pool->lock);
+    if (decay_ms == 0 || purge_mode != pool->purge_mode)
+        decay_restore(pool, decay_ms == 0);
+    pool->decay_ms = decay_ms;
+    pool->purge_mode = purge_mode;
+    pool->decay_tick = GetTickCount64();
+    for (uintptr_t block_ptr = pool->block_head; decay_ms != 0 && block_ptr != 0; block_ptr = ((PoolBlock*)block_ptr)->next)
+        decay_attach_block((PoolBlock*)block_ptr);
+    LeaveCriticalSection(&pool->lock);
+    return 1;
+}
+
+/**
+ * pool_decay_tick
+ * Shifts the per-step backlog by the number of elapsed steps, records the pages that
+ * became dirty since the last tick as the newest step, and purges the dirty pages
+ * that exceed the smoothstep-weighted sum of the backlog.
+ *
+ * @param pool  Pointer to the Pool structure.
+ * @return Bytes purged by this call.
+ */
+size_t pool_decay_tick(Pool* pool) {
+    if (!pool)
+        return 0;
+    size_t purged = 0;
+    EnterCriticalSection(&pool->lock);
+    if (pool->decay_ms != 0) {
+        ULONGLONG step_ms = pool->decay_ms / POOL_DECAY_STEPS;
+        if (step_ms == 0)
+            step_ms = 1;
+        ULONGLONG steps = (GetTickCount64() - pool->decay_tick) / step_ms;
+        if (steps > 0) {
+            pool->decay_tick += steps * step_ms;
+            size_t shift = steps < POOL_DECAY_STEPS ? (size_t)steps : POOL_DECAY_STEPS;
+            memmove(&pool->decay_backlog[shift], &pool->decay_backlog[0],
+                    (POOL_DECAY_STEPS - shift) * sizeof(size_t));
+            memset(pool->decay_backlog, 0, shift * sizeof(size_t));
+            acquire_free_list_lock(pool, &pool->free_list_lock);
+            pool->decay_backlog[0] = decay_scan(pool);
+            double limit = 0.0;
+            for (int age = 0; age < POOL_DECAY_STEPS; age++)
+                limit += (double)pool->decay_backlog[age] * decay_keep_fraction(age);
+            if ((double)pool->dirty_pages > limit)
+                purged = decay_purge(pool, pool->dirty_pages - (size_t)limit);
+            release_free_list_lock(&pool->free_list_lock);
+        }
+    }
+    LeaveCriticalSection(&pool->lock);
+    return purged;
+}
+
+/**
+ * pool_purge
+ * Marks and purges every dirty free page now.
+ *
+ * @param pool  Pointer to the Pool structure.
+ * @return Bytes purged.
+ */
+size_t pool_purge(Pool* pool) {
+    if (!pool)
+        return 0;
+    size_t purged = 0;
+    EnterCriticalSection(&pool->lock);
+    if (pool->decay_ms != 0) {
+        acquire_free_list_lock(pool, &pool->free_list_lock);
+        decay_scan(pool);
+        purged = decay_purge(pool, pool->dirty_pages);
+        release_free_list_lock(&pool->free_list_lock);
+    }
+    LeaveCriticalSection(&pool->lock);
+    return purged;
+}
+
+/**
+ * pool_decay_start_thread
+ * Creates the wakeup event and the background purge thread.
+ *
+ * @param pool  Pointer to the Pool structure.
+ * @return 1 on success, 0 on failure.
+ */
+int pool_decay_start_thread(Pool* pool) {
+    if (!pool || pool->decay_ms == 0 || pool->decay_thread != NULL)
+        return 0;
+    pool->decay_wakeup = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (pool->decay_wakeup == NULL)
+        return 0;
+    pool->decay_thread = CreateThread(NULL, 0, decay_thread_main, pool, 0, NULL);
+    if (pool->decay_thread == NULL) {
+        CloseHandle(pool->decay_wakeup);
+        pool->decay_wakeup = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * pool_decay_stop_thread
+ * Signals the background purge thread and waits for it to exit.
+ *
+ * @param pool  Pointer to the Pool structure.
+ */
+void pool_decay_stop_thread(Pool* pool) {
+    if (!pool || pool->decay_thread == NULL)
+        return;
+    SetEvent(pool->decay_wakeup);
+    WaitForSingleObject(pool->decay_thread, INFINITE);
+    CloseHandle(pool->decay_thread);
+    CloseHandle(pool->decay_wakeup);
+    pool->decay_thread = NULL;
+    pool->decay_wakeup = NULL;
+}
+
+/**
+ * pool_get_stats
+ * Walks the PoolBlocks and the free list under the pool lock and copies the
+ * adaptive size-class state into a PoolStats snapshot.
+ *
+ * @param pool   Pointer to the Pool structure.
+ * @param stats  Receives the snapshot.
+ */
+void pool_get_stats(Pool* pool, PoolStats* stats) {
+    if (!pool || !stats)
+        return;
+    memset(stats, 0, sizeof(*stats));
+    EnterCriticalSection(&pool->lock);
+    for (uintptr_t block_ptr = pool->block_head; block_ptr != 0; block_ptr = ((PoolBlock*)block_ptr)->next) {
+        PoolBlock* block = (PoolBlock*)block_ptr;
+        stats->block_count++;
+        stats->reserved_bytes += block->size;
+        stats->used_bytes += block->offset;
+    }
+    acquire_free_list_lock(pool, &pool->free_list_lock);
+    for (BlockHeader* cur = (BlockHeader*)pool->free_list; cur; cur = (BlockHeader*)cur->next_free) {
+        stats->free_blocks++;
+        stats->free_bytes += cur->size;
+    }
+    release_free_list_lock(&pool->free_list_lock);
+    for (int i = 0; i < POOL_ADAPTIVE_CLASSES; i++) {
+        if (pool->classes[i].size == 0)
+            continue;
+        stats->adaptive_sizes[i] = pool->classes[i].size;
+        stats->adaptive_live[i] = pool->classes[i].live;
+        stats->adaptive_classes++;
+    }
+    stats->adaptive_promotions = pool->adaptive_promotions;
+    stats->adaptive_retirements = pool->adaptive_retirements;
+    stats->adaptive_allocs = pool->adaptive_allocs;
+    stats->dirty_bytes = pool->dirty_pages * POOL_PAGE_SIZE;
+    stats->purged_bytes = pool->purged_pages * POOL_PAGE_SIZE;
+    stats->purged_bytes_total = pool->purged_bytes_total;
+    stats->purge_calls = pool->purge_calls;
+    stats->refaults = pool->refaults;
+    stats->slow_syscalls = pool->slow_syscalls;
+    stats->reserve_bytes = pool->reserve_end - pool->reserve_begin;
+    stats->reserve_used = (size_t)pool->reserve_used;
+    stats->reserve_peak = (size_t)pool->reserve_peak;
+    stats->reserve_allocs = (size_t)pool->reserve_allocs;
+    stats->reserve_failures = (size_t)pool->reserve_failures;
+    for (int lifetime = 0; lifetime < POOL_LIFETIME_CLASSES; lifetime++) {
+        Pool* chain = lifetime == POOL_LIFETIME_MEDIUM ? pool : pool->lifetime[lifetime];
+        if (chain == NULL)
+            continue;
+        for (uintptr_t block_ptr = chain->block_head; block_ptr != 0; block_ptr = ((PoolBlock*)block_ptr)->next)
+            stats->lifetime_reserved[lifetime] += ((PoolBlock*)block_ptr)->size;
+        stats->lifetime_live[lifetime] = (size_t)pool->lifetime_live[lifetime];
+    }
+    stats->lifetime_rewinds = pool->lifetime_rewinds;
+    LeaveCriticalSection(&pool->lock);
+}
+
+/**
+ * pool_reset
+ * Resets the memory pool by clearing the free list and resetting the offset
+ * of every PoolBlock. Also, the usable memory is cleared using SIMD/AVX.
+ *
+ * @param pool Pointer to the Pool structure.
+ */
+void pool_reset(Pool* pool) {
+    if (!pool)
+        return;
+    EnterCriticalSection(&pool->lock);
+    InterlockedIncrement(&pool->tlab_epoch);  // Outstanding TLAB chunks no longer exist.
+    adaptive_clear(pool);
+    decay_restore(pool, 0);  // Everything is recommitted before being cleared below.
+    acquire_free_list_lock(pool, &pool->free_list_lock);
+    pool->free_list = 0;
+    release_free_list_lock(&pool->free_list_lock);
+    uintptr_t block_ptr = pool->block_head;
+    while (block_ptr != 0) {
+        PoolBlock* block = (PoolBlock*)block_ptr;
+        block->offset = 0;
+        simd_memset((void*)block->base, 0, block->size);
+        block_ptr = block->next;
+    }
+    pool->bump_block = pool->block_head;  // Lock-free bump allocation refills the rewound blocks in order.
+    if (pool->reserve != NULL) {
+        pool_reset(pool->reserve);
+        pool->reserve_used = 0;
+    }
+    for (int lifetime = 0; lifetime < POOL_LIFETIME_CLASSES; lifetime++) {
+        if (pool->lifetime[lifetime] != NULL)
+            pool_reset(pool->lifetime[lifetime]);
+        pool->lifetime_live[lifetime] = 0;
+    }
+    LeaveCriticalSection(&pool->lock);
+}
+
+/**
+ * pool_destroy
+ * Destroys the memory pool by releasing all allocated PoolBlocks and cleaning up
+ * the synchronization primitives.
+ *
+ * @param pool Pointer to the Pool structure.
+ */
+void pool_destroy(Pool* pool) {
+    if (!pool)
+        return;
+    if (pool->tlab_index != FLS_OUT_OF_INDEXES) {
+        // Invalidate every TLAB first so the slot callbacks only release their PoolTlab.
+        InterlockedIncrement(&pool->tlab_epoch);
+        FlsFree(pool->tlab_index);
+        pool->tlab_index = FLS_OUT_OF_INDEXES;
+    }
+    pool_decay_stop_thread(pool);
+    EnterCriticalSection(&pool->lock);
+    adaptive_clear(pool);
+    // Only the initial block is ever locked (real-time pools are fixed).
+    if (pool->locked_bytes != 0)
+        unlock_block((PoolBlock*)pool->block_head, pool->locked_bytes);
+    pool->locked_bytes = 0;
+    uintptr_t block_ptr = pool->block_head;
+    while (block_ptr != 0) {
+        PoolBlock* block = (PoolBlock*)block_ptr;
+        uintptr_t next = block->next;
+        free(block->page_state);
+        VirtualFree((LPVOID)block, 0, MEM_RELEASE);
+        block_ptr = next;
+    }
+    pool->block_head = 0;
+    pool->bump_block = 0;
+    if (pool->reserve != NULL) {
+        pool_destroy(pool->reserve);
+        free(pool->reserve);
+        pool->reserve = NULL;
+        pool->reserve_begin = 0;
+        pool->reserve_end = 0;
+    }
+    for (int lifetime = 0; lifetime < POOL_LIFETIME_CLASSES; lifetime++) {
+        if (pool->lifetime[lifetime] != NULL) {
+            pool_destroy(pool->lifetime[lifetime]);
+            free(pool->lifetime[lifetime]);
+            pool->lifetime[lifetime] = NULL;
+        }
+    }
+    acquire_free_list_lock(pool, &pool->free_list_lock);
     pool->free_list = 0;
     release_free_list_lock(&pool->free_list_lock);
     LeaveCriticalSection(&pool->lock);
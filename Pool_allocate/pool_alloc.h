@@ -25,17 +25,83 @@ typedef struct BlockHeader {
 // PoolBlock structure represents one contiguous memory block allocated via VirtualAlloc.
 // The structure is stored at the beginning of the block.
 // Layout:
-//   [0:7]   : base   - usable memory starts at (base)
-//   [8:15]  : size   - total usable size (in bytes)
-//   [16:23] : offset - current allocation offset (in bytes)
-//   [24:31] : next   - pointer to next PoolBlock (stored as uintptr_t)
+//   [0:7]   : base       - usable memory starts at (base)
+//   [8:15]  : size       - total usable size (in bytes)
+//   [16:23] : offset     - current allocation offset (in bytes)
+//   [24:31] : next       - pointer to next PoolBlock (stored as uintptr_t)
+//   [32:39] : page_state - one POOL_PAGE_* byte per page overlapping the usable area (decay only)
+//   [40:47] : first_page - page number (address / POOL_PAGE_SIZE) of page_state[0]
 typedef struct PoolBlock {
     uintptr_t base;
     size_t size;
     size_t offset;
     uintptr_t next;
+    unsigned char* page_state;
+    uintptr_t first_page;
 } PoolBlock;
 
+// Page states tracked per PoolBlock while dirty-page decay is enabled.
+#define POOL_PAGE_SIZE    4096
+#define POOL_PAGE_USED    0  // Holds allocated data or headers (or is not tracked).
+#define POOL_PAGE_DIRTY   1  // Entirely inside a free block, still resident.
+#define POOL_PAGE_PURGED  2  // Entirely inside a free block, handed back to the OS.
+
+// Purge methods for pool_set_decay.
+#define POOL_PURGE_RESET     0  // VirtualAlloc(MEM_RESET): lazily discarded, stays committed (MADV_FREE).
+#define POOL_PURGE_DECOMMIT  1  // VirtualFree(MEM_DECOMMIT): released now, recommitted on reuse (MADV_DONTNEED).
+
+// Number of steps the decay curve is sampled at.
+#define POOL_DECAY_STEPS 20
+
+// Pool flags (passed to pool_init_ex).
+#define POOL_FLAG_CONCURRENT_BUMP 0x1  // Bump allocation reserves space with a CAS on PoolBlock.offset
+                                       // outside pool->lock; the lock guards free list work and expansion.
+#define POOL_FLAG_ADAPTIVE        0x2  // Sample request sizes and serve dominant sizes from internal slabs.
+#define POOL_FLAG_FIXED           0x4  // Never expand: allocations fail once the initial block is full.
+#define POOL_FLAG_REALTIME        0x8  // POOL_FLAG_FIXED + prefault and VirtualLock the initial block;
+                                       // no adaptive slabs or page decay (no syscalls after init).
+#define POOL_FLAG_BEST_FIT        0x10 // Reuse the smallest fitting free block instead of the first one.
+
+// Adaptive size-class tuning (POOL_FLAG_ADAPTIVE).
+#define POOL_ADAPTIVE_CLASSES      8     // Maximum number of sizes promoted at the same time.
+#define POOL_ADAPTIVE_MAX_SIZE     4096  // Larger requests are never promoted.
+#define POOL_ADAPTIVE_SLAB_OBJECTS 4096  // Objects per internal slab.
+#define POOL_SAMPLE_SLOTS          32    // Distinct sizes tracked per sampling window.
+#define POOL_SAMPLE_WINDOW         4096  // Allocations per sampling window.
+#define POOL_SAMPLE_STRIDE         16    // With POOL_FLAG_CONCURRENT_BUMP, one request in this many is sampled.
+
+// Lifetime classes for pool_alloc_lifetime. Every class except MEDIUM is served by
+// its own chain of PoolBlocks once pool_lifetime_init has been called.
+#define POOL_LIFETIME_SHORT      0  // Freed soon; the chain is rewound in bulk whenever it empties.
+#define POOL_LIFETIME_MEDIUM     1  // The pool's own blocks (same as pool_alloc).
+#define POOL_LIFETIME_LONG       2  // Best-fit reuse, so survivors stay densely packed.
+#define POOL_LIFETIME_PERMANENT  3  // Bump only; pool_free ignores these blocks.
+#define POOL_LIFETIME_CLASSES    4
+
+struct Slab;
+struct Pool;
+
+// Emergency reserve events passed to the PoolReserveCallback.
+#define POOL_RESERVE_ENTERED    1  // First allocation served by the reserve after it was idle.
+#define POOL_RESERVE_EXHAUSTED  2  // The reserve could not satisfy a request either.
+#define POOL_RESERVE_RECOVERED  3  // The last reserve allocation was freed.
+
+// PoolReserveCallback: called without any pool lock held, on the allocating or freeing
+// thread. `size` is the request size (0 for POOL_RESERVE_RECOVERED). The callback may
+// call pool_alloc/pool_free on the same pool.
+typedef void (*PoolReserveCallback)(struct Pool* pool, int event, size_t size, void* context);
+
+// PoolSizeClass: one request size promoted to an internal slab.
+typedef struct PoolSizeClass {
+    size_t size;                // Exact request size served (0 if the class is unused).
+    struct Slab* slab;          // Internal slab, object_size = size + slab header.
+    uintptr_t begin;            // First byte of the slab memory (for pool_free routing).
+    uintptr_t end;              // One past the last byte of the slab memory.
+    size_t live;                // Objects currently handed out.
+    size_t hits;                // Requests of this size in the current window.
+    int retiring;               // Cold: no new allocations, destroyed once live reaches 0.
+} PoolSizeClass;
+
 // Pool structure representing the entire memory pool.
 // It maintains a linked list of PoolBlock, a free list (of freed blocks), a thread lock,
 // a separate spin lock for free list operations, and the initial block size for dynamic resizing.
@@ -45,8 +111,100 @@ typedef struct Pool {
     CRITICAL_SECTION lock;      // Lock for overall pool operations.
     volatile LONG free_list_lock;  // Spin lock for free list operations (minimize contention).
     size_t initial_block_size;  // Initial block size for dynamic resizing.
+    int flags;                  // POOL_FLAG_* options chosen at initialization.
+    size_t locked_bytes;        // Bytes locked and added to the working-set quota (POOL_FLAG_REALTIME).
+    volatile uintptr_t bump_block;  // PoolBlock where lock-free bump allocation starts (newest, or the head after a reset).
+    DWORD tlab_index;           // FLS slot holding the calling thread's TLAB (FLS_OUT_OF_INDEXES if disabled).
+    size_t tlab_size;           // Bytes claimed from the pool per TLAB refill.
+    volatile LONG tlab_epoch;   // Bumped by pool_reset/pool_destroy to invalidate every live TLAB.
+    PoolSizeClass classes[POOL_ADAPTIVE_CLASSES];  // Promoted sizes (POOL_FLAG_ADAPTIVE).
+    size_t sample_sizes[POOL_SAMPLE_SLOTS];        // Sizes seen in the current window.
+    size_t sample_hits[POOL_SAMPLE_SLOTS];         // Request counts for sample_sizes.
+    size_t sample_count;                           // Requests sampled in the current window.
+    volatile LONG sample_tick;                     // Requests seen (POOL_SAMPLE_STRIDE sampling).
+    size_t adaptive_promotions;                    // Sizes promoted since init.
+    size_t adaptive_retirements;                   // Slabs retired since init.
+    size_t adaptive_allocs;                        // Requests served by promoted slabs.
+    size_t decay_ms;                               // Time for a dirty page to decay to purged (0 = off).
+    int purge_mode;                                // POOL_PURGE_RESET or POOL_PURGE_DECOMMIT.
+    ULONGLONG decay_tick;                          // Start (GetTickCount64) of the current decay step.
+    size_t decay_backlog[POOL_DECAY_STEPS];        // Pages dirtied per step, newest first.
+    size_t dirty_pages;                            // Pages currently POOL_PAGE_DIRTY.
+    size_t purged_pages;                           // Pages currently POOL_PAGE_PURGED.
+    size_t purged_bytes_total;                     // Bytes purged since init.
+    size_t purge_calls;                            // MEM_RESET/MEM_DECOMMIT system calls issued.
+    size_t refaults;                               // Purged pages handed out again.
+    HANDLE decay_thread;                           // Background purger (NULL if not running).
+    HANDLE decay_wakeup;                           // Event used to stop the background purger.
+    size_t slow_syscalls;                          // System calls made on slow paths after init.
+    struct Pool* reserve;                          // Emergency reserve pool (NULL if none).
+    uintptr_t reserve_begin;                       // First usable byte of the reserve block.
+    uintptr_t reserve_end;                         // One past the last usable byte of the reserve block.
+    PoolReserveCallback reserve_callback;          // Notified on reserve events (may be NULL).
+    void* reserve_context;                         // Passed to reserve_callback.
+    volatile LONG64 reserve_used;                  // Payload bytes currently served by the reserve.
+    volatile LONG64 reserve_peak;                  // Highest reserve_used seen.
+    volatile LONG64 reserve_allocs;                // Requests served by the reserve.
+    volatile LONG64 reserve_failures;              // Requests the reserve could not serve.
+    struct Pool* lifetime[POOL_LIFETIME_CLASSES];  // Chain per lifetime class (NULL for MEDIUM or if unused).
+    volatile LONG lifetime_lock;                   // Orders short-chain frees against its bulk rewind.
+    volatile LONG64 lifetime_live[POOL_LIFETIME_CLASSES];  // Blocks live per chain (0 for MEDIUM).
+    size_t lifetime_rewinds;                       // Times the short chain was rewound in bulk.
 } Pool;
 
+// PoolStats: snapshot returned by pool_get_stats.
+typedef struct PoolStats {
+    size_t block_count;          // PoolBlocks currently mapped.
+    size_t reserved_bytes;       // Usable bytes across all PoolBlocks.
+    size_t used_bytes;           // Sequentially allocated bytes (sum of PoolBlock offsets).
+    size_t free_blocks;          // Entries on the free list.
+    size_t free_bytes;           // Payload bytes on the free list.
+    size_t adaptive_classes;     // Sizes currently served by an internal slab.
+    size_t adaptive_sizes[POOL_ADAPTIVE_CLASSES];  // Those sizes (0 for unused slots).
+    size_t adaptive_live[POOL_ADAPTIVE_CLASSES];   // Live objects per promoted size.
+    size_t adaptive_promotions;  // Sizes promoted since init.
+    size_t adaptive_retirements; // Slabs retired since init.
+    size_t adaptive_allocs;      // Requests served by promoted slabs.
+    size_t dirty_bytes;          // Free pages still resident (decay pending).
+    size_t purged_bytes;         // Free pages currently purged.
+    size_t purged_bytes_total;   // Bytes purged since init.
+    size_t purge_calls;          // Purge system calls issued.
+    size_t refaults;             // Purged pages that were handed out again.
+    size_t slow_syscalls;        // System calls made on slow paths after init.
+    size_t reserve_bytes;        // Size of the emergency reserve (0 if none).
+    size_t reserve_used;         // Payload bytes currently served by the reserve.
+    size_t reserve_peak;         // Highest reserve_used seen.
+    size_t reserve_allocs;       // Requests served by the reserve.
+    size_t reserve_failures;     // Requests the reserve could not serve.
+    size_t lifetime_reserved[POOL_LIFETIME_CLASSES];  // Usable bytes per lifetime chain (MEDIUM: the pool).
+    size_t lifetime_live[POOL_LIFETIME_CLASSES];      // Blocks live per lifetime chain (0 for MEDIUM).
+    size_t lifetime_rewinds;     // Bulk rewinds of the short-lived chain.
+} PoolStats;
+
+// PoolRegion: a growable array that never moves. The whole maximum size is reserved
+// as address space up front; pages are committed as the region grows and
+// decommitted as it shrinks, so growth copies nothing and the base pointer stays
+// valid for the life of the region. Regions do not belong to a Pool and are not
+// thread-safe.
+typedef struct PoolRegion {
+    unsigned char* base;         // Start of the reserved range (never changes).
+    size_t reserved;             // Bytes of address space reserved.
+    size_t committed;            // Bytes committed from base (multiple of commit_chunk, or reserved).
+    size_t size;                 // Bytes in use.
+    size_t commit_chunk;         // Commit/decommit granularity.
+    size_t commits;              // MEM_COMMIT calls issued.
+    size_t decommits;            // MEM_DECOMMIT calls issued.
+} PoolRegion;
+
+// Commit granularity limits and default for pool_region_init.
+#define POOL_REGION_MIN_CHUNK      (64 * 1024)
+#define POOL_REGION_DEFAULT_CHUNK  (2 * 1024 * 1024)
+
+// TLAB chunk size limits and default for pool_tlab_enable.
+#define POOL_TLAB_MIN_SIZE      (64 * 1024)
+#define POOL_TLAB_DEFAULT_SIZE  (256 * 1024)
+#define POOL_TLAB_MAX_SIZE      (1024 * 1024)
+
 /**
  * pool_init
  * Initializes the memory pool by allocating an initial block with VirtualAlloc.
@@ -58,12 +216,46 @@ typedef struct Pool {
  */
 int pool_init(Pool* pool, size_t pool_size);
 
+/**
+ * pool_init_ex
+ * Same as pool_init, with POOL_FLAG_* options.
+ *
+ * With POOL_FLAG_CONCURRENT_BUMP, threads reserve sequential space in a PoolBlock
+ * with an atomic compare-and-swap on its offset and write the block header without
+ * holding the pool lock. The lock is only taken when the free list is non-empty
+ * or when the pool has to expand, so append-only workloads scale across threads.
+ *
+ * With POOL_FLAG_ADAPTIVE, the pool counts request sizes over windows of
+ * POOL_SAMPLE_WINDOW allocations. A size that accounts for at least 1/8 of a window
+ * is promoted to an internal slab, and later pool_alloc/pool_free calls for that size
+ * (alignment <= 16) are routed to the slab transparently. A promoted size that drops
+ * below 1/64 of a window stops receiving allocations and its slab is destroyed
+ * once its last object is freed. Promotions and retirements appear in pool_get_stats.
+ * Combined with POOL_FLAG_CONCURRENT_BUMP, requests for sizes that are not promoted
+ * stay off the pool lock: only one in POOL_SAMPLE_STRIDE of them is sampled (under
+ * the lock), and a window then spans POOL_SAMPLE_WINDOW sampled requests.
+ *
+ * With POOL_FLAG_REALTIME, the initial block is touched and locked into physical
+ * memory before pool_init_ex returns, the pool never expands (pool_alloc returns 0
+ * once the block is exhausted), and features that map or unmap memory later
+ * (adaptive slabs, page decay) are refused. System calls made on slow paths after
+ * init are counted in PoolStats.slow_syscalls; building with POOL_REALTIME_ASSERT
+ * defined makes any such call in a real-time pool abort the process.
+ *
+ * @param pool       Pointer to a Pool structure.
+ * @param pool_size  Size of the initial usable memory block (in bytes).
+ * @param flags      Combination of POOL_FLAG_* values.
+ * @return           1 on success, 0 on failure.
+ */
+int pool_init_ex(Pool* pool, size_t pool_size, int flags);
+
 /**
  * pool_alloc
  * Allocates a memory block of the requested size with the specified alignment.
- * The function first checks the free list (using best-fit selection with splitting)
- * for a suitable block, then attempts sequential allocation from existing pool blocks,
- * and finally dynamically allocates a new block if needed.
+ * The function first checks the free list (first-fit, or best-fit with
+ * POOL_FLAG_BEST_FIT, splitting the block) for a suitable block, then attempts
+ * sequential allocation from existing pool blocks, and finally dynamically
+ * allocates a new block if needed.
  *
  * A 24-byte header is stored immediately before the returned block.
  *
@@ -74,6 +266,39 @@ int pool_init(Pool* pool, size_t pool_size);
  */
 uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment);
 
+/**
+ * pool_alloc_near
+ * Allocates memory close to an existing block so related objects (e.g. tree
+ * children and their parent) share pages and cache lines. Within the PoolBlock that
+ * contains the hint, the fitting free block nearest to the hint is taken (a block
+ * in the hint's page ends the search), otherwise sequential space of that PoolBlock
+ * is used; if neither fits, this behaves like pool_alloc.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement (must be a power of 2).
+ * @param hint       User pointer of a related block, or 0.
+ * @return           Pointer to the allocated memory, or 0 if allocation fails.
+ */
+uintptr_t pool_alloc_near(Pool* pool, size_t alloc_size, size_t alignment, uintptr_t hint);
+
+/**
+ * pool_alloc_lifetime
+ * Allocates with a lifetime hint so that objects which die together share blocks.
+ * Mixing lifetimes is what fragments a heap: a few long-lived objects pin PoolBlocks
+ * full of freed short-lived gaps. After pool_lifetime_init, POOL_LIFETIME_SHORT,
+ * POOL_LIFETIME_LONG and POOL_LIFETIME_PERMANENT requests go to separate chains of
+ * PoolBlocks; POOL_LIFETIME_MEDIUM (and every class before pool_lifetime_init) is
+ * served like pool_alloc. pool_free routes blocks back to their chain.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param alloc_size Number of bytes requested.
+ * @param alignment  Alignment requirement (must be a power of 2).
+ * @param lifetime   One of the POOL_LIFETIME_* classes.
+ * @return           Pointer to the allocated memory, or 0 if allocation fails.
+ */
+uintptr_t pool_alloc_lifetime(Pool* pool, size_t alloc_size, size_t alignment, int lifetime);
+
 /**
  * pool_free
  * Frees a previously allocated memory block by adding it to the pool's free list.
@@ -83,6 +308,182 @@ uintptr_t pool_alloc(Pool* pool, size_t alloc_size, size_t alignment);
  */
 void pool_free(Pool* pool, uintptr_t ptr);
 
+/**
+ * pool_tlab_enable
+ * Enables thread-local allocation buffers. Each thread claims a chunk of tlab_size
+ * bytes from the pool and serves small pool_alloc requests from it by bumping a
+ * private cursor with no lock or atomic operation; when the chunk runs out, its tail
+ * is returned to the free list and a new chunk is claimed.
+ *
+ * Objects carved from a TLAB carry the usual 24-byte header, so any thread may
+ * pool_free them: a free of the owning thread's most recent allocation rolls the
+ * cursor back, every other free goes to the shared free list. The unused tail of a
+ * thread's TLAB is returned automatically when the thread exits.
+ *
+ * @param pool       Pointer to the Pool structure.
+ * @param tlab_size  Chunk size in bytes (0 for POOL_TLAB_DEFAULT_SIZE), clamped to
+ *                   [POOL_TLAB_MIN_SIZE, POOL_TLAB_MAX_SIZE].
+ * @return           1 on success, 0 on failure.
+ */
+int pool_tlab_enable(Pool* pool, size_t tlab_size);
+
+/**
+ * pool_tlab_flush
+ * Returns the unused tail of the calling thread's TLAB to the pool now, instead of
+ * waiting for thread exit. The next small allocation claims a fresh chunk.
+ *
+ * @param pool  Pointer to the Pool structure.
+ */
+void pool_tlab_flush(Pool* pool);
+
+/**
+ * pool_set_decay
+ * Enables time-based purging of dirty free pages. A page becomes dirty when it lies
+ * entirely inside a free block. Along a smoothstep curve over decay_ms, the number
+ * of dirty pages allowed to stay resident falls to zero, and the excess is purged
+ * with the chosen method. Purging runs in slow paths (pool_free, expansion), from
+ * pool_decay_tick, or on a background thread (pool_decay_start_thread).
+ *
+ * @param pool        Pointer to the Pool structure.
+ * @param decay_ms    Decay time in milliseconds (0 disables purging and recommits
+ *                    any decommitted pages).
+ * @param purge_mode  POOL_PURGE_RESET or POOL_PURGE_DECOMMIT.
+ * @return            1 on success, 0 on failure.
+ */
+int pool_set_decay(Pool* pool, size_t decay_ms, int purge_mode);
+
+/**
+ * pool_decay_tick
+ * Advances the decay curve and purges dirty pages above the current limit.
+ * Does nothing until at least one decay step has elapsed.
+ *
+ * @param pool  Pointer to the Pool structure.
+ * @return      Bytes purged by this call.
+ */
+size_t pool_decay_tick(Pool* pool);
+
+/**
+ * pool_purge
+ * Purges every dirty free page immediately, ignoring the decay curve.
+ *
+ * @param pool  Pointer to the Pool structure.
+ * @return      Bytes purged.
+ */
+size_t pool_purge(Pool* pool);
+
+/**
+ * pool_decay_start_thread
+ * Starts a background thread that calls pool_decay_tick once per decay step.
+ *
+ * @param pool  Pointer to the Pool structure (decay must be enabled).
+ * @return      1 on success, 0 on failure.
+ */
+int pool_decay_start_thread(Pool* pool);
+
+/**
+ * pool_decay_stop_thread
+ * Stops the background purge thread, if running. Called by pool_destroy.
+ *
+ * @param pool  Pointer to the Pool structure.
+ */
+void pool_decay_stop_thread(Pool* pool);
+
+/**
+ * pool_reserve_init
+ * Sets aside an emergency region of reserve_size bytes, committed and touched now.
+ * pool_alloc falls back to it only after the normal path (including expansion) has
+ * failed, so error handling can still allocate under memory pressure. The region is
+ * a fixed-size internal pool; pool_free returns its blocks automatically.
+ *
+ * @param pool          Pointer to the Pool structure.
+ * @param reserve_size  Size of the emergency region in bytes.
+ * @param callback      Notified on POOL_RESERVE_* events (may be NULL).
+ * @param context       Passed to the callback.
+ * @return 1 on success, 0 on failure (or if a reserve already exists).
+ */
+int pool_reserve_init(Pool* pool, size_t reserve_size, PoolReserveCallback callback, void* context);
+
+/**
+ * pool_lifetime_init
+ * Creates the short, long and permanent lifetime chains, each starting with a
+ * PoolBlock of chain_size bytes and growing like the pool (fixed and real-time
+ * pools get fixed chains). The short chain is rewound in bulk whenever its last
+ * block is freed, the long chain reuses free blocks best-fit, and the permanent
+ * chain only bumps.
+ *
+ * @param pool        Pointer to the Pool structure.
+ * @param chain_size  Initial block size of each chain in bytes.
+ * @return 1 on success, 0 on failure (or if the chains already exist).
+ */
+int pool_lifetime_init(Pool* pool, size_t chain_size);
+
+/**
+ * pool_lifetime_reset
+ * Drops every block of one lifetime chain at once, e.g. the short chain at the end
+ * of a request even if some blocks were never freed. The caller guarantees none of
+ * them is used afterwards. POOL_LIFETIME_MEDIUM is not a chain and is ignored.
+ *
+ * @param pool      Pointer to the Pool structure.
+ * @param lifetime  POOL_LIFETIME_SHORT, POOL_LIFETIME_LONG or POOL_LIFETIME_PERMANENT.
+ */
+void pool_lifetime_reset(Pool* pool, int lifetime);
+
+/**
+ * pool_region_init
+ * Reserves max_size bytes (rounded up to 64K) of address space for a growable
+ * region. Nothing is committed until the region grows.
+ *
+ * @param region        Pointer to a PoolRegion structure.
+ * @param max_size      Largest size the region can ever reach.
+ * @param commit_chunk  Commit granularity (0 for POOL_REGION_DEFAULT_CHUNK; rounded up
+ *                      to a multiple of POOL_REGION_MIN_CHUNK).
+ * @return 1 on success, 0 on failure.
+ */
+int pool_region_init(PoolRegion* region, size_t max_size, size_t commit_chunk);
+
+/**
+ * pool_region_resize
+ * Sets the size of the region. Growing commits whole chunks past the committed end;
+ * shrinking decommits the chunks that lie more than one chunk past the new end
+ * (the spare chunk keeps a size oscillating around a boundary from thrashing).
+ * Contents below min(old size, new size) are preserved; newly committed pages read
+ * as zero, but bytes re-exposed inside still-committed pages keep old data.
+ *
+ * @param region  Pointer to the PoolRegion structure.
+ * @param size    New size in bytes.
+ * @return 1 on success, 0 if size exceeds the reservation or the commit failed.
+ */
+int pool_region_resize(PoolRegion* region, size_t size);
+
+/**
+ * pool_region_extend
+ * Grows the region by `bytes`, e.g. to append elements to an array living in it.
+ *
+ * @param region  Pointer to the PoolRegion structure.
+ * @param bytes   Number of bytes to append.
+ * @return Pointer to the first appended byte, or NULL on failure.
+ */
+void* pool_region_extend(PoolRegion* region, size_t bytes);
+
+/**
+ * pool_region_destroy
+ * Releases the whole reserved range.
+ *
+ * @param region  Pointer to the PoolRegion structure.
+ */
+void pool_region_destroy(PoolRegion* region);
+
+/**
+ * pool_get_stats
+ * Fills a PoolStats snapshot (block usage, free list, adaptive size classes,
+ * purged bytes, page refaults, slow-path system calls, emergency reserve usage and
+ * lifetime chains).
+ *
+ * @param pool   Pointer to the Pool structure.
+ * @param stats  Receives the snapshot.
+ */
+void pool_get_stats(Pool* pool, PoolStats* stats);
+
 /**
  * pool_reset
  * Resets the memory pool by setting all pool blocks' offsets to 0,
@@ -0,0 +1,235 @@
+// rcbuf_alloc.c
+
+#include "rcbuf_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Remote Free Stack
+// -----------------------------------------------------------------------------
+
+/**
+ * remote_push
+ * Pushes a dead buffer onto the pool's remote free stack (any thread).
+ */
+static void remote_push(RcBufPool* pool, RcBuf* buf) {
+    void* head;
+    do {
+        head = pool->remote_free;
+        buf->next_free = (RcBuf*)head;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&pool->remote_free, buf, head) != head);
+}
+
+/**
+ * remote_drain
+ * Takes the whole remote free stack with one exchange and returns every buffer to
+ * the slab (owner thread only).
+ *
+ * @return Number of buffers returned.
+ */
+static size_t remote_drain(RcBufPool* pool) {
+    RcBuf* buf = (RcBuf*)InterlockedExchangePointer((PVOID volatile*)&pool->remote_free, NULL);
+    size_t count = 0;
+    while (buf) {
+        RcBuf* next = buf->next_free;
+        slab_free(&pool->slab, buf);
+        buf = next;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * buffer_dead
+ * Returns a buffer whose refcount reached zero.
+ */
+static void buffer_dead(RcBuf* buf) {
+    RcBufPool* pool = buf->pool;
+    if (GetCurrentThreadId() == pool->owner_thread)
+        slab_free(&pool->slab, buf);
+    else
+        remote_push(pool, buf);
+}
+
+// -----------------------------------------------------------------------------
+// Pool Initialization and Destroy Functions
+// -----------------------------------------------------------------------------
+
+/**
+ * rcbuf_pool_init
+ * Sizes slab objects to hold the RcBuf header plus the payload.
+ *
+ * @param pool      Pointer to an RcBufPool structure.
+ * @param count     Number of buffers.
+ * @param capacity  Payload bytes per buffer.
+ * @return 1 on success, 0 on failure.
+ */
+int rcbuf_pool_init(RcBufPool* pool, size_t count, size_t capacity) {
+    if (!pool || count == 0 || capacity == 0)
+        return 0;
+    if (!slab_init(&pool->slab, count, HEADER_SIZE + sizeof(RcBuf) + capacity))
+        return 0;
+    pool->capacity = pool->slab.object_size - HEADER_SIZE - sizeof(RcBuf);
+    pool->owner_thread = GetCurrentThreadId();
+    pool->remote_free = NULL;
+    return 1;
+}
+
+/**
+ * rcbuf_pool_destroy
+ * Destroys the backing slab.
+ *
+ * @param pool  Pointer to the RcBufPool structure.
+ */
+void rcbuf_pool_destroy(RcBufPool* pool) {
+    if (!pool)
+        return;
+    slab_destroy(&pool->slab);
+    pool->remote_free = NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Buffer Allocation and Reference Counting
+// -----------------------------------------------------------------------------
+
+/**
+ * rcbuf_alloc
+ * Pops a slab object; on an empty slab, reclaims remote frees and retries once.
+ *
+ * @param pool  Pointer to the RcBufPool structure.
+ * @return New buffer with refcount 1, or NULL.
+ */
+RcBuf* rcbuf_alloc(RcBufPool* pool) {
+    if (!pool)
+        return NULL;
+    RcBuf* buf = (RcBuf*)slab_alloc(&pool->slab);
+    if (buf == NULL && pool->remote_free != NULL && remote_drain(pool) != 0)
+        buf = (RcBuf*)slab_alloc(&pool->slab);
+    if (buf == NULL)
+        return NULL;
+    buf->pool = pool;
+    buf->refcount = 1;
+    buf->shared = 0;
+    buf->length = 0;
+    buf->next_free = NULL;
+    return buf;
+}
+
+/**
+ * rcbuf_share
+ * Sets the shared flag; the publishing queue provides the ordering.
+ *
+ * @param buf  Buffer owned by the calling thread.
+ */
+void rcbuf_share(RcBuf* buf) {
+    if (buf)
+        buf->shared = 1;
+}
+
+/**
+ * rcbuf_retain
+ * Plain increment for private buffers, InterlockedIncrement for shared ones.
+ *
+ * @param buf  Buffer.
+ */
+void rcbuf_retain(RcBuf* buf) {
+    if (!buf)
+        return;
+    if (buf->shared)
+        InterlockedIncrement(&buf->refcount);
+    else
+        buf->refcount++;
+}
+
+/**
+ * rcbuf_release
+ * Plain or interlocked decrement; the reference that reaches zero frees the buffer.
+ *
+ * @param buf  Buffer.
+ */
+void rcbuf_release(RcBuf* buf) {
+    if (!buf)
+        return;
+    LONG remaining;
+    if (buf->shared)
+        remaining = InterlockedDecrement(&buf->refcount);
+    else
+        remaining = --buf->refcount;
+    if (remaining == 0)
+        buffer_dead(buf);
+}
+
+// -----------------------------------------------------------------------------
+// Slices
+// -----------------------------------------------------------------------------
+
+/**
+ * rcbuf_slice
+ * Clamps the view to the payload and retains the buffer.
+ *
+ * @param buf     Buffer.
+ * @param offset  Start of the view.
+ * @param length  Length of the view.
+ * @return The slice (buf == NULL on a bad offset).
+ */
+RcSlice rcbuf_slice(RcBuf* buf, size_t offset, size_t length) {
+    RcSlice slice = {NULL, 0, 0};
+    if (!buf || offset > buf->length)
+        return slice;
+    if (length > buf->length - offset)
+        length = buf->length - offset;
+    rcbuf_retain(buf);
+    slice.buf = buf;
+    slice.offset = offset;
+    slice.length = length;
+    return slice;
+}
+
+/**
+ * rcslice_sub
+ * Clamps the view to the source slice and retains the buffer.
+ *
+ * @param slice   Source slice.
+ * @param offset  Start relative to the source slice.
+ * @param length  Length of the view.
+ * @return The slice (buf == NULL on a bad offset).
+ */
+RcSlice rcslice_sub(const RcSlice* slice, size_t offset, size_t length) {
+    RcSlice sub = {NULL, 0, 0};
+    if (!slice || !slice->buf || offset > slice->length)
+        return sub;
+    if (length > slice->length - offset)
+        length = slice->length - offset;
+    rcbuf_retain(slice->buf);
+    sub.buf = slice->buf;
+    sub.offset = slice->offset + offset;
+    sub.length = length;
+    return sub;
+}
+
+/**
+ * rcslice_data
+ * Returns buf->data + offset.
+ *
+ * @param slice  Slice.
+ */
+unsigned char* rcslice_data(const RcSlice* slice) {
+    if (!slice || !slice->buf)
+        return NULL;
+    return slice->buf->data + slice->offset;
+}
+
+/**
+ * rcslice_release
+ * Releases the buffer reference and clears the slice.
+ *
+ * @param slice  Slice.
+ */
+void rcslice_release(RcSlice* slice) {
+    if (!slice || !slice->buf)
+        return;
+    rcbuf_release(slice->buf);
+    slice->buf = NULL;
+    slice->offset = 0;
+    slice->length = 0;
+}
@@ -0,0 +1,143 @@
+// rcbuf_alloc.h
+
+#ifndef RCBUF_ALLOC_H
+#define RCBUF_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <windows.h>
+#include "slab_alloc.h"
+
+// RcBufPool structure: a Slab of fixed-capacity refcounted buffers owned by one thread.
+// Only the owner calls slab_alloc/slab_free. When the last reference to a shared buffer
+// is dropped on another thread, the buffer is pushed onto remote_free (lock-free stack)
+// and the owner hands it back to the slab with slab_free the next time it runs dry.
+typedef struct RcBufPool {
+    Slab slab;                   // Backing slab; one RcBuf per object.
+    size_t capacity;             // Payload bytes per buffer.
+    DWORD owner_thread;          // Thread that created the pool.
+    void* volatile remote_free;  // Buffers released by other threads (linked through RcBuf.next_free).
+} RcBufPool;
+
+// RcBuf structure, stored at the start of each slab object (after HEADER_SIZE).
+// refcount is updated with plain loads/stores until rcbuf_share marks the buffer
+// shared; from then on every retain/release is an interlocked operation.
+typedef struct RcBuf {
+    RcBufPool* pool;             // Owning pool.
+    volatile LONG refcount;      // Number of live references (buffer + slices).
+    LONG shared;                 // Nonzero once references may cross threads.
+    size_t length;               // Bytes of valid payload.
+    struct RcBuf* next_free;     // Link on the pool's remote free stack.
+    unsigned char data[] __attribute__((aligned(16)));  // Payload (capacity bytes).
+} RcBuf;
+
+// RcSlice structure: a view [offset, offset + length) of an RcBuf that holds one reference.
+typedef struct RcSlice {
+    RcBuf* buf;
+    size_t offset;
+    size_t length;
+} RcSlice;
+
+/**
+ * rcbuf_pool_init
+ * Creates a pool of `count` buffers with `capacity` payload bytes each. The calling
+ * thread becomes the owner.
+ *
+ * @param pool      Pointer to an RcBufPool structure.
+ * @param count     Number of buffers.
+ * @param capacity  Payload bytes per buffer.
+ * @return 1 on success, 0 on failure.
+ */
+int rcbuf_pool_init(RcBufPool* pool, size_t count, size_t capacity);
+
+/**
+ * rcbuf_alloc
+ * Takes a buffer with refcount 1 (owner thread only). Drains the remote free stack
+ * when the slab is empty.
+ *
+ * @param pool  Pointer to the RcBufPool structure.
+ * @return New buffer, or NULL if every buffer is referenced.
+ */
+RcBuf* rcbuf_alloc(RcBufPool* pool);
+
+/**
+ * rcbuf_share
+ * Switches the buffer to atomic reference counting. Call before handing a reference
+ * to another thread.
+ *
+ * @param buf  Buffer owned by the calling thread.
+ */
+void rcbuf_share(RcBuf* buf);
+
+/**
+ * rcbuf_retain
+ * Adds a reference.
+ *
+ * @param buf  Buffer.
+ */
+void rcbuf_retain(RcBuf* buf);
+
+/**
+ * rcbuf_release
+ * Drops a reference. The last release returns the object with slab_free (or queues
+ * it for the owner when called from another thread).
+ *
+ * @param buf  Buffer.
+ */
+void rcbuf_release(RcBuf* buf);
+
+/**
+ * rcbuf_slice
+ * Creates a view of part of a buffer and adds a reference for it.
+ *
+ * @param buf     Buffer.
+ * @param offset  Start of the view within the payload.
+ * @param length  Length of the view (clamped to the payload).
+ * @return The slice; slice.buf is NULL if offset is past the payload.
+ */
+RcSlice rcbuf_slice(RcBuf* buf, size_t offset, size_t length);
+
+/**
+ * rcslice_sub
+ * Creates a narrower view of an existing slice (adds a reference).
+ *
+ * @param slice   Source slice.
+ * @param offset  Start relative to the source slice.
+ * @param length  Length (clamped to the source slice).
+ * @return The slice; slice.buf is NULL if offset is past the source slice.
+ */
+RcSlice rcslice_sub(const RcSlice* slice, size_t offset, size_t length);
+
+/**
+ * rcslice_data
+ * Returns a pointer to the first byte of the slice.
+ *
+ * @param slice  Slice.
+ */
+unsigned char* rcslice_data(const RcSlice* slice);
+
+/**
+ * rcslice_release
+ * Drops the slice's reference and clears it.
+ *
+ * @param slice  Slice.
+ */
+void rcslice_release(RcSlice* slice);
+
+/**
+ * rcbuf_pool_destroy
+ * Destroys the backing slab (owner thread only; outstanding references become invalid).
+ *
+ * @param pool  Pointer to the RcBufPool structure.
+ */
+void rcbuf_pool_destroy(RcBufPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RCBUF_ALLOC_H
@@ -0,0 +1,126 @@
+// bench_ring.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+#include "ring_alloc.h"
+
+#define WINDOW 256           // Messages in flight before the oldest is released.
+#define PRODUCERS 4          // Threads used by the MPSC benchmark.
+
+static const int iterations = 1000000;  // 1 million messages.
+
+// Message size for iteration i (64..1024 bytes, deterministic).
+static size_t message_size(int i) {
+    return 64 + (size_t)((i * 2654435761u) >> 22) % 961;
+}
+
+// FIFO churn through a ring: allocate, keep WINDOW messages in flight, release oldest.
+static double bench_ring_fifo(Ring* ring, LARGE_INTEGER frequency) {
+    void* window[WINDOW] = {0};
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        int slot = i % WINDOW;
+        if (window[slot])
+            ring_release(ring, window[slot]);
+        window[slot] = ring_alloc(ring, message_size(i));
+        if (window[slot] == NULL) {
+            printf("Ring allocation failed at iteration %d.\n", i);
+            break;
+        }
+        *(volatile int*)window[slot] = i;
+    }
+    QueryPerformanceCounter(&end);
+    for (int i = 0; i < WINDOW; i++)
+        ring_release(ring, window[i]);
+    ring_reclaim(ring);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// Same churn through malloc/free for comparison.
+static double bench_malloc_fifo(LARGE_INTEGER frequency) {
+    void* window[WINDOW] = {0};
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        int slot = i % WINDOW;
+        free(window[slot]);
+        window[slot] = malloc(message_size(i));
+        *(volatile int*)window[slot] = i;
+    }
+    QueryPerformanceCounter(&end);
+    for (int i = 0; i < WINDOW; i++)
+        free(window[i]);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// MPSC producer: allocate and release in arrival order.
+static DWORD WINAPI mpsc_producer(LPVOID arg) {
+    Ring* ring = (Ring*)arg;
+    for (int i = 0; i < iterations; i++) {
+        void* msg = ring_alloc(ring, message_size(i));
+        while (msg == NULL) {
+            Sleep(0);
+            msg = ring_alloc(ring, message_size(i));
+        }
+        *(volatile int*)msg = i;
+        ring_release(ring, msg);
+    }
+    return 0;
+}
+
+int main(void) {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    // Benchmark SPSC ring vs malloc/free.
+    Ring ring;
+    if (!ring_init(&ring, 1024 * 1024, RING_SPSC)) {
+        printf("Ring initialization failed.\n");
+        return 1;
+    }
+    printf("Ring initialized: capacity = %zu bytes\n", ring.capacity);
+    double ringTime = bench_ring_fifo(&ring, frequency);
+    printf("SPSC ring FIFO churn, %d messages: %.6f seconds (%.2f ops/sec)\n",
+           iterations, ringTime, iterations / ringTime);
+    ring_destroy(&ring);
+
+    // Benchmark the double-mapped (magic) ring.
+    if (ring_init(&ring, 1024 * 1024, RING_SPSC | RING_MAGIC)) {
+        double magicTime = bench_ring_fifo(&ring, frequency);
+        printf("Magic ring FIFO churn, %d messages: %.6f seconds (%.2f ops/sec)\n",
+               iterations, magicTime, iterations / magicTime);
+        ring_destroy(&ring);
+    } else {
+        printf("Magic ring mapping unavailable.\n");
+    }
+
+    double mallocTime = bench_malloc_fifo(frequency);
+    printf("malloc/free FIFO churn, %d messages: %.6f seconds (%.2f ops/sec)\n",
+           iterations, mallocTime, iterations / mallocTime);
+
+    // Benchmark MPSC with several producer threads.
+    if (!ring_init(&ring, 4 * 1024 * 1024, RING_MPSC)) {
+        printf("MPSC ring initialization failed.\n");
+        return 1;
+    }
+    HANDLE threads[PRODUCERS];
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int t = 0; t < PRODUCERS; t++)
+        threads[t] = CreateThread(NULL, 0, mpsc_producer, &ring, 0, NULL);
+    WaitForMultipleObjects(PRODUCERS, threads, TRUE, INFINITE);
+    QueryPerformanceCounter(&end);
+    for (int t = 0; t < PRODUCERS; t++)
+        CloseHandle(threads[t]);
+    double mpscTime = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    printf("MPSC ring, %d producers x %d messages: %.6f seconds (%.2f ops/sec)\n",
+           PRODUCERS, iterations, mpscTime, (double)PRODUCERS * iterations / mpscTime);
+    ring_reclaim(&ring);
+    printf("Ring bytes in use after reclaim: %zu\n", ring_used(&ring));
+    ring_destroy(&ring);
+    printf("Ring destroyed.\n");
+
+    return 0;
+}
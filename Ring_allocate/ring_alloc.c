@@ -0,0 +1,243 @@
+// ring_alloc.c
+
+#include "ring_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// -----------------------------------------------------------------------------
+// Constants and Macros
+// -----------------------------------------------------------------------------
+
+// RECORD_SIZE: Size of the RingRecord header (records are 16-byte aligned).
+#define RECORD_SIZE ((LONG64)sizeof(RingRecord))
+
+// MAGIC_MAP_ATTEMPTS: Retries when another thread grabs the reserved address range
+// between releasing the placeholder reservation and mapping the two views.
+#define MAGIC_MAP_ATTEMPTS 16
+
+// -----------------------------------------------------------------------------
+// Mapping Helpers
+// -----------------------------------------------------------------------------
+
+/**
+ * round_capacity
+ * Rounds the requested capacity up to a power of 2 that is at least the system
+ * allocation granularity (views must start on a granularity boundary).
+ *
+ * @param capacity Requested size in bytes.
+ * @return The rounded capacity, or 0 on overflow.
+ */
+static size_t round_capacity(size_t capacity) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    size_t rounded = info.dwAllocationGranularity;
+    while (rounded < capacity) {
+        if (rounded > ((size_t)-1 >> 1))
+            return 0;
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+/**
+ * map_magic_views
+ * Maps the section twice at adjacent addresses. A free address range of twice the
+ * capacity is found with a reserve/release pair, then both views are placed in it.
+ *
+ * @param ring Pointer to the Ring structure (mappingHandle and capacity set).
+ * @return Base address of the first view, or NULL on failure.
+ */
+static unsigned char* map_magic_views(Ring* ring) {
+    size_t capacity = ring->capacity;
+    for (int attempt = 0; attempt < MAGIC_MAP_ATTEMPTS; attempt++) {
+        unsigned char* base = (unsigned char*)VirtualAlloc(NULL, capacity * 2, MEM_RESERVE, PAGE_NOACCESS);
+        if (base == NULL)
+            return NULL;
+        VirtualFree(base, 0, MEM_RELEASE);
+        unsigned char* first = (unsigned char*)MapViewOfFileEx(ring->mappingHandle, FILE_MAP_ALL_ACCESS,
+                                                               0, 0, capacity, base);
+        if (first == NULL)
+            continue;
+        unsigned char* second = (unsigned char*)MapViewOfFileEx(ring->mappingHandle, FILE_MAP_ALL_ACCESS,
+                                                                0, 0, capacity, base + capacity);
+        if (second == NULL) {
+            UnmapViewOfFile(first);
+            continue;
+        }
+        return first;
+    }
+    return NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Ring Initialization, Allocation, Release, Reclaim, and Destroy Functions
+// -----------------------------------------------------------------------------
+
+/**
+ * ring_init
+ * Creates a pagefile-backed section of the rounded capacity and maps it once, or
+ * twice back to back in magic mode.
+ *
+ * @param ring      Pointer to a Ring structure.
+ * @param capacity  Requested size in bytes.
+ * @param flags     RING_* flags.
+ * @return 1 on success, 0 on failure.
+ */
+int ring_init(Ring* ring, size_t capacity, int flags) {
+    if (!ring || capacity == 0)
+        return 0;
+    ring->capacity = round_capacity(capacity);
+    if (ring->capacity == 0)
+        return 0;
+    ring->flags = flags;
+    ring->head = 0;
+    ring->tail = 0;
+
+    ring->mappingHandle = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                            (DWORD)((unsigned long long)ring->capacity >> 32),
+                                            (DWORD)ring->capacity, NULL);
+    if (ring->mappingHandle == NULL)
+        return 0;
+    if (flags & RING_MAGIC)
+        ring->memory = map_magic_views(ring);
+    else
+        ring->memory = (unsigned char*)MapViewOfFile(ring->mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, ring->capacity);
+    if (ring->memory == NULL) {
+        CloseHandle(ring->mappingHandle);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * ring_alloc
+ * Reserves header + payload at the head. Without the magic mapping, a record that
+ * would cross the end of the ring is preceded by a released pad record that fills
+ * the remainder, so the payload always starts at the beginning of the ring instead.
+ *
+ * @param ring  Pointer to the Ring structure.
+ * @param size  Number of payload bytes.
+ * @return Pointer to the payload, or NULL if the ring is full.
+ */
+void* ring_alloc(Ring* ring, size_t size) {
+    if (!ring || size == 0 || size > ring->capacity)
+        return NULL;
+    LONG64 capacity = (LONG64)ring->capacity;
+    LONG64 mask = capacity - 1;
+    LONG64 need = (RECORD_SIZE + (LONG64)size + 15) & ~(LONG64)15;
+    if (need > capacity)
+        return NULL;
+
+    for (;;) {
+        LONG64 head = ring->head;
+        LONG64 tail = ring->tail;
+        LONG64 offset = head & mask;
+        LONG64 pad = 0;
+        if (!(ring->flags & RING_MAGIC) && offset + need > capacity)
+            pad = capacity - offset;
+        LONG64 total = pad + need;
+
+        if (head + total - tail > capacity) {
+            // Full: reclaim released records, give up only if nothing moved.
+            if (ring_reclaim(ring) == 0 && ring->tail == tail && ring->head == head)
+                return NULL;
+            continue;
+        }
+
+        if (ring->flags & RING_MPSC) {
+            if (InterlockedCompareExchange64(&ring->head, head + total, head) != head)
+                continue;
+        } else {
+            ring->head = head + total;
+        }
+
+        if (pad) {
+            RingRecord* filler = (RingRecord*)(ring->memory + offset);
+            filler->size = (size_t)pad;
+            InterlockedExchange64(&filler->seq, (head << 1) | 1);
+        }
+        LONG64 position = head + pad;
+        RingRecord* record = (RingRecord*)(ring->memory + (position & mask));
+        record->size = (size_t)need;
+        record->seq = position << 1;
+        return (void*)(record + 1);
+    }
+}
+
+/**
+ * ring_release
+ * Sets the released bit in the record header with a single atomic OR.
+ *
+ * @param ring  Pointer to the Ring structure.
+ * @param ptr   Payload pointer returned by ring_alloc.
+ */
+void ring_release(Ring* ring, void* ptr) {
+    if (!ring || ptr == NULL)
+        return;
+    RingRecord* record = (RingRecord*)ptr - 1;
+    InterlockedOr64(&record->seq, 1);
+}
+
+/**
+ * ring_reclaim
+ * Walks from the tail while the record at the tail carries the released tag for
+ * that exact position. Stale headers from a previous lap carry another position
+ * and stop the walk. In MPSC mode the tail is advanced with a CAS so concurrent
+ * reclaimers cannot skip a record twice.
+ *
+ * @param ring  Pointer to the Ring structure.
+ * @return Number of bytes returned to the ring.
+ */
+size_t ring_reclaim(Ring* ring) {
+    if (!ring)
+        return 0;
+    LONG64 mask = (LONG64)ring->capacity - 1;
+    size_t reclaimed = 0;
+    for (;;) {
+        LONG64 tail = ring->tail;
+        if (tail >= ring->head)
+            break;
+        RingRecord* record = (RingRecord*)(ring->memory + (tail & mask));
+        if (record->seq != ((tail << 1) | 1))
+            break;
+        LONG64 size = (LONG64)record->size;
+        if (ring->flags & RING_MPSC) {
+            if (InterlockedCompareExchange64(&ring->tail, tail + size, tail) != tail)
+                continue;
+        } else {
+            ring->tail = tail + size;
+        }
+        reclaimed += (size_t)size;
+    }
+    return reclaimed;
+}
+
+/**
+ * ring_used
+ * Returns head - tail.
+ *
+ * @param ring  Pointer to the Ring structure.
+ */
+size_t ring_used(Ring* ring) {
+    if (!ring)
+        return 0;
+    return (size_t)(ring->head - ring->tail);
+}
+
+/**
+ * ring_destroy
+ * Unmaps both views (magic mode) or the single view, and closes the section handle.
+ *
+ * @param ring  Pointer to the Ring structure.
+ */
+void ring_destroy(Ring* ring) {
+    if (!ring || ring->memory == NULL)
+        return;
+    if (ring->flags & RING_MAGIC)
+        UnmapViewOfFile(ring->memory + ring->capacity);
+    UnmapViewOfFile(ring->memory);
+    CloseHandle(ring->mappingHandle);
+    ring->memory = NULL;
+    ring->head = 0;
+    ring->tail = 0;
+}
@@ -0,0 +1,109 @@
+// ring_alloc.h
+
+#ifndef RING_ALLOC_H
+#define RING_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <windows.h>
+
+// Ring flags (passed to ring_init).
+#define RING_SPSC   0x0  // Single producer: head is advanced with a plain store.
+#define RING_MPSC   0x1  // Multiple producers: head is advanced with a CAS loop.
+#define RING_MAGIC  0x2  // Double-map the region so records never wrap.
+
+// RingRecord structure (16 bytes), stored immediately before every record.
+// Layout:
+//   [0:7]   : size - reserved bytes for this record (header + payload, 16-byte aligned)
+//   [8:15]  : seq  - (position << 1) while in use, (position << 1) | 1 once released
+// Pad records inserted at the end of a non-magic ring carry no payload and are
+// released as soon as they are written.
+typedef struct RingRecord {
+    size_t size;
+    volatile LONG64 seq;
+} RingRecord;
+
+// Ring structure representing a FIFO allocator over a mapped region.
+// head and tail are monotonic byte positions; the physical offset is (position & (capacity - 1)).
+// Producers bump head, reclaim bumps tail over contiguous released records.
+// head and tail live on separate cache lines so producers and releasers do not share a line.
+typedef struct Ring {
+    unsigned char* memory;       // Base address of the mapped ring (2 * capacity mapped in magic mode).
+    size_t capacity;             // Usable size in bytes (power of 2, multiple of the allocation granularity).
+    int flags;                   // RING_* flags.
+    HANDLE mappingHandle;        // Handle of the pagefile-backed section.
+    volatile LONG64 head __attribute__((aligned(64)));  // Next position to reserve (producers).
+    volatile LONG64 tail __attribute__((aligned(64)));  // Oldest position not yet reclaimed.
+} Ring;
+
+/**
+ * ring_init
+ * Creates the ring by mapping a pagefile-backed section. With RING_MAGIC the section
+ * is mapped twice back to back, so a record that crosses the end of the ring is still
+ * contiguous in virtual memory.
+ *
+ * @param ring      Pointer to a Ring structure.
+ * @param capacity  Requested size in bytes (rounded up to a power of 2 and to the
+ *                  allocation granularity).
+ * @param flags     Combination of RING_SPSC/RING_MPSC and RING_MAGIC.
+ * @return 1 on success, 0 on failure.
+ */
+int ring_init(Ring* ring, size_t capacity, int flags);
+
+/**
+ * ring_alloc
+ * Reserves a record of the requested size at the head of the ring. When the ring is
+ * full, completed records are reclaimed first; if there is still no room, NULL is
+ * returned. Lock-free in both SPSC and MPSC mode.
+ *
+ * @param ring  Pointer to the Ring structure.
+ * @param size  Number of payload bytes.
+ * @return Pointer to the payload (16-byte aligned), or NULL if the ring is full.
+ */
+void* ring_alloc(Ring* ring, size_t size);
+
+/**
+ * ring_release
+ * Marks a record as completed. Wait-free: a single atomic store on the record header.
+ * Space is returned to producers once every older record has been released too.
+ *
+ * @param ring  Pointer to the Ring structure.
+ * @param ptr   Payload pointer returned by ring_alloc.
+ */
+void ring_release(Ring* ring, void* ptr);
+
+/**
+ * ring_reclaim
+ * Advances the tail over contiguous released records. ring_alloc calls it when the
+ * ring is full; in RING_SPSC mode it must only be called from the producer thread.
+ *
+ * @param ring  Pointer to the Ring structure.
+ * @return Number of bytes returned to the ring.
+ */
+size_t ring_reclaim(Ring* ring);
+
+/**
+ * ring_used
+ * Returns the number of bytes between tail and head (records in use or awaiting reclaim).
+ *
+ * @param ring  Pointer to the Ring structure.
+ */
+size_t ring_used(Ring* ring);
+
+/**
+ * ring_destroy
+ * Unmaps the ring and closes the section handle.
+ *
+ * @param ring  Pointer to the Ring structure.
+ */
+void ring_destroy(Ring* ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RING_ALLOC_H
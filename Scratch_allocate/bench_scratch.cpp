@@ -0,0 +1,157 @@
+// bench_scratch.cpp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <windows.h>
+#include "scratch_alloc.hpp"
+
+#define CALLS         1000000  // Simulated function calls per benchmark.
+#define BUFFERS       6        // Scratch buffers requested per call.
+#define POOL_SIZE     (16 * 1024 * 1024)
+
+static double seconds_since(LARGE_INTEGER start, LARGE_INTEGER frequency) {
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&end);
+    return (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+}
+
+// Scratch size for buffer b of call i (32..256 bytes, about 850 bytes per call).
+static size_t scratch_size(int i, int b) {
+    return 32 + (size_t)(((unsigned)(i + b) * 2654435761u) >> 24) % 225;
+}
+
+// The work done on each scratch buffer.
+static unsigned touch(unsigned char* buffer, size_t size, int i) {
+    memset(buffer, i & 0xFF, size);
+    return buffer[size - 1] + buffer[size / 2];
+}
+
+// Scratch through pool_alloc/pool_free (global lock and a header per request).
+static unsigned call_pool(Pool* pool, int i) {
+    uintptr_t blocks[BUFFERS];
+    unsigned sum = 0;
+    for (int b = 0; b < BUFFERS; b++) {
+        size_t size = scratch_size(i, b);
+        blocks[b] = pool_alloc(pool, size, 16);
+        sum += touch((unsigned char*)blocks[b], size, i);
+    }
+    for (int b = 0; b < BUFFERS; b++)
+        pool_free(pool, blocks[b]);
+    return sum;
+}
+
+// Scratch through malloc/free.
+static unsigned call_malloc(int i) {
+    void* blocks[BUFFERS];
+    unsigned sum = 0;
+    for (int b = 0; b < BUFFERS; b++) {
+        size_t size = scratch_size(i, b);
+        blocks[b] = malloc(size);
+        sum += touch((unsigned char*)blocks[b], size, i);
+    }
+    for (int b = 0; b < BUFFERS; b++)
+        free(blocks[b]);
+    return sum;
+}
+
+// Scratch from a 1KB inline arena: every request fits, nothing reaches the pool.
+static unsigned call_scratch(Pool* pool, int i) {
+    SCRATCH_SCOPE(scratch, 1024, pool);
+    unsigned sum = 0;
+    for (int b = 0; b < BUFFERS; b++) {
+        size_t size = scratch_size(i, b);
+        sum += touch((unsigned char*)scratch_alloc(&scratch, size, 16), size, i);
+    }
+    return sum;
+}
+
+// Scratch from a 256-byte inline arena: most calls spill one chunk to the pool.
+static unsigned call_scratch_spill(Pool* pool, int i) {
+    SCRATCH_SCOPE(scratch, 256, pool);
+    unsigned sum = 0;
+    for (int b = 0; b < BUFFERS; b++) {
+        size_t size = scratch_size(i, b);
+        sum += touch((unsigned char*)scratch_alloc(&scratch, size, 16), size, i);
+    }
+    return sum;
+}
+
+// Builds a few small containers per call with the default allocator.
+static size_t call_std(int i) {
+    std::vector<int> values;
+    std::string text;
+    for (int k = 0; k < 48; k++) {
+        values.push_back(i + k);
+        text += (char)('a' + (i + k) % 26);
+    }
+    return values.size() + text.size() + (size_t)text[5];
+}
+
+// The same containers on a stack ScratchResource.
+static size_t call_pmr(Pool* pool, int i) {
+    allocates::ScratchResource<1024> scratch(pool);
+    std::pmr::vector<int> values(&scratch);
+    std::pmr::string text(&scratch);
+    for (int k = 0; k < 48; k++) {
+        values.push_back(i + k);
+        text += (char)('a' + (i + k) % 26);
+    }
+    return values.size() + text.size() + (size_t)text[5];
+}
+
+int main() {
+    LARGE_INTEGER frequency, start;
+    QueryPerformanceFrequency(&frequency);
+
+    Pool pool;
+    if (!pool_init(&pool, POOL_SIZE)) {
+        printf("Pool initialization failed.\n");
+        return 1;
+    }
+
+    // Benchmark per-call scratch buffers.
+    unsigned sum = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CALLS; i++)
+        sum += call_pool(&pool, i);
+    printf("pool_alloc scratch, %d calls: %.6f seconds (%u)\n", CALLS, seconds_since(start, frequency), sum);
+
+    sum = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CALLS; i++)
+        sum += call_malloc(i);
+    printf("malloc scratch, %d calls: %.6f seconds (%u)\n", CALLS, seconds_since(start, frequency), sum);
+
+    sum = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CALLS; i++)
+        sum += call_scratch(&pool, i);
+    printf("ScratchArena (1KB inline), %d calls: %.6f seconds (%u)\n", CALLS, seconds_since(start, frequency), sum);
+
+    sum = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CALLS; i++)
+        sum += call_scratch_spill(&pool, i);
+    printf("ScratchArena (256B inline, spills), %d calls: %.6f seconds (%u)\n", CALLS,
+           seconds_since(start, frequency), sum);
+
+    // Benchmark small containers with the default allocator and the pmr resource.
+    size_t total = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CALLS; i++)
+        total += call_std(i);
+    printf("std::vector + std::string, %d calls: %.6f seconds (%zu)\n", CALLS, seconds_since(start, frequency), total);
+
+    total = 0;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < CALLS; i++)
+        total += call_pmr(&pool, i);
+    printf("pmr on ScratchResource<1024>, %d calls: %.6f seconds (%zu)\n", CALLS, seconds_since(start, frequency),
+           total);
+
+    pool_destroy(&pool);
+    return 0;
+}
@@ -0,0 +1,167 @@
+// scratch_alloc.c
+
+#include "scratch_alloc.h"
+
+// -----------------------------------------------------------------------------
+// Arena Initialization
+// -----------------------------------------------------------------------------
+
+/**
+ * scratch_init
+ * Records the buffer and the pool; nothing is claimed from the pool until the
+ * buffer runs out.
+ *
+ * @param arena     Pointer to a ScratchArena structure.
+ * @param buffer    Inline buffer (may be NULL if capacity is 0).
+ * @param capacity  Size of the buffer in bytes.
+ * @param pool      Pool for spill chunks, or NULL.
+ */
+void scratch_init(ScratchArena* arena, void* buffer, size_t capacity, Pool* pool) {
+    arena->buffer = (unsigned char*)buffer;
+    arena->capacity = buffer ? capacity : 0;
+    arena->offset = 0;
+    arena->pool = pool;
+    arena->chunks = NULL;
+    arena->cursor = 0;
+    arena->limit = 0;
+    arena->spill_size = SCRATCH_SPILL_MIN_SIZE;
+    arena->spills = 0;
+    arena->spilled_bytes = 0;
+}
+
+// -----------------------------------------------------------------------------
+// Allocation
+// -----------------------------------------------------------------------------
+
+/**
+ * scratch_spill
+ * Claims a new spill chunk big enough for size bytes at the given alignment and
+ * makes it the current one. The rest of the previous chunk is abandoned until the
+ * arena is released or rewound.
+ *
+ * @param arena      Pointer to the ScratchArena structure.
+ * @param size       Bytes the chunk must fit.
+ * @param alignment  Alignment of the request (>= SCRATCH_MIN_ALIGNMENT).
+ * @return 1 on success, 0 if there is no pool or it is out of memory.
+ */
+static int scratch_spill(ScratchArena* arena, size_t size, size_t alignment) {
+    if (arena->pool == NULL)
+        return 0;
+    size_t needed = size + alignment - SCRATCH_MIN_ALIGNMENT;
+    if (needed < size)
+        return 0;
+    size_t chunk_size = arena->spill_size > needed ? arena->spill_size : needed;
+    if (chunk_size + sizeof(ScratchChunk) < chunk_size)
+        return 0;
+    uintptr_t block = pool_alloc(arena->pool, sizeof(ScratchChunk) + chunk_size, SCRATCH_MIN_ALIGNMENT);
+    if (block == 0)
+        return 0;
+    ScratchChunk* chunk = (ScratchChunk*)block;
+    chunk->next = arena->chunks;
+    chunk->size = chunk_size;
+    arena->chunks = chunk;
+    arena->cursor = block + sizeof(ScratchChunk);
+    arena->limit = arena->cursor + chunk_size;
+    arena->spills++;
+    if (arena->spill_size < SCRATCH_SPILL_MAX_SIZE)
+        arena->spill_size *= 2;
+    return 1;
+}
+
+/**
+ * scratch_alloc
+ * Bumps the inline offset if the request fits there, otherwise the cursor of the
+ * newest spill chunk, claiming a new chunk when that one is full too. Inline
+ * alignment is computed on the buffer address, so any buffer works.
+ *
+ * @param arena      Pointer to the ScratchArena structure.
+ * @param size       Number of bytes.
+ * @param alignment  Power of two; values below SCRATCH_MIN_ALIGNMENT are raised to it.
+ * @return Memory, or NULL if the buffer is full and no spill chunk could be claimed.
+ */
+void* scratch_alloc(ScratchArena* arena, size_t size, size_t alignment) {
+    if (alignment < SCRATCH_MIN_ALIGNMENT)
+        alignment = SCRATCH_MIN_ALIGNMENT;
+    if ((alignment & (alignment - 1)) != 0)
+        return NULL;
+    if (size == 0)
+        size = 1;
+
+    // Inline buffer.
+    uintptr_t base = (uintptr_t)arena->buffer;
+    uintptr_t aligned = (base + arena->offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if (arena->chunks == NULL && aligned - base <= arena->capacity && size <= arena->capacity - (aligned - base)) {
+        arena->offset = aligned - base + size;
+        return (void*)aligned;
+    }
+
+    // Newest spill chunk, then a new one.
+    aligned = (arena->cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    if (arena->chunks == NULL || aligned > arena->limit || size > arena->limit - aligned) {
+        if (!scratch_spill(arena, size, alignment))
+            return NULL;
+        aligned = (arena->cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+    arena->cursor = aligned + size;
+    arena->spilled_bytes += size;
+    return (void*)aligned;
+}
+
+// -----------------------------------------------------------------------------
+// Bulk Release
+// -----------------------------------------------------------------------------
+
+/**
+ * scratch_mark
+ * Copies the inline offset and the spill chunk position.
+ *
+ * @param arena  Pointer to the ScratchArena structure.
+ * @return Position to pass to scratch_rewind.
+ */
+ScratchMark scratch_mark(const ScratchArena* arena) {
+    ScratchMark mark;
+    mark.offset = arena->offset;
+    mark.chunks = arena->chunks;
+    mark.cursor = arena->cursor;
+    mark.limit = arena->limit;
+    return mark;
+}
+
+/**
+ * scratch_rewind
+ * Frees the spill chunks claimed after the mark (they sit in front of it on the
+ * chain) and restores the saved positions.
+ *
+ * @param arena  Pointer to the ScratchArena structure.
+ * @param mark   Position from scratch_mark on this arena.
+ */
+void scratch_rewind(ScratchArena* arena, ScratchMark mark) {
+    while (arena->chunks != NULL && arena->chunks != mark.chunks) {
+        ScratchChunk* chunk = arena->chunks;
+        arena->chunks = chunk->next;
+        pool_free(arena->pool, (uintptr_t)chunk);
+    }
+    arena->offset = mark.offset;
+    arena->cursor = mark.cursor;
+    arena->limit = mark.limit;
+}
+
+/**
+ * scratch_release
+ * Frees every spill chunk and resets the arena to an empty inline buffer.
+ *
+ * @param arena  Pointer to the ScratchArena structure.
+ */
+void scratch_release(ScratchArena* arena) {
+    while (arena->chunks != NULL) {
+        ScratchChunk* chunk = arena->chunks;
+        arena->chunks = chunk->next;
+        pool_free(arena->pool, (uintptr_t)chunk);
+    }
+    arena->offset = 0;
+    arena->cursor = 0;
+    arena->limit = 0;
+    arena->spill_size = SCRATCH_SPILL_MIN_SIZE;
+    arena->spills = 0;
+    arena->spilled_bytes = 0;
+}
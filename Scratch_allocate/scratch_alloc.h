@@ -0,0 +1,115 @@
+// scratch_alloc.h
+
+#ifndef SCRATCH_ALLOC_H
+#define SCRATCH_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pool_alloc.h"
+
+// A ScratchArena hands out short-lived scratch memory for one function call. It
+// bump-allocates from a buffer owned by the caller (normally a local array), so the
+// common case takes no lock and writes no header. When the buffer is exhausted the
+// arena claims spill chunks from a Pool and bumps inside those; a chunk costs one
+// pool_alloc, however many requests it serves. Nothing is freed individually:
+// scratch_release (or the end of a SCRATCH_SCOPE) drops everything at once.
+// An arena belongs to one thread.
+
+#define SCRATCH_MIN_ALIGNMENT   16            // Alignment of every allocation unless a larger one is asked for.
+#define SCRATCH_SPILL_MIN_SIZE  (16 * 1024)   // First spill chunk claimed from the pool.
+#define SCRATCH_SPILL_MAX_SIZE  (1024 * 1024) // Spill chunks stop doubling at this size.
+
+// ScratchChunk: header at the start of every spill chunk.
+typedef struct ScratchChunk {
+    struct ScratchChunk* next;   // Previously claimed chunk (NULL for the first).
+    size_t size;                 // Usable bytes after the header.
+} ScratchChunk;
+
+// ScratchArena structure: inline buffer plus the chain of spill chunks.
+typedef struct ScratchArena {
+    unsigned char* buffer;       // Caller-owned inline buffer.
+    size_t capacity;             // Size of the inline buffer.
+    size_t offset;               // Bytes of the inline buffer in use.
+    Pool* pool;                  // Spill target (NULL: fail once the buffer is full).
+    ScratchChunk* chunks;        // Newest spill chunk first.
+    uintptr_t cursor;            // Next free byte in the newest chunk.
+    uintptr_t limit;             // One past the last byte of the newest chunk.
+    size_t spill_size;           // Usable size of the next spill chunk (doubles per spill).
+    size_t spills;               // Chunks claimed from the pool since the last release.
+    size_t spilled_bytes;        // Bytes served from spill chunks since the last release.
+} ScratchArena;
+
+// ScratchMark: arena position saved by scratch_mark.
+typedef struct ScratchMark {
+    size_t offset;
+    ScratchChunk* chunks;
+    uintptr_t cursor;
+    uintptr_t limit;
+} ScratchMark;
+
+/**
+ * scratch_init
+ * Sets an arena up over a caller-owned buffer.
+ *
+ * @param arena     Pointer to a ScratchArena structure.
+ * @param buffer    Inline buffer (may be NULL if capacity is 0).
+ * @param capacity  Size of the buffer in bytes.
+ * @param pool      Pool for spill chunks, or NULL.
+ */
+void scratch_init(ScratchArena* arena, void* buffer, size_t capacity, Pool* pool);
+
+/**
+ * scratch_alloc
+ * Bump-allocates from the inline buffer, then from spill chunks.
+ *
+ * @param arena      Pointer to the ScratchArena structure.
+ * @param size       Number of bytes.
+ * @param alignment  Power of two; values below SCRATCH_MIN_ALIGNMENT are raised to it.
+ * @return Memory, or NULL if the buffer is full and no spill chunk could be claimed.
+ */
+void* scratch_alloc(ScratchArena* arena, size_t size, size_t alignment);
+
+/**
+ * scratch_mark
+ * Saves the current position so a nested scope can rewind to it.
+ *
+ * @param arena  Pointer to the ScratchArena structure.
+ * @return Position to pass to scratch_rewind.
+ */
+ScratchMark scratch_mark(const ScratchArena* arena);
+
+/**
+ * scratch_rewind
+ * Drops every allocation made after `mark`, returning spill chunks claimed since
+ * then to the pool.
+ *
+ * @param arena  Pointer to the ScratchArena structure.
+ * @param mark   Position from scratch_mark on this arena.
+ */
+void scratch_rewind(ScratchArena* arena, ScratchMark mark);
+
+/**
+ * scratch_release
+ * Drops every allocation and returns all spill chunks to the pool. The arena can
+ * be used again afterwards.
+ *
+ * @param arena  Pointer to the ScratchArena structure.
+ */
+void scratch_release(ScratchArena* arena);
+
+// SCRATCH_SCOPE: declares a `bytes`-byte local buffer and an arena named `name`
+// over it; scratch_release runs automatically when the enclosing block exits.
+#define SCRATCH_SCOPE(name, bytes, pool)                                                  \
+    unsigned char name##_buffer[bytes] __attribute__((aligned(SCRATCH_MIN_ALIGNMENT)));  \
+    ScratchArena name __attribute__((cleanup(scratch_release)));                          \
+    scratch_init(&name, name##_buffer, sizeof(name##_buffer), (pool))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCRATCH_ALLOC_H
@@ -0,0 +1,52 @@
+// scratch_alloc.hpp
+
+#ifndef SCRATCH_ALLOC_HPP
+#define SCRATCH_ALLOC_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include "scratch_alloc.h"
+
+// ScratchResource<N> puts a ScratchArena and its N-byte buffer in one object, meant
+// to live on the stack for the duration of a call, and exposes it as a
+// std::pmr::memory_resource. Like std::pmr::monotonic_buffer_resource it ignores
+// deallocate: pmr containers built on it free nothing until the resource goes out
+// of scope, at which point every spill chunk goes back to the Pool at once.
+// Containers using the resource must be destroyed before it.
+
+namespace allocates {
+
+template <std::size_t N>
+class ScratchResource : public std::pmr::memory_resource {
+public:
+    explicit ScratchResource(Pool* pool = nullptr) noexcept { scratch_init(&arena_, buffer_, N, pool); }
+    ~ScratchResource() override { scratch_release(&arena_); }
+
+    ScratchResource(const ScratchResource&) = delete;
+    ScratchResource& operator=(const ScratchResource&) = delete;
+
+    // Drops every allocation; the resource can be used again.
+    void release() noexcept { scratch_release(&arena_); }
+
+    ScratchArena* arena() noexcept { return &arena_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* ptr = scratch_alloc(&arena_, bytes, alignment);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    alignas(SCRATCH_MIN_ALIGNMENT) unsigned char buffer_[N];
+    ScratchArena arena_;
+};
+
+} // namespace allocates
+
+#endif // SCRATCH_ALLOC_HPP
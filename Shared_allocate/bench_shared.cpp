@@ -0,0 +1,83 @@
+// bench_shared.cpp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <vector>
+#include <windows.h>
+#include "shared_alloc.hpp"
+
+#define OBJECTS 100000  // Live shared objects per round.
+#define ROUNDS  20      // Create/release rounds.
+
+// Global operator new calls, counted to show which path touches the heap.
+static size_t global_news = 0;
+
+void* operator new(std::size_t size) {
+    global_news++;
+    void* ptr = malloc(size ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { free(ptr); }
+
+// Typical hot object kept behind a shared_ptr.
+struct Order {
+    long long id;
+    double price;
+    int quantity;
+    int side;
+
+    Order(long long id_, double price_, int quantity_) : id(id_), price(price_), quantity(quantity_), side(0) {}
+};
+
+// Creates and releases OBJECTS shared orders per round with `make`, and reports the
+// time and the global operator new calls made.
+template <class Make>
+static void bench_make(const char* label, Make make, LARGE_INTEGER frequency) {
+    std::vector<std::shared_ptr<Order>> orders;
+    orders.reserve(OBJECTS);
+    size_t news = global_news;
+    long long checksum = 0;
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < OBJECTS; i++)
+            orders.push_back(make(i));
+        for (int i = 0; i < OBJECTS; i += 7)
+            checksum += orders[i]->id + orders[i].use_count();
+        orders.clear();
+    }
+    QueryPerformanceCounter(&end);
+    news = global_news - news;
+    printf("%s, %d create/release pairs: %.6f seconds, %zu global operator new calls (checksum %lld)\n",
+           label, OBJECTS * ROUNDS, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, news, checksum);
+}
+
+int main() {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    bench_make("std::make_shared", [](int i) { return std::make_shared<Order>(i, 1.5, 10); }, frequency);
+
+    Slab slab;
+    if (!allocates::shared_slab_init<Order>(&slab, OBJECTS)) {
+        printf("Slab initialization failed.\n");
+        return 1;
+    }
+    printf("Slab object size for shared Order: %zu bytes (sizeof(Order) = %zu)\n", slab.object_size, sizeof(Order));
+    bench_make("make_pooled (Slab)", [&slab](int i) { return allocates::make_pooled<Order>(&slab, i, 1.5, 10); }, frequency);
+    slab_destroy(&slab);
+
+    Pool pool;
+    if (!pool_init(&pool, 16 * 1024 * 1024)) {
+        printf("Pool initialization failed.\n");
+        return 1;
+    }
+    bench_make("make_pooled (Pool)", [&pool](int i) { return allocates::make_pooled<Order>(&pool, i, 1.5, 10); }, frequency);
+    pool_destroy(&pool);
+    return 0;
+}
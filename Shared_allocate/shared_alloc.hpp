@@ -0,0 +1,198 @@
+// shared_alloc.hpp
+
+#ifndef SHARED_ALLOC_HPP
+#define SHARED_ALLOC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include "slab_alloc.h"
+#include "pool_alloc.h"
+
+// std::allocate_shared puts the control block and the object in one allocation of
+// an implementation-defined type. The allocators below serve that allocation from a
+// Slab object or a Pool block, so make_pooled needs no global heap and the last
+// release hands the memory back with slab_free/pool_free.
+//
+// A Slab serves exactly one allocation per object, so its object size must cover
+// the combined type: use shared_slab_object_size<T>() (or shared_slab_init<T>) to
+// size the slab. Allocators keep a pointer to the Slab/Pool, which must outlive
+// every shared_ptr created from it. Slab and Pool are not thread-safe for
+// allocation; the last release of a shared_ptr must happen on a thread that may
+// free to the same slab or pool.
+
+namespace allocates {
+
+// SlabAllocator: allocates single objects of at most object_size - HEADER_SIZE bytes.
+template <class T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    explicit SlabAllocator(Slab* slab) noexcept : slab_(slab) {}
+    template <class U>
+    SlabAllocator(const SlabAllocator<U>& other) noexcept : slab_(other.slab()) {}
+
+    T* allocate(std::size_t n) {
+        if (n * sizeof(T) + HEADER_SIZE > slab_->object_size || alignof(T) > 16)
+            throw std::bad_alloc();
+        void* ptr = slab_alloc(slab_);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept { slab_free(slab_, ptr); }
+
+    Slab* slab() const noexcept { return slab_; }
+
+private:
+    Slab* slab_;
+};
+
+template <class T, class U>
+bool operator==(const SlabAllocator<T>& a, const SlabAllocator<U>& b) noexcept { return a.slab() == b.slab(); }
+template <class T, class U>
+bool operator!=(const SlabAllocator<T>& a, const SlabAllocator<U>& b) noexcept { return a.slab() != b.slab(); }
+
+// PoolAllocator: any size, aligned to alignof(T) (at least 16).
+template <class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(Pool* pool) noexcept : pool_(pool) {}
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(std::size_t n) {
+        uintptr_t ptr = pool_alloc(pool_, n * sizeof(T), alignof(T) < 16 ? 16 : alignof(T));
+        if (ptr == 0)
+            throw std::bad_alloc();
+        return reinterpret_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept { pool_free(pool_, reinterpret_cast<uintptr_t>(ptr)); }
+
+    Pool* pool() const noexcept { return pool_; }
+
+private:
+    Pool* pool_;
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept { return a.pool() == b.pool(); }
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b) noexcept { return a.pool() != b.pool(); }
+
+namespace detail {
+
+// Thrown by SizeProbe once it has seen the allocation size.
+struct SizeProbed {};
+
+// Records the size of the combined allocation and aborts allocate_shared before
+// anything is constructed.
+template <class T>
+class SizeProbe {
+public:
+    using value_type = T;
+
+    explicit SizeProbe(std::size_t* bytes) noexcept : bytes_(bytes) {}
+    template <class U>
+    SizeProbe(const SizeProbe<U>& other) noexcept : bytes_(other.bytes()) {}
+
+    T* allocate(std::size_t n) {
+        *bytes_ = n * sizeof(T);
+        throw SizeProbed();
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    std::size_t* bytes() const noexcept { return bytes_; }
+
+private:
+    std::size_t* bytes_;
+};
+
+template <class T, class U>
+bool operator==(const SizeProbe<T>&, const SizeProbe<U>&) noexcept { return true; }
+template <class T, class U>
+bool operator!=(const SizeProbe<T>&, const SizeProbe<U>&) noexcept { return false; }
+
+// Stand-in with the size and alignment of T: the combined type of allocate_shared
+// depends only on those (and on the allocator), and Storage is default-constructible.
+template <class T>
+struct alignas(T) Storage {
+    unsigned char bytes[sizeof(T)];
+};
+
+} // namespace detail
+
+/**
+ * shared_slab_object_size
+ * Slab object size needed by make_pooled<T>(Slab*, ...): the size of the combined
+ * control block + T allocation of this standard library, plus HEADER_SIZE. Measured
+ * once per T.
+ *
+ * @return Object size to pass to slab_init.
+ */
+template <class T>
+std::size_t shared_slab_object_size() {
+    static const std::size_t size = [] {
+        std::size_t bytes = 0;
+        try {
+            std::allocate_shared<detail::Storage<T>>(detail::SizeProbe<detail::Storage<T>>(&bytes));
+        } catch (const detail::SizeProbed&) {
+        }
+        return bytes + HEADER_SIZE;
+    }();
+    return size;
+}
+
+/**
+ * shared_slab_init
+ * Initializes a slab whose objects each hold one make_pooled<T> allocation.
+ *
+ * @param slab   Pointer to a Slab structure.
+ * @param count  Number of shared objects the slab can hold.
+ * @param flags  SLAB_FLAG_* flags for slab_init_ex.
+ * @return 1 on success, 0 on failure.
+ */
+template <class T>
+int shared_slab_init(Slab* slab, std::size_t count, int flags = 0) {
+    return slab_init_ex(slab, count, shared_slab_object_size<T>(), flags);
+}
+
+/**
+ * make_pooled
+ * Creates a T and its control block in one Slab object. Throws std::bad_alloc if
+ * the slab is exhausted or its objects are too small.
+ *
+ * @param slab  Slab sized with shared_slab_object_size<T>().
+ * @param args  Constructor arguments of T.
+ * @return Owning shared_ptr; the last release calls slab_free.
+ */
+template <class T, class... Args>
+std::shared_ptr<T> make_pooled(Slab* slab, Args&&... args) {
+    return std::allocate_shared<T>(SlabAllocator<T>(slab), std::forward<Args>(args)...);
+}
+
+/**
+ * make_pooled
+ * Creates a T and its control block in one Pool block. Throws std::bad_alloc if
+ * the pool cannot allocate.
+ *
+ * @param pool  Pool to allocate from.
+ * @param args  Constructor arguments of T.
+ * @return Owning shared_ptr; the last release calls pool_free.
+ */
+template <class T, class... Args>
+std::shared_ptr<T> make_pooled(Pool* pool, Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+}
+
+} // namespace allocates
+
+#endif // SHARED_ALLOC_HPP
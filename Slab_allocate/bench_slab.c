@@ -1,10 +1,534 @@
 // bench_slab.c
 
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <windows.h>
+#include <psapi.h>
 #include "slab_alloc.h"
 
+// Bursty workload: allocate every object of a 16MB slab, free them all, then stay idle
+// for twice the decay time while ticking. Prints burst time and decay counters.
+static double bench_bursty_decay(size_t decay_ms, int bursts, LARGE_INTEGER frequency) {
+    Slab slab;
+    size_t count = 16 * 1024 * 1024 / 256;
+    if (!slab_init(&slab, count, 256) || !slab_set_decay(&slab, decay_ms))
+        return -1.0;
+    void** objects = (void**)malloc(count * sizeof(void*));
+    if (objects == NULL) {
+        slab_destroy(&slab);
+        return -1.0;
+    }
+    double busy = 0.0;
+    LARGE_INTEGER start, end;
+    for (int burst = 0; burst < bursts; burst++) {
+        QueryPerformanceCounter(&start);
+        for (size_t i = 0; i < count; i++) {
+            objects[i] = slab_alloc(&slab);
+            *(volatile size_t*)objects[i] = i;
+        }
+        for (size_t i = 0; i < count; i++)
+            slab_free(&slab, objects[i]);
+        QueryPerformanceCounter(&end);
+        busy += (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+        for (size_t idle = 0; idle < decay_ms * 2; idle += decay_ms / SLAB_DECAY_STEPS) {
+            Sleep((DWORD)(decay_ms / SLAB_DECAY_STEPS));
+            slab_decay_tick(&slab);
+        }
+    }
+    SlabStats stats;
+    slab_get_stats(&slab, &stats);
+    printf("Bursty 16MB slab x %d, %zums decay: %.6f seconds busy\n", bursts, decay_ms, busy);
+    printf("Decay: %zu bytes purged in %zu calls, %zu refaults, %zu bytes still purged\n",
+           stats.purged_bytes_total, stats.purge_calls, stats.refaults, stats.purged_bytes);
+    free(objects);
+    slab_destroy(&slab);
+    return busy;
+}
+
+// The previous reset: a link loop with a multiply per object, then a second pass
+// that clears the whole slab (cleared first here so the links survive).
+static void two_pass_reset(Slab* slab) {
+    memset(slab->memory, 0, slab->object_size * slab->total_objects);
+    slab->free_list = slab->memory;
+    for (size_t i = 0; i < slab->total_objects; i++) {
+        unsigned char* current_obj = slab->memory + i * slab->object_size;
+        unsigned char* next_obj = (i < slab->total_objects - 1) ? (slab->memory + (i + 1) * slab->object_size) : NULL;
+        *((void**)current_obj) = next_obj;
+    }
+}
+
+// Times the two-pass reset against slab_reset on a slab of `count` objects.
+static void bench_reset_compare(size_t count, size_t object_size, LARGE_INTEGER frequency) {
+    Slab slab;
+    if (!slab_init(&slab, count, object_size)) {
+        printf("Reset comparison skipped: %zu x %zu-byte slab could not be mapped.\n", count, object_size);
+        return;
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    two_pass_reset(&slab);
+    QueryPerformanceCounter(&end);
+    double twoPass = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    QueryPerformanceCounter(&start);
+    slab_reset(&slab);
+    QueryPerformanceCounter(&end);
+    double streaming = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    // The rebuilt list must hand out the first objects in address order.
+    int ordered = slab_alloc(&slab) == slab.memory + HEADER_SIZE &&
+                  slab_alloc(&slab) == slab.memory + slab.object_size + HEADER_SIZE;
+    printf("Reset %zu x %zu-byte objects: two-pass %.6f seconds, streaming %.6f seconds (%s)\n",
+           count, slab.object_size, twoPass, streaming, ordered ? "list ok" : "LIST BROKEN");
+    slab_destroy(&slab);
+}
+
+// Page faults taken by the process so far (GetProcessMemoryInfo, the getrusage analogue).
+static DWORD page_faults(void) {
+    PROCESS_MEMORY_COUNTERS counters;
+    counters.cb = sizeof(counters);
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PageFaultCount;
+}
+
+// Allocates and frees every object of a 64K x 256-byte slab repeatedly and reports the
+// page faults and slow-path system calls taken after init.
+static void bench_realtime_steady(int flags, const char* label, LARGE_INTEGER frequency) {
+    Slab slab;
+    size_t count = 65536;
+    void** objects = (void**)malloc(count * sizeof(void*));
+    if (objects == NULL || !slab_init_ex(&slab, count, 256, flags)) {
+        printf("%s: slab initialization failed.\n", label);
+        free(objects);
+        return;
+    }
+    DWORD faults = page_faults();
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int round = 0; round < 16; round++) {
+        for (size_t i = 0; i < count; i++) {
+            objects[i] = slab_alloc(&slab);
+            *(volatile size_t*)objects[i] = i;
+        }
+        for (size_t i = 0; i < count; i++)
+            slab_free(&slab, objects[i]);
+    }
+    QueryPerformanceCounter(&end);
+    faults = page_faults() - faults;
+    SlabStats stats;
+    slab_get_stats(&slab, &stats);
+    printf("%s, %zu alloc/free pairs: %.6f seconds, %lu page faults, %zu slow-path syscalls\n",
+           label, count * 16, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart,
+           (unsigned long)faults, stats.slow_syscalls);
+    slab_destroy(&slab);
+    free(objects);
+}
+
+// Tree node used by the locality benchmark.
+typedef struct TreeNode {
+    struct TreeNode* left;
+    struct TreeNode* right;
+    size_t key;
+    size_t value;
+} TreeNode;
+
+// Looks up `lookups` pseudo-random keys in pseudo-random trees of the forest; this
+// walk is what node placement affects.
+static size_t forest_lookups(TreeNode** roots, int trees, int per_tree, int lookups) {
+    size_t found = 0;
+    for (int j = 0; j < lookups; j++) {
+        int t = (int)(((unsigned)j * 2654435761u) >> 8) % trees;
+        int i = (int)(((unsigned)j * 40503u) >> 4) % per_tree;
+        size_t key = (((size_t)i * 2654435761u) ^ ((size_t)t * 40503u)) & 0xFFFFFF;
+        const TreeNode* node = roots[t];
+        while (node && node->key != key)
+            node = key < node->key ? node->left : node->right;
+        found += node != NULL;
+    }
+    return found;
+}
+
+// Fills a slab, takes the tree roots from it at regular intervals and frees a
+// pseudo-random half of the rest. Then grows the forest of binary search trees one
+// node per tree at a time (so each tree's nodes are allocated at different times),
+// with or without the parent as hint.
+static void bench_tree_locality(int use_hint, LARGE_INTEGER frequency) {
+    const size_t count = 1 << 20;
+    const int trees = 8192;
+    const int per_tree = 32;
+    Slab slab;
+    if (!slab_init_ex(&slab, count, 64, use_hint ? SLAB_FLAG_PAGE_INDEX : 0))
+        return;
+    void** objects = (void**)malloc(count * sizeof(void*));
+    for (size_t i = 0; i < count; i++)
+        objects[i] = slab_alloc(&slab);
+    // Roots are created early, scattered between the other objects.
+    TreeNode** roots = (TreeNode**)calloc(trees, sizeof(TreeNode*));
+    for (int t = 0; t < trees; t++) {
+        TreeNode* root = (TreeNode*)objects[(size_t)t * (count / trees)];
+        objects[(size_t)t * (count / trees)] = NULL;
+        root->left = root->right = NULL;
+        root->key = ((size_t)t * 40503u) & 0xFFFFFF;
+        root->value = 0;
+        roots[t] = root;
+    }
+    for (size_t i = 0; i < count; i++) {
+        size_t j = (i * 2654435761u) % count;
+        if (objects[j] && ((j * 40503u) & 0x100)) {
+            slab_free(&slab, objects[j]);
+            objects[j] = NULL;
+        }
+    }
+    int same_page = 0;
+    for (int i = 1; i < per_tree; i++) {
+        for (int t = 0; t < trees; t++) {
+            size_t key = (((size_t)i * 2654435761u) ^ ((size_t)t * 40503u)) & 0xFFFFFF;
+            TreeNode* parent = NULL;
+            TreeNode** link = &roots[t];
+            while (*link) {
+                parent = *link;
+                link = key < parent->key ? &parent->left : &parent->right;
+            }
+            TreeNode* node = (TreeNode*)(use_hint ? slab_alloc_near(&slab, parent)
+                                                  : slab_alloc(&slab));
+            node->left = node->right = NULL;
+            node->key = key;
+            node->value = (size_t)i;
+            *link = node;
+            same_page += ((uintptr_t)parent / 4096) == ((uintptr_t)node / 4096);
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t found = forest_lookups(roots, trees, per_tree, 1000000);
+    QueryPerformanceCounter(&end);
+    printf("Forest of %d x %d nodes, %s: %.1f%% of children share the parent's page, 1M lookups %.6f seconds (%zu hits)\n",
+           trees, per_tree, use_hint ? "slab_alloc_near" : "slab_alloc", 100.0 * same_page / ((double)trees * (per_tree - 1)),
+           (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, found);
+    free(roots);
+    free(objects);
+    slab_destroy(&slab);
+}
+
+// Working set of the process in bytes.
+static size_t working_set(void) {
+    PROCESS_MEMORY_COUNTERS counters;
+    counters.cb = sizeof(counters);
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.WorkingSetSize;
+}
+
+// Fills a meshable 16MB slab of 1KB objects (64 per span), frees ~90% of it at random,
+// then meshes it and reports the working set before and after plus survivor integrity.
+static void bench_mesh_churn(LARGE_INTEGER frequency) {
+    Slab slab;
+    size_t count = 16384;
+    void** objects = (void**)malloc(count * sizeof(void*));
+    if (objects == NULL || !slab_init_ex(&slab, count, 1024, SLAB_FLAG_MESH)) {
+        printf("Mesh slab initialization failed.\n");
+        free(objects);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        objects[i] = slab_alloc(&slab);
+        memset(objects[i], (int)(i & 0xFF), 32);
+    }
+    unsigned seed = 7;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if ((seed >> 8) % 10 != 0) {
+            slab_free(&slab, objects[i]);
+            objects[i] = NULL;
+        }
+    }
+    size_t before = working_set();
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    size_t released = slab_mesh(&slab, 64);
+    QueryPerformanceCounter(&end);
+    size_t after = working_set();
+    int corrupt = 0;
+    for (size_t i = 0; i < count; i++) {
+        const unsigned char* data = (const unsigned char*)objects[i];
+        if (data != NULL && (data[0] != (i & 0xFF) || data[31] != (i & 0xFF)))
+            corrupt++;
+    }
+    // The meshed slab must keep serving every free slot exactly once.
+    size_t refilled = 0;
+    while (slab_alloc(&slab) != NULL)
+        refilled++;
+    SlabStats stats;
+    slab_get_stats(&slab, &stats);
+    printf("Mesh pass, 10%% of %zu x 1KB objects live: %.6f seconds, %zu KB unmapped, working set %zu KB -> %zu KB, %d corrupt objects, %zu slots refilled\n",
+           count, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart, released / 1024,
+           before / 1024, after / 1024, corrupt, refilled);
+    printf("Meshed bytes: %zu KB\n", stats.meshed_bytes / 1024);
+    slab_destroy(&slab);
+    free(objects);
+}
+
+// Churns a 64K x 64-byte slab with batches of random replacements (LIFO reuse
+// scatters the free list), frees half of it, then allocates a 16K-node list and reports how many pages
+// the list spans and how long walking it takes. sort_period 0 keeps the plain free list.
+static void bench_churn_order(size_t sort_period, LARGE_INTEGER frequency) {
+    Slab slab;
+    size_t count = 65536, nodes = 16384;
+    void** objects = (void**)malloc(count * sizeof(void*));
+    void** list = (void**)malloc(nodes * sizeof(void*));
+    if (objects == NULL || list == NULL || !slab_init(&slab, count, 64) ||
+        (sort_period != 0 && !slab_set_sort_period(&slab, sort_period))) {
+        printf("Churn slab initialization failed.\n");
+        free(objects);
+        free(list);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+        objects[i] = slab_alloc(&slab);
+    unsigned seed = 3;
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int round = 0; round < 2000; round++) {
+        size_t batch[1024];
+        for (int i = 0; i < 1024; i++) {
+            seed = seed * 1103515245u + 12345u;
+            batch[i] = (seed >> 8) % count;
+            if (objects[batch[i]] != NULL) {
+                slab_free(&slab, objects[batch[i]]);
+                objects[batch[i]] = NULL;
+            }
+        }
+        for (int i = 0; i < 1024; i++) {
+            if (objects[batch[i]] == NULL)
+                objects[batch[i]] = slab_alloc(&slab);
+        }
+    }
+    QueryPerformanceCounter(&end);
+    double churnTime = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    for (size_t i = 0; i < count; i += 2)
+        slab_free(&slab, objects[i]);
+    if (sort_period != 0)
+        slab_sort_free(&slab);  // Idle point: sort the backlog of frees since the last period.
+    for (size_t i = 0; i < nodes; i++) {
+        list[i] = slab_alloc(&slab);
+        if (i > 0)
+            *(void**)list[i - 1] = list[i];
+    }
+    *(void**)list[nodes - 1] = NULL;
+    size_t pages = 1;
+    for (size_t i = 1; i < nodes; i++) {
+        if ((uintptr_t)list[i] / SLAB_PAGE_SIZE != (uintptr_t)list[i - 1] / SLAB_PAGE_SIZE)
+            pages++;
+    }
+    size_t walked = 0;
+    QueryPerformanceCounter(&start);
+    for (int round = 0; round < 100; round++) {
+        for (void* node = list[0]; node; node = *(void**)node)
+            walked++;
+    }
+    QueryPerformanceCounter(&end);
+    SlabStats stats;
+    slab_get_stats(&slab, &stats);
+    printf("Churned slab, sort period %zu: churn %.6f seconds, %zu-node list crosses %zu page boundaries, 100 walks %.6f seconds (%zu sorts)\n",
+           sort_period, churnTime, nodes, pages - 1, (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart,
+           stats.sort_passes);
+    (void)walked;
+    slab_destroy(&slab);
+    free(objects);
+    free(list);
+}
+
+// Shared state of the type-stable lookup benchmark: a pointer table whose records
+// are replaced and freed immediately by one writer while readers look them up.
+#define TYPESAFE_SLOTS 4096
+#define TYPESAFE_READERS 2
+
+typedef struct TypesafeRecord {
+    volatile uint64_t value;
+    volatile uint64_t check;     // ~value while the record is live.
+} TypesafeRecord;
+
+typedef struct TypesafeTable {
+    TypesafeRecord* volatile slots[TYPESAFE_SLOTS];
+    volatile LONG stop;
+    int validate;                // Use slab_read_version/slab_validate_version.
+    size_t lookups[TYPESAFE_READERS];
+    size_t retries[TYPESAFE_READERS];
+    size_t torn[TYPESAFE_READERS];  // Accepted reads with check != ~value.
+} TypesafeTable;
+
+typedef struct TypesafeReader {
+    TypesafeTable* table;
+    int id;
+} TypesafeReader;
+
+// Reader: optimistic lookups of random slots; with validation a read is retried
+// until the version was odd (published) and unchanged around it.
+static DWORD WINAPI typesafe_reader(LPVOID arg) {
+    TypesafeReader* reader = (TypesafeReader*)arg;
+    TypesafeTable* table = reader->table;
+    unsigned seed = 99u * (reader->id + 1);
+    size_t lookups = 0, retries = 0, torn = 0;
+    while (!table->stop) {
+        seed = seed * 1103515245u + 12345u;
+        size_t slot = (seed >> 8) % TYPESAFE_SLOTS;
+        uint64_t value, check;
+        for (;;) {
+            TypesafeRecord* record = table->slots[slot];
+            if (!table->validate) {
+                value = record->value;
+                check = record->check;
+                break;
+            }
+            size_t version = slab_read_version(record);
+            value = record->value;
+            check = record->check;
+            if ((version & 1) && slab_validate_version(record, version))
+                break;
+            retries++;
+        }
+        if (check != ~value)
+            torn++;
+        lookups++;
+    }
+    table->lookups[reader->id] = lookups;
+    table->retries[reader->id] = retries;
+    table->torn[reader->id] = torn;
+    return 0;
+}
+
+// One writer initializes and publishes replacement records and frees the old ones
+// at once (no deferred reclamation) while TYPESAFE_READERS threads read, with and
+// without version validation on a SLAB_FLAG_TYPESAFE slab.
+static void bench_typesafe_lookup(int validate, LARGE_INTEGER frequency) {
+    const int replacements = 1000000;
+    Slab slab;
+    TypesafeTable* table = (TypesafeTable*)calloc(1, sizeof(TypesafeTable));
+    if (table == NULL || !slab_init_ex(&slab, TYPESAFE_SLOTS * 4, HEADER_SIZE + sizeof(TypesafeRecord), SLAB_FLAG_TYPESAFE)) {
+        printf("Type-stable slab initialization failed.\n");
+        free(table);
+        return;
+    }
+    table->validate = validate;
+    for (int i = 0; i < TYPESAFE_SLOTS; i++) {
+        TypesafeRecord* record = (TypesafeRecord*)slab_alloc(&slab);
+        record->value = (uint64_t)i;
+        record->check = ~(uint64_t)i;
+        slab_publish(record);
+        table->slots[i] = record;
+    }
+    HANDLE handles[TYPESAFE_READERS];
+    TypesafeReader readers[TYPESAFE_READERS];
+    for (int t = 0; t < TYPESAFE_READERS; t++) {
+        readers[t].table = table;
+        readers[t].id = t;
+        handles[t] = CreateThread(NULL, 0, typesafe_reader, &readers[t], 0, NULL);
+    }
+    unsigned seed = 17;
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < replacements; i++) {
+        seed = seed * 1103515245u + 12345u;
+        TypesafeRecord* record = (TypesafeRecord*)slab_alloc(&slab);
+        uint64_t value = (uint64_t)i + TYPESAFE_SLOTS;
+        record->check = 0;
+        record->value = value;
+        record->check = ~value;
+        slab_publish(record);
+        TypesafeRecord* old = (TypesafeRecord*)InterlockedExchangePointer(
+            (PVOID volatile*)&table->slots[(seed >> 8) % TYPESAFE_SLOTS], record);
+        slab_free(&slab, old);
+    }
+    QueryPerformanceCounter(&end);
+    table->stop = 1;
+    WaitForMultipleObjects(TYPESAFE_READERS, handles, TRUE, INFINITE);
+    size_t lookups = 0, retries = 0, torn = 0;
+    for (int t = 0; t < TYPESAFE_READERS; t++) {
+        CloseHandle(handles[t]);
+        lookups += table->lookups[t];
+        retries += table->retries[t];
+        torn += table->torn[t];
+    }
+    double seconds = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    printf("Type-stable slab, %s: %d replacements in %.6f seconds, %.2f lookups/sec, %zu retries, %zu torn reads accepted\n",
+           validate ? "version validation" : "no validation", replacements, seconds, lookups / seconds, retries, torn);
+    slab_destroy(&slab);
+    free(table);
+}
+
+// Fills 256K x 256-byte objects, frees 90% of them at random, then churns: each round
+// frees 1/8 of the live objects at random and allocates as many new ones. Reports
+// the memory still backing the live 10%: mapped segments for the growable slab,
+// unpurged pages (after slab_purge) for the fixed slab.
+#define SEGMENT_BENCH_OBJECTS 262144
+#define SEGMENT_BENCH_ROUNDS  64
+
+static void bench_segment_churn(int growable, LARGE_INTEGER frequency) {
+    Slab slab;
+    SlabGrowable grow;
+    size_t count = SEGMENT_BENCH_OBJECTS;
+    void** objects = (void**)malloc(count * sizeof(void*));
+    int ready = growable ? slab_growable_init(&grow, 256, 0, 0)
+                         : slab_init(&slab, count, 256) && slab_set_decay(&slab, 1000000);
+    if (objects == NULL || !ready) {
+        printf("Segment churn initialization failed.\n");
+        free(objects);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+        objects[i] = growable ? slab_growable_alloc(&grow) : slab_alloc(&slab);
+    // Keep the survivors packed at the front of `objects`.
+    size_t live = 0;
+    unsigned seed = 11;
+    for (size_t i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        if ((seed >> 8) % 10 == 0) {
+            objects[live++] = objects[i];
+        } else if (growable) {
+            slab_growable_free(&grow, objects[i]);
+        } else {
+            slab_free(&slab, objects[i]);
+        }
+    }
+    LARGE_INTEGER start, end;
+    QueryPerformanceCounter(&start);
+    for (int round = 0; round < SEGMENT_BENCH_ROUNDS; round++) {
+        size_t batch = live / 8;
+        for (size_t i = 0; i < batch; i++) {
+            seed = seed * 1103515245u + 12345u;
+            size_t victim = (seed >> 8) % live;
+            if (growable)
+                slab_growable_free(&grow, objects[victim]);
+            else
+                slab_free(&slab, objects[victim]);
+            objects[victim] = objects[--live];
+        }
+        for (size_t i = 0; i < batch; i++)
+            objects[live++] = growable ? slab_growable_alloc(&grow) : slab_alloc(&slab);
+    }
+    QueryPerformanceCounter(&end);
+    double seconds = (double)(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+    size_t backing;
+    if (growable) {
+        slab_growable_shrink(&grow);
+        SlabGrowableStats stats;
+        slab_growable_get_stats(&grow, &stats);
+        backing = stats.mapped_bytes;
+        printf("Growable slab churn: %.6f seconds, %zu live objects in %zu KB mapped (%zu segments: %zu partial, %zu full; %zu released)\n",
+               seconds, live, backing / 1024, stats.segments, stats.partial_segments, stats.full_segments,
+               stats.segments_released);
+        slab_growable_destroy(&grow);
+    } else {
+        slab_purge(&slab);
+        SlabStats stats;
+        slab_get_stats(&slab, &stats);
+        backing = count * 256 - stats.purged_bytes;
+        printf("Fixed slab churn: %.6f seconds, %zu live objects in %zu KB of unpurged pages\n", seconds, live,
+               backing / 1024);
+        slab_destroy(&slab);
+    }
+    free(objects);
+}
+
 int main(void) {
     // Benchmark parameters.
     const int iterations = 1000000;  // 1 million allocations.
@@ -68,6 +592,37 @@ int main(void) {
     _aligned_free(allocations);
     slab_destroy(&slab);
     printf("Slab destroyed.\n");
+
+    // Benchmark the fused streaming reset against the two-pass reset.
+    bench_reset_compare(1000000, 16, frequency);
+    bench_reset_compare(100000000, 16, frequency);
+
+    // Benchmark page faults after init, default vs real-time slab.
+    bench_realtime_steady(0, "Default slab", frequency);
+    bench_realtime_steady(SLAB_FLAG_REALTIME, "Real-time slab", frequency);
+
+    // Benchmark tree locality with and without allocation hints.
+    bench_tree_locality(0, frequency);
+    bench_tree_locality(1, frequency);
+
+    // Benchmark allocation order after churn, LIFO vs address-ordered free list.
+    bench_churn_order(0, frequency);
+    bench_churn_order(65536, frequency);
+
+    // Benchmark optimistic lookups on a type-stable slab with immediate frees.
+    bench_typesafe_lookup(0, frequency);
+    bench_typesafe_lookup(1, frequency);
+
+    // Benchmark memory held after churn, fixed slab vs segmented growable slab.
+    bench_segment_churn(0, frequency);
+    bench_segment_churn(1, frequency);
+
+    // Benchmark meshing of a sparse slab after heavy churn.
+    bench_mesh_churn(frequency);
+
+    // Benchmark bursty usage with idle gaps and dirty page decay.
+    if (bench_bursty_decay(200, 4, frequency) < 0)
+        printf("Decay benchmark failed.\n");
     
     return 0;
 }
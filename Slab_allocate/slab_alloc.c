@@ -1,6 +1,7 @@
 // slab_alloc.c
 
 #include "slab_alloc.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <immintrin.h>
@@ -17,33 +18,398 @@ static size_t align_size(size_t size) {
 }
 
 /**
- * simd_memset
- * Fills a memory region with a specified value using AVX instructions.
+ * link_objects
+ * Builds the free list in address order with a precomputed stride (no multiplies).
+ * Only the link word of each object is written, with non-temporal stores, so a
+ * large slab does not sweep the cache; the rest of the object is left untouched.
  *
- * @param ptr   Pointer to the memory region.
- * @param value The value to set.
- * @param size  Number of bytes to fill.
+ * @param memory  Base of the slab.
+ * @param stride  Object size in bytes.
+ * @param count   Number of objects (> 0).
  */
-static void simd_memset(void* ptr, int value, size_t size) {
-    unsigned char* p = (unsigned char*)ptr;
-    size_t i = 0;
-    __m256i vec = _mm256_set1_epi8((char)value);
-    size_t misalignment = ((uintptr_t)p) % 32;
-    if (misalignment) {
-         size_t align_bytes = 32 - misalignment;
-         if (align_bytes > size)
-             align_bytes = size;
-         memset(p, value, align_bytes);
-         p += align_bytes;
-         size -= align_bytes;
+static void link_objects(unsigned char* memory, size_t stride, size_t count) {
+    unsigned char* obj = memory;
+    unsigned char* last = memory + (count - 1) * stride;
+    while (obj < last) {
+        _mm_stream_si64((long long*)obj, (long long)(obj + stride));
+        obj += stride;
     }
-    for (i = 0; i < size / 32; i++) {
-         _mm256_store_si256((__m256i*)(p + i * 32), vec);
+    _mm_stream_si64((long long*)last, 0);
+    _mm_sfence();
+}
+
+/**
+ * zero_and_link_objects
+ * Single streaming pass that zeroes every object and writes its link word. Each
+ * object is written front to back as whole vectors with non-temporal stores: the
+ * first vector carries the next pointer, the remaining ones are zero. Objects
+ * whose size is a multiple of 32 use 256-bit stores (every object is 32-byte
+ * aligned then), others 128-bit stores.
+ *
+ * @param memory  Base of the slab (at least 32-byte aligned).
+ * @param stride  Object size in bytes (multiple of 16).
+ * @param count   Number of objects (> 0).
+ */
+static void zero_and_link_objects(unsigned char* memory, size_t stride, size_t count) {
+    unsigned char* obj = memory;
+    unsigned char* end = memory + count * stride;
+    if (stride % 32 == 0) {
+        __m256i zero = _mm256_setzero_si256();
+        while (obj < end) {
+            unsigned char* next = obj + stride;
+            __m256i head = _mm256_set_epi64x(0, 0, 0, (long long)(next < end ? next : NULL));
+            _mm256_stream_si256((__m256i*)obj, head);
+            for (unsigned char* p = obj + 32; p < next; p += 32)
+                _mm256_stream_si256((__m256i*)p, zero);
+            obj = next;
+        }
+    } else {
+        __m128i zero = _mm_setzero_si128();
+        while (obj < end) {
+            unsigned char* next = obj + stride;
+            __m128i head = _mm_set_epi64x(0, (long long)(next < end ? next : NULL));
+            _mm_stream_si128((__m128i*)obj, head);
+            for (unsigned char* p = obj + 16; p < next; p += 16)
+                _mm_stream_si128((__m128i*)p, zero);
+            obj = next;
+        }
+    }
+    _mm_sfence();
+}
+
+/**
+ * zero_and_link_typesafe
+ * zero_and_link_objects for type-stable slabs: the version word of every object is
+ * kept (advanced to even if the object was published) and everything else past
+ * the link is zeroed. Plain stores, since readers may be looking at the objects.
+ *
+ * @param memory  Base of the slab.
+ * @param stride  Object size in bytes (multiple of 16).
+ * @param count   Number of objects (> 0).
+ */
+static void zero_and_link_typesafe(unsigned char* memory, size_t stride, size_t count) {
+    unsigned char* end = memory + count * stride;
+    for (unsigned char* obj = memory; obj < end; obj += stride) {
+        volatile size_t* version = (volatile size_t*)(obj + SLAB_VERSION_OFFSET);
+        if (*version & 1)
+            *version = *version + 1;
+        __asm__ __volatile__("" ::: "memory");
+        memset(obj + SLAB_VERSION_OFFSET + sizeof(size_t), 0, stride - SLAB_VERSION_OFFSET - sizeof(size_t));
+        *((unsigned char**)obj) = obj + stride < end ? obj + stride : NULL;
+    }
+}
+
+/**
+ * note_slow_syscall
+ * Counts a system call made after init. With SLAB_REALTIME_ASSERT defined, a
+ * real-time slab treats it as a fatal error.
+ */
+static void note_slow_syscall(Slab *slab) {
+    slab->slow_syscalls++;
+#ifdef SLAB_REALTIME_ASSERT
+    if (slab->flags & SLAB_FLAG_REALTIME) {
+        fprintf(stderr, "slab_alloc: system call on a real-time slab after init\n");
+        abort();
+    }
+#endif
+}
+
+/**
+ * retire_version
+ * Advances the version word of a published object base of a type-stable slab to
+ * even (an object freed without being published is already even). The store is
+ * ordered before the caller's following stores (x86 keeps stores in order), so a
+ * reader that sees new contents also sees the new version.
+ */
+static inline void retire_version(unsigned char* obj) {
+    volatile size_t* version = (volatile size_t*)(obj + SLAB_VERSION_OFFSET);
+    if (*version & 1)
+        *version = *version + 1;
+    __asm__ __volatile__("" ::: "memory");
+}
+
+/**
+ * slab_page_count
+ * Returns the number of SLAB_PAGE_SIZE pages spanned by the slab mapping.
+ */
+static size_t slab_page_count(Slab *slab) {
+    return (slab->object_size * slab->total_objects + SLAB_PAGE_SIZE - 1) / SLAB_PAGE_SIZE;
+}
+
+/**
+ * page_objects
+ * Computes the range of objects [*first, *last] overlapping a page.
+ */
+static void page_objects(Slab *slab, size_t page, size_t* first, size_t* last) {
+    *first = page * SLAB_PAGE_SIZE / slab->object_size;
+    *last = ((page + 1) * SLAB_PAGE_SIZE - 1) / slab->object_size;
+    if (*last >= slab->total_objects)
+        *last = slab->total_objects - 1;
+}
+
+/**
+ * revive_page
+ * Links the objects that start in a purged page back into the free list.
+ * The page is written again right away, so the OS keeps it from now on.
+ */
+static void revive_page(Slab *slab, size_t page) {
+    size_t first = (page * SLAB_PAGE_SIZE + slab->object_size - 1) / slab->object_size;
+    for (size_t i = first; i < slab->total_objects && i * slab->object_size < (page + 1) * SLAB_PAGE_SIZE; i++) {
+        unsigned char* obj = slab->memory + i * slab->object_size;
+        *((void**)obj) = slab->free_list;
+        slab->free_list = obj;
+    }
+    slab->page_state[page] = SLAB_PAGE_USED;
+    slab->purged_pages--;
+    slab->refaults++;
+}
+
+/**
+ * slab_alloc_revive
+ * Slow path of slab_alloc: the free list is empty but purged pages hold objects.
+ * Revives the first purged page that has any and pops from the refilled list.
+ */
+static void* slab_alloc_revive(Slab *slab) {
+    size_t pages = slab_page_count(slab);
+    for (size_t page = 0; page < pages && slab->free_list == NULL; page++) {
+        if (slab->page_state[page] == SLAB_PAGE_PURGED)
+            revive_page(slab, page);
+    }
+    if (slab->free_list == NULL)
+        return NULL;
+    unsigned char* obj = (unsigned char*)slab->free_list;
+    slab->free_list = *((void**)obj);
+    return obj + HEADER_SIZE;
+}
+
+/**
+ * index_push
+ * Pushes an object onto its page's free list and lists the page if needed.
+ */
+static void index_push(Slab *slab, unsigned char* obj) {
+    size_t page = (size_t)(obj - slab->memory) / SLAB_PAGE_SIZE;
+    *((void**)obj) = slab->page_heads[page];
+    slab->page_heads[page] = obj;
+    if (!slab->page_listed[page]) {
+        slab->page_listed[page] = 1;
+        slab->page_stack[slab->page_stack_top++] = (unsigned int)page;
+    }
+}
+
+/**
+ * index_pop
+ * Pops an object from a page's free list, or returns NULL if the page has none.
+ */
+static unsigned char* index_pop(Slab *slab, size_t page) {
+    unsigned char* obj = (unsigned char*)slab->page_heads[page];
+    if (obj != NULL)
+        slab->page_heads[page] = *((void**)obj);
+    return obj;
+}
+
+/**
+ * index_alloc
+ * Pops from the page on top of page_stack, dropping pages that ran empty.
+ */
+static unsigned char* index_alloc(Slab *slab) {
+    while (slab->page_stack_top > 0) {
+        size_t page = slab->page_stack[slab->page_stack_top - 1];
+        unsigned char* obj = index_pop(slab, page);
+        if (obj != NULL)
+            return obj;
+        slab->page_listed[page] = 0;
+        slab->page_stack_top--;
     }
-    size_t remaining = size % 32;
-    if (remaining) {
-         memset(p + (size - remaining), value, remaining);
+    return NULL;
+}
+
+/**
+ * index_build
+ * Rebuilds every page list in address order, with the first page on top of the stack.
+ */
+static void index_build(Slab *slab) {
+    size_t pages = slab_page_count(slab);
+    memset(slab->page_heads, 0, pages * sizeof(void*));
+    memset(slab->page_listed, 0, pages);
+    slab->page_stack_top = 0;
+    for (size_t i = slab->total_objects; i-- > 0;)
+        index_push(slab, slab->memory + i * slab->object_size);
+}
+
+// Placeholder APIs used by SLAB_FLAG_MESH (Windows 10 1803 and later), resolved at
+// run time so the library still loads on older systems.
+#ifndef MEM_RESERVE_PLACEHOLDER
+#define MEM_RESERVE_PLACEHOLDER  0x00040000
+#endif
+#ifndef MEM_REPLACE_PLACEHOLDER
+#define MEM_REPLACE_PLACEHOLDER  0x00004000
+#endif
+#ifndef MEM_PRESERVE_PLACEHOLDER
+#define MEM_PRESERVE_PLACEHOLDER 0x00000002
+#endif
+typedef PVOID (WINAPI *VirtualAlloc2Fn)(HANDLE, PVOID, SIZE_T, ULONG, ULONG, void*, ULONG);
+typedef PVOID (WINAPI *MapViewOfFile3Fn)(HANDLE, HANDLE, PVOID, ULONG64, SIZE_T, ULONG, ULONG, void*, ULONG);
+typedef BOOL (WINAPI *UnmapViewOfFile2Fn)(HANDLE, PVOID, ULONG);
+static VirtualAlloc2Fn pVirtualAlloc2;
+static MapViewOfFile3Fn pMapViewOfFile3;
+static UnmapViewOfFile2Fn pUnmapViewOfFile2;
+
+/**
+ * mesh_api_load
+ * Resolves the placeholder APIs from kernelbase.dll.
+ *
+ * @return 1 if all of them are available, 0 otherwise.
+ */
+static int mesh_api_load(void) {
+    if (pVirtualAlloc2 && pMapViewOfFile3 && pUnmapViewOfFile2)
+        return 1;
+    HMODULE kernelbase = GetModuleHandleA("kernelbase.dll");
+    if (kernelbase == NULL)
+        return 0;
+    pVirtualAlloc2 = (VirtualAlloc2Fn)GetProcAddress(kernelbase, "VirtualAlloc2");
+    pMapViewOfFile3 = (MapViewOfFile3Fn)GetProcAddress(kernelbase, "MapViewOfFile3");
+    pUnmapViewOfFile2 = (UnmapViewOfFile2Fn)GetProcAddress(kernelbase, "UnmapViewOfFile2");
+    return pVirtualAlloc2 && pMapViewOfFile3 && pUnmapViewOfFile2;
+}
+
+/**
+ * mesh_unmap_spans
+ * Unmaps the first `count` span views (which releases their address range).
+ */
+static void mesh_unmap_spans(Slab *slab, size_t count) {
+    for (size_t span = 0; span < count; span++)
+        UnmapViewOfFile(slab->memory + span * slab->span_size);
+}
+
+/**
+ * mesh_map_spans
+ * Reserves a placeholder for the whole slab, splits it into spans and maps section
+ * span i at virtual span i.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+static int mesh_map_spans(Slab *slab) {
+    slab->memory = NULL;
+    unsigned char* base = (unsigned char*)pVirtualAlloc2(NULL, NULL, slab->mapped_size,
+                                                         MEM_RESERVE | MEM_RESERVE_PLACEHOLDER, PAGE_NOACCESS, NULL, 0);
+    if (base == NULL)
+        return 0;
+    slab->memory = base;
+    for (size_t span = 0; span < slab->span_count; span++) {
+        unsigned char* address = base + span * slab->span_size;
+        if (span + 1 < slab->span_count)
+            VirtualFree(address, slab->span_size, MEM_RELEASE | MEM_PRESERVE_PLACEHOLDER);
+        if (pMapViewOfFile3(slab->mappingHandle, GetCurrentProcess(), address, (ULONG64)span * slab->span_size,
+                            slab->span_size, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE, NULL, 0) == NULL) {
+            mesh_unmap_spans(slab, span);
+            VirtualFree(address, 0, MEM_RELEASE);
+            if (span + 1 < slab->span_count)
+                VirtualFree(address + slab->span_size, 0, MEM_RELEASE);
+            slab->memory = NULL;
+            return 0;
+        }
     }
+    return 1;
+}
+
+/**
+ * map_span_view
+ * Maps section span `phys` into the placeholder at `address`.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+static int map_span_view(Slab *slab, unsigned char* address, size_t phys) {
+    return pMapViewOfFile3(slab->mappingHandle, GetCurrentProcess(), address, (ULONG64)phys * slab->span_size,
+                           slab->span_size, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE, NULL, 0) != NULL;
+}
+
+/**
+ * mesh_remap
+ * Maps section span `phys` at virtual span `span` in place of its current view. If
+ * the new view cannot be mapped, the previous one is put back so the span is never
+ * left as a bare placeholder.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+static int mesh_remap(Slab *slab, size_t span, size_t phys) {
+    unsigned char* address = slab->memory + span * slab->span_size;
+    note_slow_syscall(slab);
+    if (!pUnmapViewOfFile2(GetCurrentProcess(), address, MEM_PRESERVE_PLACEHOLDER))
+        return 0;
+    if (!map_span_view(slab, address, phys)) {
+        map_span_view(slab, address, slab->span_phys[span]);
+        return 0;
+    }
+    slab->span_phys[span] = (unsigned int)phys;
+    return 1;
+}
+
+/**
+ * mesh_unmesh_all
+ * Maps every virtual span back onto its own section span (contents are not restored).
+ */
+static void mesh_unmesh_all(Slab *slab) {
+    for (size_t span = 0; span < slab->span_count; span++) {
+        if (slab->span_phys[span] != span)
+            mesh_remap(slab, span, span);
+    }
+    slab->meshed_spans = 0;
+}
+
+/**
+ * map_aligned_view
+ * Maps the whole section at an address aligned to `alignment`. A free range of
+ * size + alignment is found with a reserve/release pair, and the view is placed at
+ * the aligned address inside it (retried if another thread takes the range).
+ *
+ * @return Base address of the view, or NULL on failure.
+ */
+static unsigned char* map_aligned_view(HANDLE mapping, size_t size, size_t alignment) {
+    for (int attempt = 0; attempt < 16; attempt++) {
+        unsigned char* probe = (unsigned char*)VirtualAlloc(NULL, size + alignment, MEM_RESERVE, PAGE_NOACCESS);
+        if (probe == NULL)
+            return NULL;
+        VirtualFree(probe, 0, MEM_RELEASE);
+        unsigned char* aligned = (unsigned char*)(((uintptr_t)probe + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        unsigned char* view = (unsigned char*)MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, aligned);
+        if (view != NULL)
+            return view;
+    }
+    return NULL;
+}
+
+/**
+ * lock_view
+ * Grows the working set by `size`, touches every page and locks the range. The
+ * old working-set limits are restored if the lock fails.
+ *
+ * @return 1 on success, 0 on failure.
+ */
+static int lock_view(unsigned char* memory, size_t size) {
+    SIZE_T min_ws, max_ws;
+    if (!GetProcessWorkingSetSize(GetCurrentProcess(), &min_ws, &max_ws))
+        return 0;
+    if (!SetProcessWorkingSetSize(GetCurrentProcess(), min_ws + size, max_ws + size))
+        return 0;
+    for (size_t offset = 0; offset < size; offset += 4096)
+        ((volatile unsigned char*)memory)[offset] = 0;
+    if (!VirtualLock(memory, size)) {
+        SetProcessWorkingSetSize(GetCurrentProcess(), min_ws, max_ws);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * unlock_view
+ * Unlocks a range locked by lock_view and gives its size back to the working-set
+ * limits.
+ */
+static void unlock_view(unsigned char* memory, size_t size) {
+    SIZE_T min_ws, max_ws;
+    VirtualUnlock(memory, size);
+    if (GetProcessWorkingSetSize(GetCurrentProcess(), &min_ws, &max_ws) && min_ws > size && max_ws > size)
+        SetProcessWorkingSetSize(GetCurrentProcess(), min_ws - size, max_ws - size);
 }
 
 /**
@@ -57,31 +423,129 @@ static void simd_memset(void* ptr, int value, size_t size) {
  * @return 1 on success, 0 on failure.
  */
 int slab_init(Slab *slab, size_t total_objects, size_t object_size) {
+    return slab_init_ex(slab, total_objects, object_size, 0);
+}
+
+/**
+ * slab_init_ex
+ * Creates the section, maps it (2MB-aligned on request), optionally locks it, and
+ * links all objects into the free list.
+ *
+ * @param slab           Pointer to a Slab structure.
+ * @param total_objects  Total number of objects to allocate.
+ * @param object_size    Size of each object in bytes.
+ * @param flags          Combination of SLAB_FLAG_* values.
+ * @return 1 on success, 0 on failure.
+ */
+int slab_init_ex(Slab *slab, size_t total_objects, size_t object_size, int flags) {
     if (!slab || total_objects == 0 || object_size < sizeof(void*))
         return 0;
+    if (flags & SLAB_FLAG_REALTIME)
+        flags |= SLAB_FLAG_LOCKED;
+    if ((flags & SLAB_FLAG_TYPESAFE) && object_size < HEADER_SIZE)
+        return 0;  // The version word lives in the header.
     slab->object_size = align_size(object_size);
     slab->total_objects = total_objects;
+    slab->flags = flags;
     size_t slab_memory_size = slab->object_size * total_objects;
-    
+    slab->mapped_size = slab_memory_size;
+    slab->locked_size = 0;
+    slab->span_size = 0;
+    slab->span_count = 0;
+    slab->span_phys = NULL;
+    slab->meshed_spans = 0;
+    slab->mesh_passes = 0;
+    slab->sort_period = 0;
+    slab->frees_since_sort = 0;
+    slab->sort_scratch = NULL;
+    slab->sort_passes = 0;
+    if (flags & SLAB_FLAG_MESH) {
+        if ((flags & ~SLAB_FLAG_MESH) || !mesh_api_load())
+            return 0;
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        slab->span_size = info.dwAllocationGranularity;
+        size_t size = 16;
+        while (size < slab->object_size)
+            size <<= 1;
+        if (size > slab->span_size)
+            return 0;
+        slab->object_size = size;
+        slab_memory_size = slab->object_size * total_objects;
+        slab->span_count = (slab_memory_size + slab->span_size - 1) / slab->span_size;
+        slab->mapped_size = slab->span_count * slab->span_size;
+        slab->span_phys = (unsigned int*)malloc(slab->span_count * sizeof(unsigned int));
+        if (slab->span_phys == NULL)
+            return 0;
+        for (size_t span = 0; span < slab->span_count; span++)
+            slab->span_phys[span] = (unsigned int)span;
+    }
+
     // Create a memory mapping (Windows equivalent of mmap).
     slab->mappingHandle = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
-                                             0, (DWORD)slab_memory_size, NULL);
-    if (slab->mappingHandle == NULL)
+                                             (DWORD)((unsigned long long)slab->mapped_size >> 32),
+                                             (DWORD)slab->mapped_size, NULL);
+    if (slab->mappingHandle == NULL) {
+        free(slab->span_phys);
         return 0;
-    slab->memory = (unsigned char*)MapViewOfFile(slab->mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, slab_memory_size);
+    }
+    if (flags & SLAB_FLAG_MESH)
+        mesh_map_spans(slab);
+    else if (flags & SLAB_FLAG_ALIGN_2MB)
+        slab->memory = map_aligned_view(slab->mappingHandle, slab_memory_size, SLAB_ALIGN_2MB);
+    else
+        slab->memory = (unsigned char*)MapViewOfFile(slab->mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, slab_memory_size);
     if (slab->memory == NULL) {
+        CloseHandle(slab->mappingHandle);
+        free(slab->span_phys);
+        return 0;
+    }
+    if ((flags & SLAB_FLAG_LOCKED) && !lock_view(slab->memory, slab_memory_size)) {
+        UnmapViewOfFile(slab->memory);
         CloseHandle(slab->mappingHandle);
         return 0;
     }
+    if (flags & SLAB_FLAG_LOCKED)
+        slab->locked_size = slab_memory_size;
     
-    // Initialize the free list by linking all objects.
-    slab->free_list = slab->memory;
-    for (size_t i = 0; i < total_objects; i++) {
-        unsigned char* current_obj = slab->memory + i * slab->object_size;
-        unsigned char* next_obj = (i < total_objects - 1) ? (slab->memory + (i + 1) * slab->object_size) : NULL;
-        *((void**)current_obj) = next_obj;
+    // Initialize the free list by linking all objects (a new section is already zero-filled).
+    slab->page_heads = NULL;
+    slab->page_stack = NULL;
+    slab->page_listed = NULL;
+    slab->page_stack_top = 0;
+    if (flags & SLAB_FLAG_PAGE_INDEX) {
+        size_t pages = slab_page_count(slab);
+        slab->page_heads = (void**)malloc(pages * sizeof(void*));
+        slab->page_stack = (unsigned int*)malloc(pages * sizeof(unsigned int));
+        slab->page_listed = (unsigned char*)malloc(pages);
+        if (!slab->page_heads || !slab->page_stack || !slab->page_listed) {
+            free(slab->page_heads);
+            free(slab->page_stack);
+            free(slab->page_listed);
+            if (slab->locked_size != 0)
+                unlock_view(slab->memory, slab->locked_size);
+            UnmapViewOfFile(slab->memory);
+            CloseHandle(slab->mappingHandle);
+            return 0;
+        }
+        slab->free_list = NULL;
+        index_build(slab);
+    } else {
+        slab->free_list = slab->memory;
+        link_objects(slab->memory, slab->object_size, total_objects);
     }
     
+    slab->decay_ms = 0;
+    slab->decay_tick = 0;
+    memset(slab->decay_backlog, 0, sizeof(slab->decay_backlog));
+    slab->page_state = NULL;
+    slab->dirty_pages = 0;
+    slab->purged_pages = 0;
+    slab->purged_bytes_total = 0;
+    slab->purge_calls = 0;
+    slab->refaults = 0;
+    slab->slow_syscalls = 0;
+
     // Initialize the critical section for thread safety during reset and destroy.
     InitializeCriticalSection(&slab->lock);
     return 1;
@@ -95,6 +559,10 @@ int slab_init(Slab *slab, size_t total_objects, size_t object_size) {
 void* slab_alloc(Slab *slab) {
     if (!slab)
         return NULL;
+    if (slab->flags & SLAB_FLAG_PAGE_INDEX) {
+        unsigned char* obj = index_alloc(slab);
+        return obj ? obj + HEADER_SIZE : NULL;
+    }
     uintptr_t result = 0;
     __asm__ __volatile__ (
         "movq %[free_list], %%rax\n\t"   // Load free_list address into RAX.
@@ -111,9 +579,68 @@ void* slab_alloc(Slab *slab) {
         :
         : "rax", "rbx", "memory"
     );
+    if (result == 0 && slab->purged_pages != 0)
+        return slab_alloc_revive(slab);
     return (result != 0) ? (void*)(result + HEADER_SIZE) : NULL;
 }
 
+/**
+ * slab_alloc_near
+ * Tries the hint's page, then the next and previous pages, then any page.
+ *
+ * @param slab Pointer to the Slab structure.
+ * @param hint Pointer returned by slab_alloc/slab_alloc_near, or NULL.
+ * @return Pointer to the allocated object (offset by HEADER_SIZE), or NULL.
+ */
+void* slab_alloc_near(Slab *slab, const void* hint) {
+    if (!slab)
+        return NULL;
+    const unsigned char* h = (const unsigned char*)hint;
+    size_t size = slab->object_size * slab->total_objects;
+    if (!(slab->flags & SLAB_FLAG_PAGE_INDEX) || h < slab->memory + HEADER_SIZE || h >= slab->memory + size)
+        return slab_alloc(slab);
+    size_t page = (size_t)(h - HEADER_SIZE - slab->memory) / SLAB_PAGE_SIZE;
+    unsigned char* obj = index_pop(slab, page);
+    if (obj == NULL && page + 1 < slab_page_count(slab))
+        obj = index_pop(slab, page + 1);
+    if (obj == NULL && page > 0)
+        obj = index_pop(slab, page - 1);
+    if (obj == NULL)
+        obj = index_alloc(slab);
+    return obj ? obj + HEADER_SIZE : NULL;
+}
+
+/**
+ * slab_alloc_bulk
+ * Walks `count` links of the free list and detaches the run with one store; the
+ * page-indexed and purged-page paths fall back to slab_alloc per object.
+ *
+ * @param slab    Pointer to the Slab structure.
+ * @param objects Receives the objects (offset by HEADER_SIZE).
+ * @param count   Number of objects wanted.
+ * @return Number of objects stored in `objects`.
+ */
+size_t slab_alloc_bulk(Slab *slab, void** objects, size_t count) {
+    if (!slab || objects == NULL)
+        return 0;
+    size_t taken = 0;
+    if (!(slab->flags & SLAB_FLAG_PAGE_INDEX)) {
+        unsigned char* obj = (unsigned char*)slab->free_list;
+        while (taken < count && obj != NULL) {
+            objects[taken++] = obj + HEADER_SIZE;
+            obj = *((unsigned char**)obj);
+        }
+        slab->free_list = obj;
+    }
+    while (taken < count) {
+        void* obj = slab_alloc(slab);
+        if (obj == NULL)
+            break;
+        objects[taken++] = obj;
+    }
+    return taken;
+}
+
 /**
  * slab_free
  * Pushes a freed object onto the free list using inline assembly.
@@ -126,20 +653,28 @@ void slab_free(Slab *slab, void* ptr) {
     if (!slab || ptr == NULL)
         return;
     uintptr_t obj = (uintptr_t)ptr - HEADER_SIZE;
+    if (slab->flags & SLAB_FLAG_TYPESAFE)
+        retire_version((unsigned char*)obj);
+    if (slab->flags & SLAB_FLAG_PAGE_INDEX) {
+        index_push(slab, (unsigned char*)obj);
+        return;
+    }
     __asm__ __volatile__ (
         "movq %[free_list], %%rax\n\t"   // Load current free_list into RAX.
         "movq %%rax, (%%rcx)\n\t"         // Store current free_list pointer into the freed object's header.
         "movq %%rcx, %[free_list]\n\t"     // Update free_list to point to the freed object.
         : [free_list] "+m" (slab->free_list)
-        : [rcx] "r" (obj)
+        : [rcx] "c" (obj)
         : "rax", "memory"
     );
+    if (slab->sort_period != 0 && ++slab->frees_since_sort >= slab->sort_period)
+        slab_sort_free(slab);
 }
 
 /**
  * slab_reset
- * Rebuilds the free list for all objects in the slab and clears the slab memory using
- * an AVX/SIMD optimized memset.
+ * Rebuilds the free list for all objects in the slab and clears the slab memory in
+ * one streaming pass (zero_and_link_objects).
  *
  * @param slab Pointer to the Slab structure.
  */
@@ -147,13 +682,820 @@ void slab_reset(Slab *slab) {
     if (!slab)
         return;
     EnterCriticalSection(&slab->lock);
+    if (slab->flags & SLAB_FLAG_MESH)
+        mesh_unmesh_all(slab);  // Every object gets its own memory back before clearing.
     slab->free_list = slab->memory;
-    for (size_t i = 0; i < slab->total_objects; i++) {
-        unsigned char* current_obj = slab->memory + i * slab->object_size;
-        unsigned char* next_obj = (i < slab->total_objects - 1) ? (slab->memory + (i + 1) * slab->object_size) : NULL;
-        *((void**)current_obj) = next_obj;
+    if (slab->flags & SLAB_FLAG_TYPESAFE)
+        zero_and_link_typesafe(slab->memory, slab->object_size, slab->total_objects);
+    else
+        zero_and_link_objects(slab->memory, slab->object_size, slab->total_objects);
+    slab->frees_since_sort = 0;  // The rebuilt list is already in address order.
+    if (slab->flags & SLAB_FLAG_PAGE_INDEX) {
+        slab->free_list = NULL;
+        index_build(slab);
+    }
+    if (slab->page_state != NULL)
+        memset(slab->page_state, SLAB_PAGE_USED, slab_page_count(slab));
+    slab->dirty_pages = 0;
+    slab->purged_pages = 0;
+    memset(slab->decay_backlog, 0, sizeof(slab->decay_backlog));
+    LeaveCriticalSection(&slab->lock);
+}
+
+/**
+ * decay_scan
+ * Recomputes page states from the free list: a page becomes dirty when every object
+ * overlapping it is free (on the list, or held out by a purged page), and a dirty or
+ * purged page that an allocated object overlaps again goes back to used.
+ *
+ * @return Number of pages that became dirty, or (size_t)-1 if the scratch bitmap
+ *         could not be allocated.
+ */
+static size_t decay_scan(Slab *slab) {
+    unsigned char* is_free = (unsigned char*)calloc(slab->total_objects, 1);
+    if (is_free == NULL)
+        return (size_t)-1;
+    for (unsigned char* obj = (unsigned char*)slab->free_list; obj; obj = *((unsigned char**)obj))
+        is_free[(obj - slab->memory) / slab->object_size] = 1;
+    size_t pages = slab_page_count(slab);
+    for (size_t page = 0; page < pages; page++) {
+        if (slab->page_state[page] != SLAB_PAGE_PURGED)
+            continue;
+        size_t first = (page * SLAB_PAGE_SIZE + slab->object_size - 1) / slab->object_size;
+        for (size_t i = first; i < slab->total_objects && i * slab->object_size < (page + 1) * SLAB_PAGE_SIZE; i++)
+            is_free[i] = 1;
+    }
+
+    size_t newly_dirty = 0;
+    for (size_t page = 0; page < pages; page++) {
+        size_t first, last;
+        page_objects(slab, page, &first, &last);
+        int all_free = 1;
+        for (size_t i = first; i <= last && all_free; i++)
+            all_free = is_free[i];
+        unsigned char* state = &slab->page_state[page];
+        if (all_free && *state == SLAB_PAGE_USED) {
+            *state = SLAB_PAGE_DIRTY;
+            slab->dirty_pages++;
+            newly_dirty++;
+        } else if (!all_free && *state == SLAB_PAGE_DIRTY) {
+            *state = SLAB_PAGE_USED;
+            slab->dirty_pages--;
+        } else if (!all_free && *state == SLAB_PAGE_PURGED) {
+            // An object starting in an earlier page was allocated and spans into this one.
+            revive_page(slab, page);
+        }
+    }
+    free(is_free);
+    return newly_dirty;
+}
+
+/**
+ * decay_purge
+ * Purges up to max_pages dirty pages with MEM_RESET, one call per contiguous run,
+ * then drops the objects that start in purged pages from the free list.
+ *
+ * @return Bytes purged.
+ */
+static size_t decay_purge(Slab *slab, size_t max_pages) {
+    size_t pages = slab_page_count(slab);
+    size_t purged = 0;
+    size_t page = 0;
+    while (page < pages && purged < max_pages) {
+        if (slab->page_state[page] != SLAB_PAGE_DIRTY) {
+            page++;
+            continue;
+        }
+        size_t run = page;
+        while (run < pages && slab->page_state[run] == SLAB_PAGE_DIRTY && purged + (run - page) < max_pages)
+            run++;
+        VirtualAlloc(slab->memory + page * SLAB_PAGE_SIZE, (run - page) * SLAB_PAGE_SIZE, MEM_RESET, PAGE_READWRITE);
+        note_slow_syscall(slab);
+        memset(&slab->page_state[page], SLAB_PAGE_PURGED, run - page);
+        slab->purge_calls++;
+        purged += run - page;
+        page = run;
+    }
+    if (purged == 0)
+        return 0;
+    slab->dirty_pages -= purged;
+    slab->purged_pages += purged;
+    slab->purged_bytes_total += purged * SLAB_PAGE_SIZE;
+
+    void** link = &slab->free_list;
+    while (*link != NULL) {
+        size_t obj_page = ((unsigned char*)*link - slab->memory) / SLAB_PAGE_SIZE;
+        if (slab->page_state[obj_page] == SLAB_PAGE_PURGED)
+            *link = *((void**)*link);
+        else
+            link = (void**)*link;
+    }
+    return purged * SLAB_PAGE_SIZE;
+}
+
+/**
+ * decay_keep_fraction
+ * Fraction of the pages dirtied `age` steps ago that may stay resident:
+ * 1 - smoothstep((age + 1) / SLAB_DECAY_STEPS).
+ */
+static double decay_keep_fraction(int age) {
+    double x = (double)(age + 1) / SLAB_DECAY_STEPS;
+    return 1.0 - x * x * (3.0 - 2.0 * x);
+}
+
+/**
+ * slab_set_decay
+ * Allocates the page state map and starts the decay clock, or revives every purged
+ * page and frees the map when decay_ms is 0.
+ *
+ * @param slab      Pointer to the Slab structure.
+ * @param decay_ms  Decay time in milliseconds (0 disables purging).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_set_decay(Slab *slab, size_t decay_ms) {
+    if (!slab || slab->memory == NULL || (slab->flags & (SLAB_FLAG_LOCKED | SLAB_FLAG_PAGE_INDEX | SLAB_FLAG_MESH | SLAB_FLAG_TYPESAFE)))
+        return 0;
+    EnterCriticalSection(&slab->lock);
+    if (decay_ms == 0) {
+        if (slab->page_state != NULL) {
+            size_t pages = slab_page_count(slab);
+            for (size_t page = 0; page < pages; page++) {
+                if (slab->page_state[page] == SLAB_PAGE_PURGED)
+                    revive_page(slab, page);
+            }
+            free(slab->page_state);
+            slab->page_state = NULL;
+        }
+        slab->dirty_pages = 0;
+        memset(slab->decay_backlog, 0, sizeof(slab->decay_backlog));
+    } else if (slab->page_state == NULL) {
+        slab->page_state = (unsigned char*)calloc(slab_page_count(slab), 1);
+        if (slab->page_state == NULL) {
+            LeaveCriticalSection(&slab->lock);
+            return 0;
+        }
+    }
+    slab->decay_ms = decay_ms;
+    slab->decay_tick = GetTickCount64();
+    LeaveCriticalSection(&slab->lock);
+    return 1;
+}
+
+/**
+ * slab_decay_tick
+ * Shifts the per-step backlog by the elapsed steps, records newly dirty pages as
+ * the newest step, and purges dirty pages above the smoothstep-weighted backlog.
+ *
+ * @param slab Pointer to the Slab structure.
+ * @return Bytes purged by this call.
+ */
+size_t slab_decay_tick(Slab *slab) {
+    if (!slab || slab->decay_ms == 0)
+        return 0;
+    size_t purged = 0;
+    EnterCriticalSection(&slab->lock);
+    ULONGLONG step_ms = slab->decay_ms / SLAB_DECAY_STEPS;
+    if (step_ms == 0)
+        step_ms = 1;
+    ULONGLONG steps = (GetTickCount64() - slab->decay_tick) / step_ms;
+    if (steps > 0) {
+        slab->decay_tick += steps * step_ms;
+        size_t shift = steps < SLAB_DECAY_STEPS ? (size_t)steps : SLAB_DECAY_STEPS;
+        memmove(&slab->decay_backlog[shift], &slab->decay_backlog[0],
+                (SLAB_DECAY_STEPS - shift) * sizeof(size_t));
+        memset(slab->decay_backlog, 0, shift * sizeof(size_t));
+        size_t newly_dirty = decay_scan(slab);
+        if (newly_dirty != (size_t)-1) {
+            slab->decay_backlog[0] = newly_dirty;
+            double limit = 0.0;
+            for (int age = 0; age < SLAB_DECAY_STEPS; age++)
+                limit += (double)slab->decay_backlog[age] * decay_keep_fraction(age);
+            if ((double)slab->dirty_pages > limit)
+                purged = decay_purge(slab, slab->dirty_pages - (size_t)limit);
+        }
+    }
+    LeaveCriticalSection(&slab->lock);
+    return purged;
+}
+
+/**
+ * slab_purge
+ * Scans and purges every fully free page.
+ *
+ * @param slab Pointer to the Slab structure.
+ * @return Bytes purged.
+ */
+size_t slab_purge(Slab *slab) {
+    if (!slab || slab->decay_ms == 0)
+        return 0;
+    size_t purged = 0;
+    EnterCriticalSection(&slab->lock);
+    if (decay_scan(slab) != (size_t)-1)
+        purged = decay_purge(slab, slab->dirty_pages);
+    LeaveCriticalSection(&slab->lock);
+    return purged;
+}
+
+/**
+ * mesh_discard
+ * Lets the system drop the pages of section span `phys` through a temporary view;
+ * no virtual span maps it any more. If the view cannot be mapped the pages simply
+ * stay resident.
+ */
+static void mesh_discard(Slab *slab, size_t phys) {
+    ULONG64 offset = (ULONG64)phys * slab->span_size;
+    note_slow_syscall(slab);
+    void* view = MapViewOfFile(slab->mappingHandle, FILE_MAP_ALL_ACCESS, (DWORD)(offset >> 32), (DWORD)offset,
+                               slab->span_size);
+    if (view == NULL)
+        return;
+    VirtualAlloc(view, slab->span_size, MEM_RESET, PAGE_READWRITE);
+    UnmapViewOfFile(view);
+}
+
+/**
+ * mesh_merge
+ * Copies the live objects of section span `from` into section span `into` through
+ * their primary virtual spans, maps every virtual span backed by `from` onto `into`,
+ * and only then discards the pages of `from`. If a remap fails, the spans already
+ * moved are mapped back onto `from`, whose contents are still intact.
+ *
+ * @param moved  Scratch for up to span_count span indices.
+ * @return 1 on success, 0 if a remap failed (every span is back on `from`).
+ */
+static int mesh_merge(Slab *slab, size_t into, size_t from, const unsigned long long* from_free, size_t slots,
+                      size_t* moved) {
+    unsigned char* target = slab->memory + into * slab->span_size;
+    unsigned char* source = slab->memory + from * slab->span_size;
+    for (size_t slot = 0; slot < slots; slot++) {
+        if (!(from_free[slot / 64] >> (slot % 64) & 1))
+            memcpy(target + slot * slab->object_size, source + slot * slab->object_size, slab->object_size);
+    }
+    size_t count = 0;
+    for (size_t span = 0; span < slab->span_count; span++) {
+        if (slab->span_phys[span] == from)
+            moved[count++] = span;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!mesh_remap(slab, moved[i], into)) {
+            while (i-- > 0)
+                mesh_remap(slab, moved[i], from);
+            return 0;
+        }
+    }
+    mesh_discard(slab, from);
+    return 1;
+}
+
+/**
+ * slab_mesh
+ * Builds a free-slot bitmap per section span from the free list (the list holds
+ * exactly one address per free physical slot), greedily merges spans whose live
+ * slots are disjoint, and rebuilds the free list so that every free physical slot
+ * is listed once, through the virtual span that owns the section span.
+ *
+ * @param slab        Pointer to the Slab structure.
+ * @param max_probes  Candidate partners tried per span.
+ * @return Bytes released from the mapping by this pass.
+ */
+size_t slab_mesh(Slab *slab, size_t max_probes) {
+    if (!slab || !(slab->flags & SLAB_FLAG_MESH) || slab->memory == NULL)
+        return 0;
+    size_t slots = slab->span_size / slab->object_size;
+    size_t words = (slots + 63) / 64;
+    unsigned long long* free_map = (unsigned long long*)calloc(slab->span_count * words, sizeof(unsigned long long));
+    size_t* candidates = (size_t*)malloc(slab->span_count * sizeof(size_t));
+    size_t* moved = (size_t*)malloc(slab->span_count * sizeof(size_t));
+    if (free_map == NULL || candidates == NULL || moved == NULL) {
+        free(free_map);
+        free(candidates);
+        free(moved);
+        return 0;
+    }
+    EnterCriticalSection(&slab->lock);
+    for (unsigned char* obj = (unsigned char*)slab->free_list; obj; obj = *((unsigned char**)obj)) {
+        size_t offset = (size_t)(obj - slab->memory);
+        size_t phys = slab->span_phys[offset / slab->span_size];
+        size_t slot = offset % slab->span_size / slab->object_size;
+        free_map[phys * words + slot / 64] |= 1ULL << (slot % 64);
+    }
+    // Slots past the last object are never handed out; count them as free.
+    for (size_t index = slab->total_objects; index < slab->span_count * slots; index++)
+        free_map[(index / slots) * words + index % slots / 64] |= 1ULL << (index % slots % 64);
+
+    // Spans at most half full that still own their section span are candidates.
+    size_t count = 0;
+    for (size_t span = 0; span < slab->span_count; span++) {
+        if (slab->span_phys[span] != span)
+            continue;
+        size_t free_slots = 0;
+        for (size_t w = 0; w < words; w++)
+            free_slots += (size_t)__builtin_popcountll(free_map[span * words + w]);
+        if (free_slots * 2 >= slots)
+            candidates[count++] = span;
+    }
+    size_t merged = 0;
+    int failed = 0;
+    for (size_t i = 0; i < count && !failed; i++) {
+        size_t into = candidates[i];
+        if (slab->span_phys[into] != into)
+            continue;  // Merged away earlier in this pass.
+        unsigned long long* into_free = &free_map[into * words];
+        size_t probes = 0;
+        for (size_t j = i + 1; j < count && probes < max_probes; j++) {
+            size_t from = candidates[j];
+            if (slab->span_phys[from] != from)
+                continue;
+            probes++;
+            unsigned long long* from_free = &free_map[from * words];
+            int disjoint = 1;
+            for (size_t w = 0; w < words && disjoint; w++) {
+                unsigned long long valid = (w + 1) * 64 <= slots ? ~0ULL : (1ULL << (slots % 64)) - 1;
+                disjoint = ((~into_free[w] & ~from_free[w]) & valid) == 0;
+            }
+            if (!disjoint)
+                continue;
+            if (!mesh_merge(slab, into, from, from_free, slots, moved)) {
+                // The mapping is as it was, so free_map still holds; the copy did
+                // overwrite free-list links in `into`. Stop and relist.
+                failed = 1;
+                break;
+            }
+            for (size_t w = 0; w < words; w++)
+                into_free[w] &= from_free[w];
+            merged++;
+        }
+    }
+    if (merged > 0 || failed) {
+        // Relist every free physical slot once, in address order.
+        void* head = NULL;
+        for (size_t span = slab->span_count; span-- > 0;) {
+            if (slab->span_phys[span] != span)
+                continue;
+            for (size_t slot = slots; slot-- > 0;) {
+                size_t index = span * slots + slot;
+                if (index < slab->total_objects && (free_map[span * words + slot / 64] >> (slot % 64) & 1)) {
+                    unsigned char* obj = slab->memory + index * slab->object_size;
+                    *((void**)obj) = head;
+                    head = obj;
+                }
+            }
+        }
+        slab->free_list = head;
+        slab->meshed_spans += merged;
+        slab->mesh_passes++;
+    }
+    LeaveCriticalSection(&slab->lock);
+    free(free_map);
+    free(candidates);
+    free(moved);
+    return merged * slab->span_size;
+}
+
+/**
+ * radix_sort_indices
+ * LSD radix sort of object indices, 11 bits per pass; only as many passes as the
+ * largest index needs. `tmp` holds as many entries as `keys`.
+ *
+ * @return The array that holds the sorted keys (keys or tmp).
+ */
+static unsigned int* radix_sort_indices(unsigned int* keys, unsigned int* tmp, size_t count, size_t max_key) {
+    size_t counts[2048];
+    for (unsigned shift = 0; shift < 32 && (max_key >> shift) != 0; shift += 11) {
+        memset(counts, 0, sizeof(counts));
+        for (size_t i = 0; i < count; i++)
+            counts[(keys[i] >> shift) & 2047]++;
+        size_t sum = 0;
+        for (size_t digit = 0; digit < 2048; digit++) {
+            size_t n = counts[digit];
+            counts[digit] = sum;
+            sum += n;
+        }
+        for (size_t i = 0; i < count; i++)
+            tmp[counts[(keys[i] >> shift) & 2047]++] = keys[i];
+        unsigned int* swap = keys;
+        keys = tmp;
+        tmp = swap;
+    }
+    return keys;
+}
+
+/**
+ * slab_sort_free
+ * Collects the free list as object indices, radix-sorts them and relinks the list
+ * in ascending address order. Uses the scratch space of slab_set_sort_period when
+ * present, a temporary buffer otherwise.
+ *
+ * @param slab Pointer to the Slab structure.
+ * @return Number of free objects sorted.
+ */
+size_t slab_sort_free(Slab *slab) {
+    if (!slab || slab->memory == NULL || (slab->flags & SLAB_FLAG_PAGE_INDEX) || slab->total_objects > 0xFFFFFFFFu)
+        return 0;
+    unsigned int* scratch = slab->sort_scratch;
+    if (scratch == NULL) {
+        scratch = (unsigned int*)malloc(slab->total_objects * 2 * sizeof(unsigned int));
+        if (scratch == NULL)
+            return 0;
+    }
+    EnterCriticalSection(&slab->lock);
+    size_t count = 0;
+    for (unsigned char* obj = (unsigned char*)slab->free_list; obj; obj = *((unsigned char**)obj))
+        scratch[count++] = (unsigned int)((size_t)(obj - slab->memory) / slab->object_size);
+    unsigned int* sorted = radix_sort_indices(scratch, scratch + slab->total_objects, count, slab->total_objects - 1);
+    void* head = NULL;
+    for (size_t i = count; i-- > 0;) {
+        unsigned char* obj = slab->memory + (size_t)sorted[i] * slab->object_size;
+        *((void**)obj) = head;
+        head = obj;
+    }
+    slab->free_list = head;
+    slab->frees_since_sort = 0;
+    slab->sort_passes++;
+    LeaveCriticalSection(&slab->lock);
+    if (scratch != slab->sort_scratch)
+        free(scratch);
+    return count;
+}
+
+/**
+ * slab_set_sort_period
+ * Allocates (or releases, for period 0) the radix sort scratch space and sets the
+ * number of frees between automatic sorts.
+ *
+ * @param slab    Pointer to the Slab structure.
+ * @param period  Frees between two sorts (0 disables).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_set_sort_period(Slab *slab, size_t period) {
+    if (!slab || slab->memory == NULL || (slab->flags & SLAB_FLAG_PAGE_INDEX) || slab->total_objects > 0xFFFFFFFFu)
+        return 0;
+    EnterCriticalSection(&slab->lock);
+    if (period != 0 && slab->sort_scratch == NULL) {
+        slab->sort_scratch = (unsigned int*)malloc(slab->total_objects * 2 * sizeof(unsigned int));
+        if (slab->sort_scratch == NULL) {
+            LeaveCriticalSection(&slab->lock);
+            return 0;
+        }
+    }
+    if (period == 0) {
+        free(slab->sort_scratch);
+        slab->sort_scratch = NULL;
+    }
+    slab->sort_period = period;
+    slab->frees_since_sort = 0;
+    LeaveCriticalSection(&slab->lock);
+    return 1;
+}
+
+// Growable segmented slabs. Each segment is its own reservation, aligned to its size,
+// so that slab_growable_free finds the header by masking the object address.
+
+/**
+ * map_segment
+ * Reserves and commits `size` bytes aligned to `size`. A plain VirtualAlloc is tried
+ * first (aligned whenever size is the allocation granularity); otherwise a free
+ * range of twice the size is found with a reserve/release pair and the segment is
+ * placed at the aligned address inside it (retried if another thread takes it).
+ *
+ * @return Base address of the segment, or NULL on failure.
+ */
+static unsigned char* map_segment(size_t size) {
+    unsigned char* base = (unsigned char*)VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (base == NULL || ((uintptr_t)base & (size - 1)) == 0)
+        return base;
+    VirtualFree(base, 0, MEM_RELEASE);
+    for (int attempt = 0; attempt < 16; attempt++) {
+        unsigned char* probe = (unsigned char*)VirtualAlloc(NULL, size * 2, MEM_RESERVE, PAGE_NOACCESS);
+        if (probe == NULL)
+            return NULL;
+        VirtualFree(probe, 0, MEM_RELEASE);
+        unsigned char* aligned = (unsigned char*)(((uintptr_t)probe + size - 1) & ~(uintptr_t)(size - 1));
+        base = (unsigned char*)VirtualAlloc(aligned, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (base != NULL)
+            return base;
+    }
+    return NULL;
+}
+
+/**
+ * segment_class
+ * Partial list of a segment with `inuse` live objects (0 < inuse < segment_objects).
+ */
+static int segment_class(SlabGrowable *slab, size_t inuse) {
+    return (int)(inuse * SLAB_SEGMENT_CLASSES / slab->segment_objects);
+}
+
+/**
+ * segment_list
+ * Head of the list identified by a SlabSegment.list value (not SLAB_SEGMENT_ACTIVE).
+ */
+static SlabSegment** segment_list(SlabGrowable *slab, int list) {
+    if (list == SLAB_SEGMENT_FULL)
+        return &slab->full;
+    if (list == SLAB_SEGMENT_EMPTY)
+        return &slab->empty;
+    return &slab->partial[list];
+}
+
+/**
+ * segment_link
+ * Pushes a segment on the front of a list and updates the list counters.
+ */
+static void segment_link(SlabGrowable *slab, SlabSegment* seg, int list) {
+    SlabSegment** head = segment_list(slab, list);
+    seg->list = list;
+    seg->prev = NULL;
+    seg->next = *head;
+    if (*head != NULL)
+        (*head)->prev = seg;
+    *head = seg;
+    if (list == SLAB_SEGMENT_FULL) {
+        slab->full_segments++;
+    } else if (list == SLAB_SEGMENT_EMPTY) {
+        slab->empty_segments++;
+    } else {
+        slab->partial_segments++;
+        slab->partial_mask |= 1u << list;
+    }
+}
+
+/**
+ * segment_unlink
+ * Removes a segment from the list it is on.
+ */
+static void segment_unlink(SlabGrowable *slab, SlabSegment* seg) {
+    SlabSegment** head = segment_list(slab, seg->list);
+    if (seg->prev != NULL)
+        seg->prev->next = seg->next;
+    else
+        *head = seg->next;
+    if (seg->next != NULL)
+        seg->next->prev = seg->prev;
+    if (seg->list == SLAB_SEGMENT_FULL) {
+        slab->full_segments--;
+    } else if (seg->list == SLAB_SEGMENT_EMPTY) {
+        slab->empty_segments--;
+    } else {
+        slab->partial_segments--;
+        if (*head == NULL)
+            slab->partial_mask &= ~(1u << seg->list);
+    }
+}
+
+/**
+ * segment_release
+ * Unmaps a segment that is on no list.
+ */
+static void segment_release(SlabGrowable *slab, SlabSegment* seg) {
+    VirtualFree(seg, 0, MEM_RELEASE);
+    slab->segments--;
+    slab->segments_released++;
+}
+
+/**
+ * segment_reset
+ * Makes every object of an empty segment unused again, so it refills in address order.
+ */
+static void segment_reset(SlabGrowable *slab, SlabSegment* seg) {
+    seg->free_list = NULL;
+    seg->unused = (unsigned char*)seg + sizeof(SlabSegment);
+    seg->end = seg->unused + slab->segment_objects * slab->object_size;
+    seg->inuse = 0;
+}
+
+/**
+ * segment_refill
+ * Replaces the full (or missing) active segment: the fullest partial segment first,
+ * then a cached empty segment, then a new mapping.
+ *
+ * @return The new active segment, or NULL if none can be provided.
+ */
+static SlabSegment* segment_refill(SlabGrowable *slab) {
+    SlabSegment* seg = NULL;
+    if (slab->partial_mask != 0) {
+        seg = slab->partial[31 - __builtin_clz(slab->partial_mask)];
+        segment_unlink(slab, seg);
+    } else if (slab->empty != NULL) {
+        seg = slab->empty;
+        segment_unlink(slab, seg);
+        segment_reset(slab, seg);
+    } else {
+        if (slab->max_segments != 0 && slab->segments >= slab->max_segments)
+            return NULL;
+        seg = (SlabSegment*)map_segment(slab->segment_size);
+        if (seg == NULL)
+            return NULL;
+        segment_reset(slab, seg);
+        slab->segments++;
+        slab->segments_created++;
+    }
+    if (slab->active != NULL)
+        segment_link(slab, slab->active, SLAB_SEGMENT_FULL);
+    seg->list = SLAB_SEGMENT_ACTIVE;
+    slab->active = seg;
+    return seg;
+}
+
+/**
+ * slab_growable_init
+ * Validates the geometry and computes the objects per segment; no segment is mapped.
+ *
+ * @param slab          Pointer to a SlabGrowable structure.
+ * @param object_size   Size of each object in bytes (at least HEADER_SIZE).
+ * @param segment_size  Bytes per segment (0 for SLAB_SEGMENT_SIZE).
+ * @param max_segments  Maximum number of segments (0 for no limit).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_growable_init(SlabGrowable *slab, size_t object_size, size_t segment_size, size_t max_segments) {
+    if (!slab || object_size < HEADER_SIZE)
+        return 0;
+    if (segment_size == 0)
+        segment_size = SLAB_SEGMENT_SIZE;
+    if (segment_size < SLAB_SEGMENT_SIZE || (segment_size & (segment_size - 1)) != 0)
+        return 0;
+    memset(slab, 0, sizeof(*slab));
+    slab->object_size = align_size(object_size);
+    slab->segment_size = segment_size;
+    slab->segment_objects = (segment_size - sizeof(SlabSegment)) / slab->object_size;
+    if (slab->segment_objects == 0)
+        return 0;
+    slab->max_segments = max_segments;
+    slab->cache_limit = SLAB_SEGMENT_DEFAULT_CACHE;
+    return 1;
+}
+
+/**
+ * slab_growable_set_cache
+ * Stores the limit and releases the cached segments beyond it.
+ *
+ * @param slab   Pointer to the SlabGrowable structure.
+ * @param limit  Empty segments to keep.
+ */
+void slab_growable_set_cache(SlabGrowable *slab, size_t limit) {
+    if (!slab)
+        return;
+    slab->cache_limit = limit;
+    while (slab->empty_segments > limit) {
+        SlabSegment* seg = slab->empty;
+        segment_unlink(slab, seg);
+        segment_release(slab, seg);
+    }
+}
+
+/**
+ * slab_growable_alloc
+ * Pops the active segment's free list, or carves the next unused object; the lists
+ * are only touched when the active segment is full.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ * @return Pointer to the allocated object (offset by HEADER_SIZE), or NULL.
+ */
+void* slab_growable_alloc(SlabGrowable *slab) {
+    if (!slab)
+        return NULL;
+    SlabSegment* seg = slab->active;
+    if (seg == NULL || seg->inuse == slab->segment_objects) {
+        seg = segment_refill(slab);
+        if (seg == NULL)
+            return NULL;
+    }
+    unsigned char* obj = (unsigned char*)seg->free_list;
+    if (obj != NULL) {
+        seg->free_list = *((void**)obj);
+    } else {
+        obj = seg->unused;
+        seg->unused += slab->object_size;
+    }
+    seg->inuse++;
+    slab->live_objects++;
+    return obj + HEADER_SIZE;
+}
+
+/**
+ * slab_growable_free
+ * Pushes the object on its segment's free list. A full segment becomes partial, a
+ * partial segment changes class when its fill level crosses a boundary, and an
+ * emptied segment is cached or released. The active segment stays active.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ * @param ptr  Pointer returned by slab_growable_alloc.
+ */
+void slab_growable_free(SlabGrowable *slab, void* ptr) {
+    if (!slab || ptr == NULL)
+        return;
+    unsigned char* obj = (unsigned char*)ptr - HEADER_SIZE;
+    SlabSegment* seg = (SlabSegment*)((uintptr_t)obj & ~(uintptr_t)(slab->segment_size - 1));
+    *((void**)obj) = seg->free_list;
+    seg->free_list = obj;
+    size_t inuse = --seg->inuse;
+    slab->live_objects--;
+    if (seg->list == SLAB_SEGMENT_ACTIVE)
+        return;
+    if (inuse == 0) {
+        segment_unlink(slab, seg);
+        if (slab->empty_segments < slab->cache_limit)
+            segment_link(slab, seg, SLAB_SEGMENT_EMPTY);
+        else
+            segment_release(slab, seg);
+        return;
+    }
+    int list = segment_class(slab, inuse);
+    if (list != seg->list) {
+        segment_unlink(slab, seg);
+        segment_link(slab, seg, list);
+    }
+}
+
+/**
+ * slab_growable_shrink
+ * Releases the whole empty-segment cache.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ * @return Bytes released.
+ */
+size_t slab_growable_shrink(SlabGrowable *slab) {
+    if (!slab)
+        return 0;
+    size_t released = slab->empty_segments * slab->segment_size;
+    size_t limit = slab->cache_limit;
+    slab_growable_set_cache(slab, 0);
+    slab->cache_limit = limit;
+    return released;
+}
+
+/**
+ * slab_growable_get_stats
+ * Copies the segment counters.
+ *
+ * @param slab   Pointer to the SlabGrowable structure.
+ * @param stats  Receives the statistics.
+ */
+void slab_growable_get_stats(SlabGrowable *slab, SlabGrowableStats *stats) {
+    if (!slab || !stats)
+        return;
+    stats->live_objects = slab->live_objects;
+    stats->segments = slab->segments;
+    stats->partial_segments = slab->partial_segments;
+    stats->full_segments = slab->full_segments;
+    stats->empty_segments = slab->empty_segments;
+    stats->mapped_bytes = slab->segments * slab->segment_size;
+    stats->segments_created = slab->segments_created;
+    stats->segments_released = slab->segments_released;
+}
+
+/**
+ * slab_growable_destroy
+ * Unlinks and releases the active segment and every list.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ */
+void slab_growable_destroy(SlabGrowable *slab) {
+    if (!slab)
+        return;
+    if (slab->active != NULL) {
+        segment_release(slab, slab->active);
+        slab->active = NULL;
+    }
+    for (int list = SLAB_SEGMENT_EMPTY; list < SLAB_SEGMENT_CLASSES; list++) {
+        if (list == SLAB_SEGMENT_ACTIVE)
+            continue;
+        while (*segment_list(slab, list) != NULL) {
+            SlabSegment* seg = *segment_list(slab, list);
+            segment_unlink(slab, seg);
+            segment_release(slab, seg);
+        }
+    }
+    slab->live_objects = 0;
+}
+
+/**
+ * slab_get_stats
+ * Counts the free list and copies the decay counters.
+ *
+ * @param slab   Pointer to the Slab structure.
+ * @param stats  Receives the statistics.
+ */
+void slab_get_stats(Slab *slab, SlabStats *stats) {
+    if (!slab || !stats)
+        return;
+    EnterCriticalSection(&slab->lock);
+    stats->total_objects = slab->total_objects;
+    stats->free_objects = 0;
+    for (void* obj = slab->free_list; obj; obj = *((void**)obj))
+        stats->free_objects++;
+    for (size_t page = 0; slab->page_heads != NULL && page < slab_page_count(slab); page++) {
+        for (void* obj = slab->page_heads[page]; obj; obj = *((void**)obj))
+            stats->free_objects++;
     }
-    simd_memset(slab->memory, 0, slab->object_size * slab->total_objects);
+    stats->dirty_bytes = slab->dirty_pages * SLAB_PAGE_SIZE;
+    stats->purged_bytes = slab->purged_pages * SLAB_PAGE_SIZE;
+    stats->purged_bytes_total = slab->purged_bytes_total;
+    stats->purge_calls = slab->purge_calls;
+    stats->refaults = slab->refaults;
+    stats->slow_syscalls = slab->slow_syscalls;
+    stats->meshed_bytes = slab->meshed_spans * slab->span_size;
+    stats->sort_passes = slab->sort_passes;
     LeaveCriticalSection(&slab->lock);
 }
 
@@ -168,8 +1510,26 @@ void slab_destroy(Slab *slab) {
     if (!slab)
         return;
     EnterCriticalSection(&slab->lock);
-    UnmapViewOfFile(slab->memory);
+    if (slab->locked_size != 0)
+        unlock_view(slab->memory, slab->locked_size);
+    slab->locked_size = 0;
+    if (slab->flags & SLAB_FLAG_MESH)
+        mesh_unmap_spans(slab, slab->span_count);
+    else
+        UnmapViewOfFile(slab->memory);
     CloseHandle(slab->mappingHandle);
+    free(slab->span_phys);
+    slab->span_phys = NULL;
+    free(slab->sort_scratch);
+    slab->sort_scratch = NULL;
+    free(slab->page_state);
+    free(slab->page_heads);
+    free(slab->page_stack);
+    free(slab->page_listed);
+    slab->page_state = NULL;
+    slab->page_heads = NULL;
+    slab->page_stack = NULL;
+    slab->page_listed = NULL;
     slab->memory = NULL;
     slab->free_list = NULL;
     LeaveCriticalSection(&slab->lock);
@@ -10,6 +10,40 @@ extern "C" {
 #include <stddef.h>
 #include <windows.h>
 
+// Dirty page decay. A page is dirty when every object overlapping it is free. Purged
+// pages are reset with MEM_RESET (the view stays committed, the OS may drop the
+// contents); the objects that start in a purged page are held out of the free list
+// until slab_alloc runs dry and revives the page.
+#define SLAB_PAGE_SIZE   4096
+#define SLAB_PAGE_USED   0
+#define SLAB_PAGE_DIRTY  1
+#define SLAB_PAGE_PURGED 2
+#define SLAB_DECAY_STEPS 20
+
+// Slab flags (passed to slab_init_ex).
+#define SLAB_FLAG_ALIGN_2MB 0x1  // Map the slab at a 2MB-aligned address (default: allocation granularity).
+#define SLAB_FLAG_LOCKED    0x2  // Prefault and lock the slab in physical memory (VirtualLock, mlock equivalent).
+#define SLAB_FLAG_REALTIME  0x4  // SLAB_FLAG_LOCKED, and no page decay: no system calls after init.
+#define SLAB_FLAG_PAGE_INDEX 0x8 // Keep one free list per page so slab_alloc_near can allocate next to a hint.
+#define SLAB_FLAG_MESH      0x10 // Map the slab span by span so slab_mesh can merge sparse spans.
+#define SLAB_FLAG_TYPESAFE  0x20 // Type-stable memory: pages are never purged or remapped, and every
+                                 // object keeps a version word that slab_publish and free advance.
+
+// Type-stable objects (SLAB_FLAG_TYPESAFE). The version word lives in the object
+// header and survives reuse: it is odd while the object is published and even while
+// it is free or being initialized. Allocation leaves it even; the owner initializes
+// the fields and then calls slab_publish, which makes it odd, before storing the
+// pointer where readers can find it; slab_free makes it even again. An optimistic
+// reader loads the version, checks that it is odd, reads the fields it needs, then
+// validates that the version is unchanged; if the object was freed or reused in
+// between, validation fails and the reader retries from a fresh pointer. Because
+// memory is never given back or repurposed while the slab exists, a stale pointer
+// always reads an object of the same type, so objects can be freed with slab_free
+// immediately.
+#define SLAB_VERSION_OFFSET 8    // Header offset of the version word.
+
+#define SLAB_ALIGN_2MB (2 * 1024 * 1024)
+
 /**
  * Slab structure
  *
@@ -24,10 +58,119 @@ typedef struct Slab {
     void* free_list;             // Pointer to the first node in the free list.
     HANDLE mappingHandle;        // Handle used for memory mapping (mmap equivalent).
     CRITICAL_SECTION lock;       // Synchronization object for thread safety during reset/destroy.
+    int flags;                   // SLAB_FLAG_* flags given to slab_init_ex.
+    size_t mapped_size;          // Size of the mapped view in bytes.
+    size_t locked_size;          // Bytes locked and added to the working-set quota (SLAB_FLAG_LOCKED).
+
+    // Dirty page decay (disabled while decay_ms == 0).
+    size_t decay_ms;             // Time for a dirty page to be purged completely.
+    ULONGLONG decay_tick;        // GetTickCount64() value of the last completed decay step.
+    size_t decay_backlog[SLAB_DECAY_STEPS];  // Pages that became dirty per step, newest first.
+    unsigned char* page_state;   // One SLAB_PAGE_* entry per page of the mapping.
+    size_t dirty_pages;          // Pages in SLAB_PAGE_DIRTY.
+    size_t purged_pages;         // Pages in SLAB_PAGE_PURGED.
+    size_t purged_bytes_total;   // Bytes handed back to the OS since init.
+    size_t purge_calls;          // Purge system calls issued.
+    size_t refaults;             // Purged pages brought back into use.
+    size_t slow_syscalls;        // System calls made on slow paths after init.
+
+    // Per-page free index (SLAB_FLAG_PAGE_INDEX only; free_list stays NULL).
+    void** page_heads;           // Free list head per page (objects are indexed by their first byte).
+    unsigned int* page_stack;    // Pages that may have free objects; emptied pages are dropped lazily.
+    unsigned char* page_listed;  // Nonzero while the page is on page_stack.
+    size_t page_stack_top;       // Number of entries on page_stack.
+
+    // Meshing (SLAB_FLAG_MESH only). Every span of the slab is a separate view of the
+    // section; span_phys[v] is the section span currently mapped at virtual span v.
+    size_t span_size;            // Bytes per span (the allocation granularity).
+    size_t span_count;           // Spans in the mapping.
+    unsigned int* span_phys;     // Section span behind each virtual span.
+    size_t meshed_spans;         // Section spans no longer mapped anywhere.
+    size_t mesh_passes;          // slab_mesh calls that merged at least one span.
+
+    // Address-ordered free list (disabled while sort_period == 0).
+    size_t sort_period;          // slab_free calls between two automatic sorts.
+    size_t frees_since_sort;     // slab_free calls since the last sort.
+    unsigned int* sort_scratch;  // Two arrays of total_objects indices for the radix sort.
+    size_t sort_passes;          // Free list sorts since init.
 } Slab;
 
 #define HEADER_SIZE 32  // Reserved bytes at the start of each object for storing the next pointer.
 
+// SlabStats structure filled by slab_get_stats.
+typedef struct SlabStats {
+    size_t total_objects;        // Objects in the slab.
+    size_t free_objects;         // Objects on the free list.
+    size_t dirty_bytes;          // Bytes in fully free pages that have not been purged yet.
+    size_t purged_bytes;         // Bytes currently purged.
+    size_t purged_bytes_total;   // Bytes purged since init.
+    size_t purge_calls;          // Purge system calls issued.
+    size_t refaults;             // Purged pages brought back into use.
+    size_t slow_syscalls;        // System calls made on slow paths after init.
+    size_t meshed_bytes;         // Bytes of the section released from the mapping by meshing.
+    size_t sort_passes;          // Free list sorts since init.
+} SlabStats;
+
+// Growable segmented slabs (SLUB-style). A SlabGrowable is a chain of segments, each a
+// separate aligned reservation of segment_size bytes that starts with a SlabSegment
+// header; an object finds its segment by masking its address. Every segment keeps its
+// own free list and in-use count and sits on exactly one list: full, partial (bucketed
+// by fill level) or empty, except the active segment that allocations come from. When
+// the active segment fills up, the fullest partial segment takes over, so allocations
+// pack into few segments and the others drain until they are empty. Empty segments are
+// cached up to a limit and released beyond it.
+#define SLAB_SEGMENT_SIZE         (64 * 1024)  // Default bytes per segment (power of two, >= 64KB).
+#define SLAB_SEGMENT_CLASSES      8            // Partial lists, by in-use fraction.
+#define SLAB_SEGMENT_DEFAULT_CACHE 4           // Empty segments kept committed by default.
+
+#define SLAB_SEGMENT_ACTIVE  -1  // SlabSegment.list: the segment allocations come from.
+#define SLAB_SEGMENT_FULL    -2  // SlabSegment.list: no free object.
+#define SLAB_SEGMENT_EMPTY   -3  // SlabSegment.list: no live object (cached).
+
+// SlabSegment: header at the start of every segment (one cache line).
+typedef struct SlabSegment {
+    struct SlabSegment* next;    // Next segment on the same list.
+    struct SlabSegment* prev;    // Previous segment on the same list.
+    void* free_list;             // Freed objects of this segment.
+    unsigned char* unused;       // First object never handed out (objects past it are not linked yet).
+    unsigned char* end;          // End of the last object.
+    size_t inuse;                // Live objects in this segment.
+    int list;                    // Partial class (0..SLAB_SEGMENT_CLASSES-1) or SLAB_SEGMENT_*.
+} __attribute__((aligned(64))) SlabSegment;
+
+// SlabGrowable structure. Not thread-safe, like Slab.
+typedef struct SlabGrowable {
+    size_t object_size;          // Size of each object (>= HEADER_SIZE and 16-byte aligned).
+    size_t segment_size;         // Bytes per segment (also the segment alignment).
+    size_t segment_objects;      // Objects per segment.
+    size_t max_segments;         // Segment limit (0: unlimited).
+    size_t cache_limit;          // Empty segments kept before they are released.
+    SlabSegment* active;         // Segment allocations come from (on no list).
+    SlabSegment* partial[SLAB_SEGMENT_CLASSES];  // Partial segments, class = inuse * CLASSES / segment_objects.
+    SlabSegment* full;           // Segments without free objects.
+    SlabSegment* empty;          // Cached empty segments.
+    unsigned partial_mask;       // Bit c set while partial[c] is not empty.
+    size_t segments;             // Segments currently mapped (active, partial, full and empty).
+    size_t partial_segments;     // Segments on the partial lists.
+    size_t full_segments;        // Segments on the full list.
+    size_t empty_segments;       // Segments on the empty list.
+    size_t live_objects;         // Objects allocated and not freed.
+    size_t segments_created;     // Segments mapped since init.
+    size_t segments_released;    // Segments unmapped since init.
+} SlabGrowable;
+
+// SlabGrowableStats structure filled by slab_growable_get_stats.
+typedef struct SlabGrowableStats {
+    size_t live_objects;         // Objects allocated and not freed.
+    size_t segments;             // Segments currently mapped.
+    size_t partial_segments;     // Segments with both live and free objects (not counting the active one).
+    size_t full_segments;        // Segments without free objects.
+    size_t empty_segments;       // Cached empty segments.
+    size_t mapped_bytes;         // segments * segment_size.
+    size_t segments_created;     // Segments mapped since init.
+    size_t segments_released;    // Segments unmapped since init.
+} SlabGrowableStats;
+
 /**
  * slab_init
  * Initializes the slab allocator by creating a memory mapping and linking all objects
@@ -40,6 +183,29 @@ typedef struct Slab {
  */
 int slab_init(Slab *slab, size_t total_objects, size_t object_size);
 
+/**
+ * slab_init_ex
+ * Same as slab_init with SLAB_FLAG_* options. SLAB_FLAG_ALIGN_2MB places the mapping
+ * at a 2MB boundary; SLAB_FLAG_LOCKED touches every page and locks the mapping into
+ * the working set (the process working set is grown by the slab size first).
+ * SLAB_FLAG_REALTIME implies SLAB_FLAG_LOCKED; system calls made after init are
+ * counted in slow_syscalls, and building with SLAB_REALTIME_ASSERT defined makes
+ * any such call on a real-time slab abort the process. SLAB_FLAG_MESH maps the
+ * section one span at a time inside a placeholder reservation (Windows 10 1803 or
+ * later) and rounds object_size up to a power of two so every span has the same
+ * slot layout; it cannot be combined with the other flags. SLAB_FLAG_TYPESAFE keeps
+ * every page mapped for the life of the slab (no decay or meshing) and maintains
+ * the per-object version word; objects must be passed to slab_publish once they
+ * are initialized.
+ *
+ * @param slab           Pointer to a Slab structure.
+ * @param total_objects  Total number of objects to allocate.
+ * @param object_size    Size of each object in bytes.
+ * @param flags          Combination of SLAB_FLAG_* values.
+ * @return 1 on success, 0 on failure.
+ */
+int slab_init_ex(Slab *slab, size_t total_objects, size_t object_size, int flags);
+
 /**
  * slab_alloc
  * Allocates an object from the slab.
@@ -49,6 +215,32 @@ int slab_init(Slab *slab, size_t total_objects, size_t object_size);
  */
 void* slab_alloc(Slab *slab);
 
+/**
+ * slab_alloc_near
+ * Allocates an object close to `hint` (an object of the same slab). With
+ * SLAB_FLAG_PAGE_INDEX, an object starting in the hint's page is preferred, then
+ * one in a neighbouring page, then any free object. Without the index (or with a
+ * NULL/foreign hint) this is slab_alloc.
+ *
+ * @param slab Pointer to the Slab structure.
+ * @param hint Pointer returned by slab_alloc/slab_alloc_near, or NULL.
+ * @return Pointer to the allocated object (offset by HEADER_SIZE), or NULL if none is free.
+ */
+void* slab_alloc_near(Slab *slab, const void* hint);
+
+/**
+ * slab_alloc_bulk
+ * Allocates up to `count` objects at once by cutting a run off the free list.
+ * Objects come out in free list order (address order after slab_reset or
+ * slab_sort_free).
+ *
+ * @param slab    Pointer to the Slab structure.
+ * @param objects Receives the objects (offset by HEADER_SIZE).
+ * @param count   Number of objects wanted.
+ * @return Number of objects stored in `objects`.
+ */
+size_t slab_alloc_bulk(Slab *slab, void** objects, size_t count);
+
 /**
  * slab_free
  * Returns a previously allocated object back to the free list.
@@ -60,13 +252,208 @@ void slab_free(Slab *slab, void* ptr);
 
 /**
  * slab_reset
- * Rebuilds the free list for all objects in the slab and clears the slab memory
- * using a SIMD/AVX optimized memset.
+ * Clears the slab memory and rebuilds the free list for all objects in a single
+ * pass of AVX non-temporal stores. On a SLAB_FLAG_TYPESAFE slab the version words
+ * are kept and those of published objects are advanced to free, so optimistic
+ * readers of any object fail validation.
  *
  * @param slab Pointer to the Slab structure.
  */
 void slab_reset(Slab *slab);
 
+/**
+ * slab_set_decay
+ * Enables time-based purging of fully free pages. Dirty pages are purged along a
+ * smoothstep curve so that a page left untouched for decay_ms is gone. Passing 0
+ * disables decay and revives every purged page. Locked, page-indexed, meshable and
+ * type-stable slabs cannot decay.
+ *
+ * @param slab      Pointer to the Slab structure.
+ * @param decay_ms  Decay time in milliseconds (0 disables purging).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_set_decay(Slab *slab, size_t decay_ms);
+
+/**
+ * slab_decay_tick
+ * Advances the decay curve and purges the dirty pages that are past due. The slab
+ * fast paths take no lock, so this must be called from the thread that owns the slab
+ * (e.g. on an idle or slow path).
+ *
+ * @param slab Pointer to the Slab structure.
+ * @return Bytes purged by this call.
+ */
+size_t slab_decay_tick(Slab *slab);
+
+/**
+ * slab_purge
+ * Purges every fully free page immediately. Same threading rule as slab_decay_tick.
+ *
+ * @param slab Pointer to the Slab structure.
+ * @return Bytes purged.
+ */
+size_t slab_purge(Slab *slab);
+
+/**
+ * slab_mesh
+ * Reduces resident memory after churn without moving objects. Finds pairs of spans
+ * whose occupied object slots do not overlap, copies the live objects of the
+ * sparser span into the other span's memory at the same offsets, and maps the
+ * virtual span onto the shared section span, so every pointer stays valid. The
+ * released section span leaves the working set. Only for SLAB_FLAG_MESH slabs;
+ * same threading rule as slab_decay_tick (live objects are briefly unmapped).
+ *
+ * @param slab        Pointer to the Slab structure.
+ * @param max_probes  Candidate partners tried per span (e.g. 64).
+ * @return Bytes released from the mapping by this pass.
+ */
+size_t slab_mesh(Slab *slab, size_t max_probes);
+
+/**
+ * slab_sort_free
+ * Radix-sorts the free list by address, so that the next allocations walk memory
+ * upwards and pages fill up one after another again after LIFO churn. Not for
+ * page-indexed slabs (their per-page lists already keep allocations clustered).
+ *
+ * @param slab Pointer to the Slab structure.
+ * @return Number of free objects sorted.
+ */
+size_t slab_sort_free(Slab *slab);
+
+/**
+ * slab_set_sort_period
+ * Sorts the free list automatically after every `period` calls to slab_free. The
+ * radix sort scratch space is allocated here, so periodic sorts do not allocate.
+ * Passing 0 disables automatic sorting.
+ *
+ * @param slab    Pointer to the Slab structure.
+ * @param period  Frees between two sorts (0 disables).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_set_sort_period(Slab *slab, size_t period);
+
+/**
+ * slab_growable_init
+ * Initializes a growable slab. No memory is mapped until the first allocation.
+ *
+ * @param slab          Pointer to a SlabGrowable structure.
+ * @param object_size   Size of each object in bytes (at least HEADER_SIZE).
+ * @param segment_size  Bytes per segment, a power of two of at least 64KB (0 for SLAB_SEGMENT_SIZE).
+ * @param max_segments  Maximum number of segments (0 for no limit).
+ * @return 1 on success, 0 on failure.
+ */
+int slab_growable_init(SlabGrowable *slab, size_t object_size, size_t segment_size, size_t max_segments);
+
+/**
+ * slab_growable_set_cache
+ * Sets how many empty segments are kept mapped for reuse; the surplus is released
+ * immediately. The default is SLAB_SEGMENT_DEFAULT_CACHE.
+ *
+ * @param slab   Pointer to the SlabGrowable structure.
+ * @param limit  Empty segments to keep (0 releases every segment as soon as it empties).
+ */
+void slab_growable_set_cache(SlabGrowable *slab, size_t limit);
+
+/**
+ * slab_growable_alloc
+ * Allocates an object from the active segment. When it is full, the fullest partial
+ * segment becomes active, then a cached empty segment, then a newly mapped one.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ * @return Pointer to the allocated object (offset by HEADER_SIZE), or NULL if the
+ *         segment limit is reached or mapping fails.
+ */
+void* slab_growable_alloc(SlabGrowable *slab);
+
+/**
+ * slab_growable_free
+ * Returns an object to its segment's free list and moves the segment between the
+ * full, partial and empty lists as its in-use count changes.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ * @param ptr  Pointer returned by slab_growable_alloc.
+ */
+void slab_growable_free(SlabGrowable *slab, void* ptr);
+
+/**
+ * slab_growable_shrink
+ * Releases every cached empty segment (e.g. on an idle path).
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ * @return Bytes released.
+ */
+size_t slab_growable_shrink(SlabGrowable *slab);
+
+/**
+ * slab_growable_get_stats
+ * Reports the segment list lengths and mapping counters.
+ *
+ * @param slab   Pointer to the SlabGrowable structure.
+ * @param stats  Receives the statistics.
+ */
+void slab_growable_get_stats(SlabGrowable *slab, SlabGrowableStats *stats);
+
+/**
+ * slab_growable_destroy
+ * Releases every segment, including those with live objects.
+ *
+ * @param slab Pointer to the SlabGrowable structure.
+ */
+void slab_growable_destroy(SlabGrowable *slab);
+
+/**
+ * slab_publish
+ * Makes a freshly allocated object of a SLAB_FLAG_TYPESAFE slab readable: the
+ * version turns odd after every field store the caller made (x86 keeps stores in
+ * order), so a reader that accepts the version also sees the initialized fields.
+ * Call it after initializing the object and before publishing its pointer.
+ *
+ * @param ptr Pointer returned by slab_alloc.
+ */
+static inline void slab_publish(void* ptr) {
+    volatile size_t* version = (volatile size_t*)((unsigned char*)ptr - HEADER_SIZE + SLAB_VERSION_OFFSET);
+    __asm__ __volatile__("" ::: "memory");  // Field stores stay before the version store.
+    if (!(*version & 1))
+        *version = *version + 1;
+}
+
+/**
+ * slab_read_version
+ * Loads the version word of an object of a SLAB_FLAG_TYPESAFE slab before an
+ * optimistic read. An even value means the object is free or not yet published:
+ * retry from a fresh pointer.
+ *
+ * @param ptr Pointer returned by slab_alloc (possibly freed since).
+ * @return The version.
+ */
+static inline size_t slab_read_version(const void* ptr) {
+    size_t version = *(const volatile size_t*)((const unsigned char*)ptr - HEADER_SIZE + SLAB_VERSION_OFFSET);
+    __asm__ __volatile__("" ::: "memory");  // Field reads stay after the version load (x86 keeps loads in order).
+    return version;
+}
+
+/**
+ * slab_validate_version
+ * Checks after an optimistic read that the object was neither freed nor reused.
+ *
+ * @param ptr     Same pointer as given to slab_read_version.
+ * @param version Value returned by slab_read_version.
+ * @return 1 if the fields read in between belong to one live incarnation, 0 otherwise.
+ */
+static inline int slab_validate_version(const void* ptr, size_t version) {
+    __asm__ __volatile__("" ::: "memory");
+    return *(const volatile size_t*)((const unsigned char*)ptr - HEADER_SIZE + SLAB_VERSION_OFFSET) == version;
+}
+
+/**
+ * slab_get_stats
+ * Reports object, page decay and slow-path system call counters.
+ *
+ * @param slab   Pointer to the Slab structure.
+ * @param stats  Receives the statistics.
+ */
+void slab_get_stats(Slab *slab, SlabStats *stats);
+
 /**
  * slab_destroy
  * Destroys the slab allocator by unmapping the memory, closing the mapping handle,